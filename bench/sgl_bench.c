@@ -0,0 +1,1185 @@
+/* bench/sgl_bench.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "sgl_headless_fb.h"
+#include "sgl_headless_flash.h"
+
+
+#define  BENCH_WARMUP_FRAMES        (3)
+#define  BENCH_TIME_RES_NS          (100)
+#define  BENCH_BUTTON_COLS          (4)
+#define  BENCH_BUTTON_ROWS          (3)
+#define  BENCH_ARC_NUM              (4)
+#define  BENCH_RING_NUM             (6)
+#define  BENCH_DASH_COLS            (6)
+#define  BENCH_DASH_ROWS            (4)
+#define  BENCH_DASH_CHANGES         (4)
+#define  BENCH_IMG_WIDTH            (200)
+#define  BENCH_IMG_HEIGHT           (150)
+#define  BENCH_LOG_LINES            (256)
+#define  BENCH_LABEL_NUM            (12)
+#define  BENCH_TOUCH_COLS           (8)
+#define  BENCH_TOUCH_ROWS           (6)
+#define  BENCH_TOUCH_MOTIONS        (12)
+#define  BENCH_ANIM_COLS            (12)
+#define  BENCH_ANIM_ROWS            (8)
+#define  BENCH_KNOB_SIZE            (48)
+#define  BENCH_QOI_WIDTH            (320)
+#define  BENCH_QOI_HEIGHT           (240)
+#define  BENCH_QOI_SHIFT            (4)
+
+
+/**
+ * @brief canned benchmark scene
+ * @name: scene name, used by command line and report
+ * @setup: create all widgets of scene on the page
+ * @update: change the scene before every frame, it should make something dirty
+ * @teardown: release what is not freed with the page, it can be NULL
+ */
+typedef struct bench_scene {
+    const char    *name;
+    void          (*setup)(sgl_obj_t *page);
+    void          (*update)(sgl_obj_t *page, int frame);
+    void          (*teardown)(void);
+} bench_scene_t;
+
+
+/**
+ * @brief result of one benchmark scene
+ */
+typedef struct bench_result {
+    uint32_t      frames;
+    uint64_t      time_ns;
+    uint64_t      draw_tasks;
+    uint64_t      flush_cnt;
+    uint64_t      flush_pixels;
+    uint64_t      blended_per_frame;
+} bench_result_t;
+
+
+static sgl_obj_t *bench_objs[BENCH_DASH_COLS * BENCH_DASH_ROWS];
+static sgl_unzip_img_pixmap_t bench_img;
+static uint8_t *bench_img_map;
+
+/* draw task statistics that are collected in flush hook */
+static uint32_t bench_frame_tasks;
+static bool bench_count_blend;
+static uint64_t bench_blended;
+
+
+static const char bench_text[] =
+    "SGL is a small graphics library for embedded system, it only needs a few "
+    "kilobytes of ram to draw widgets on the panel. This text is used to measure "
+    "the speed of text rendering, it is long enough to scroll in the textbox. "
+    "The quick brown fox jumps over the lazy dog. 0123456789 !@#$%^&*() "
+    "The quick brown fox jumps over the lazy dog. 0123456789 !@#$%^&*() "
+    "The quick brown fox jumps over the lazy dog. 0123456789 !@#$%^&*() "
+    "The quick brown fox jumps over the lazy dog. 0123456789 !@#$%^&*() ";
+
+
+static char bench_log[BENCH_LOG_LINES * 48];
+
+
+/**
+ * @brief count pixels that are touched by construct functions in one flushed slice,
+ *        it uses the same visit rule as draw_obj_slice() in sgl_core.c
+ */
+static void bench_count_slice(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+    sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    sgl_obj_t *obj;
+    int top = 0;
+    sgl_area_t slice = { .x1 = x, .y1 = y, .x2 = x + w - 1, .y2 = y + h - 1 };
+    sgl_area_t clip;
+
+    stack[top++] = &sgl_ctx.page->obj;
+
+    while (top > 0) {
+        obj = stack[--top];
+
+        if (obj->sibling != NULL) {
+            stack[top++] = obj->sibling;
+        }
+
+        if (sgl_obj_is_hidden(obj)) {
+            continue;
+        }
+
+        if (sgl_area_clip(&slice, &obj->area, &clip)) {
+            bench_blended += (uint64_t)(clip.x2 - clip.x1 + 1) * (clip.y2 - clip.y1 + 1);
+            if (obj->child != NULL) {
+                stack[top++] = obj->child;
+            }
+        }
+    }
+}
+
+
+static void bench_flush_hook(int16_t x, int16_t y, int16_t w, int16_t h)
+{
+#if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
+    bench_frame_tasks = sgl_ctx.dirty_num;
+#else
+    bench_frame_tasks = 1;
+#endif
+
+    if (bench_count_blend) {
+        bench_count_slice(x, y, w, h);
+    }
+}
+
+
+/**
+ * @brief render one frame, the tick is advanced so that sgl_task_handle() never skips
+ * @return draw task count of this frame
+ */
+static uint32_t bench_frame(void)
+{
+    bench_frame_tasks = 0;
+    sgl_tick_inc(SGL_SYSTEM_TICK_MS);
+    sgl_task_handle();
+    return bench_frame_tasks;
+}
+
+
+static void scene_fill_setup(sgl_obj_t *page)
+{
+    SGL_UNUSED(page);
+}
+
+
+static void scene_fill_update(sgl_obj_t *page, int frame)
+{
+    sgl_page_t *p = (sgl_page_t *)page;
+    p->color = (frame & 1) ? SGL_COLOR_BLUE : SGL_COLOR_BLACK;
+    sgl_obj_set_dirty(page);
+}
+
+
+static void scene_button_setup(sgl_obj_t *page)
+{
+    int16_t w = SGL_SCREEN_WIDTH / BENCH_BUTTON_COLS;
+    int16_t h = SGL_SCREEN_HEIGHT / BENCH_BUTTON_ROWS;
+
+    for (int i = 0; i < BENCH_BUTTON_ROWS; i++) {
+        for (int j = 0; j < BENCH_BUTTON_COLS; j++) {
+            sgl_obj_t *btn = sgl_button_create(page);
+            sgl_obj_set_pos(btn, j * w + 4, i * h + 4);
+            sgl_obj_set_size(btn, w - 8, h - 8);
+            sgl_button_set_radius(btn, 12);
+            sgl_button_set_border_width(btn, 2);
+            sgl_button_set_text(btn, "Button");
+            sgl_button_set_font(btn, &song23);
+            bench_objs[i * BENCH_BUTTON_COLS + j] = btn;
+        }
+    }
+}
+
+
+static void scene_button_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+
+    for (int i = 0; i < BENCH_BUTTON_COLS * BENCH_BUTTON_ROWS; i++) {
+        sgl_button_set_color(bench_objs[i], ((frame + i) & 1) ? SGL_COLOR_RED : SGL_COLOR_GREEN);
+    }
+}
+
+
+static void scene_arc_setup(sgl_obj_t *page)
+{
+    int16_t w = SGL_SCREEN_WIDTH / BENCH_ARC_NUM;
+    int16_t size = sgl_min(w, SGL_SCREEN_HEIGHT) - 8;
+
+    for (int i = 0; i < BENCH_ARC_NUM; i++) {
+        sgl_obj_t *arc = sgl_arc_create(page);
+        sgl_obj_set_pos(arc, i * w + 4, (SGL_SCREEN_HEIGHT - size) / 2);
+        sgl_obj_set_size(arc, size, size);
+        sgl_arc_set_radius(arc, size / 2 - 16, size / 2);
+        sgl_arc_set_start_angle(arc, 0);
+        bench_objs[i] = arc;
+    }
+}
+
+
+static void scene_arc_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+
+    for (int i = 0; i < BENCH_ARC_NUM; i++) {
+        sgl_arc_set_end_angle(bench_objs[i], (frame * 7 + i * 90) % 360);
+    }
+}
+
+
+static void scene_ring_setup(sgl_obj_t *page)
+{
+    int16_t w = SGL_SCREEN_WIDTH / (BENCH_RING_NUM / 2);
+    int16_t h = SGL_SCREEN_HEIGHT / 2;
+    int16_t size = sgl_min(w, h) - 8;
+
+    for (int i = 0; i < BENCH_RING_NUM; i++) {
+        sgl_obj_t *ring = sgl_ring_create(page);
+        sgl_obj_set_pos(ring, (i % (BENCH_RING_NUM / 2)) * w + 4, (i / (BENCH_RING_NUM / 2)) * h + 4);
+        sgl_obj_set_size(ring, size, size);
+        sgl_ring_set_radius(ring, size / 2 - 12, size / 2);
+        bench_objs[i] = ring;
+    }
+}
+
+
+static void scene_ring_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+
+    for (int i = 0; i < BENCH_RING_NUM; i++) {
+        sgl_ring_set_color(bench_objs[i], ((frame + i) & 1) ? SGL_COLOR_RED : SGL_COLOR_BLUE);
+    }
+}
+
+
+static void scene_dashboard_setup(sgl_obj_t *page)
+{
+    int16_t w = SGL_SCREEN_WIDTH / BENCH_DASH_COLS;
+    int16_t h = SGL_SCREEN_HEIGHT / BENCH_DASH_ROWS;
+
+    for (int i = 0; i < BENCH_DASH_ROWS; i++) {
+        for (int j = 0; j < BENCH_DASH_COLS; j++) {
+            sgl_obj_t *rect = sgl_rect_create(page);
+            sgl_obj_set_pos(rect, j * w + w / 4, i * h + h / 4);
+            sgl_obj_set_size(rect, w / 2, h / 2);
+            bench_objs[i * BENCH_DASH_COLS + j] = rect;
+        }
+    }
+}
+
+
+static void scene_dashboard_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+
+    /* a few scattered indicators change in every frame */
+    for (int i = 0; i < BENCH_DASH_CHANGES; i++) {
+        int index = (frame * 5 + i * 7) % (BENCH_DASH_COLS * BENCH_DASH_ROWS);
+        sgl_rect_set_color(bench_objs[index], (frame & 1) ? SGL_COLOR_RED : SGL_COLOR_GREEN);
+    }
+}
+
+
+static void scene_labels_setup(sgl_obj_t *page)
+{
+    int16_t h = SGL_SCREEN_HEIGHT / BENCH_LABEL_NUM;
+
+    for (int i = 0; i < BENCH_LABEL_NUM; i++) {
+        sgl_obj_t *label = sgl_label_create(page);
+        sgl_obj_set_pos(label, 0, i * h);
+        sgl_obj_set_size(label, SGL_SCREEN_WIDTH, h);
+        sgl_label_set_font(label, &consolas14);
+        sgl_label_set_text(label, "The quick brown fox jumps over the lazy dog. 0123456789 !@#$%^&*()");
+    }
+
+    /* a small cursor moves over the labels, only a small part of every label is redrawn */
+    bench_objs[0] = sgl_rect_create(page);
+    sgl_obj_set_size(bench_objs[0], 24, 24);
+}
+
+
+static void scene_labels_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+    sgl_obj_set_pos(bench_objs[0], (frame * 37) % (SGL_SCREEN_WIDTH - 24), (frame * 23) % (SGL_SCREEN_HEIGHT - 24));
+}
+
+
+static void scene_textbox_setup(sgl_obj_t *page)
+{
+    sgl_obj_t *textbox = sgl_textbox_create(page);
+    sgl_obj_set_pos(textbox, 8, 8);
+    sgl_obj_set_size(textbox, SGL_SCREEN_WIDTH - 16, SGL_SCREEN_HEIGHT - 16);
+    sgl_textbox_set_font(textbox, &song23);
+    sgl_textbox_set_text(textbox, bench_text);
+    bench_objs[0] = textbox;
+}
+
+
+static void scene_textbox_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+
+    /* scroll up for 64 frames and then scroll back */
+    sgl_event_send_obj(bench_objs[0], (frame & 64) ? SGL_EVENT_MOVE_DOWN : SGL_EVENT_MOVE_UP);
+    sgl_obj_set_dirty(bench_objs[0]);
+}
+
+
+static void scene_textlog_setup(sgl_obj_t *page)
+{
+    sgl_obj_t *textbox = sgl_textbox_create(page);
+    int len = 0;
+
+    /* a long log, only a few lines of it are visible */
+    for (int i = 0; i < BENCH_LOG_LINES; i++) {
+        len += snprintf(&bench_log[len], sizeof(bench_log) - len,
+                        "[%05d] sensor %d value %d status ok\n", i * 37, i % 8, (i * 7919) % 10000);
+    }
+
+    sgl_obj_set_pos(textbox, 0, 0);
+    sgl_obj_set_size(textbox, SGL_SCREEN_WIDTH, SGL_SCREEN_HEIGHT);
+    sgl_textbox_set_font(textbox, &consolas14);
+    sgl_textbox_set_text(textbox, bench_log);
+    bench_objs[0] = textbox;
+}
+
+
+static void scene_textlog_update(sgl_obj_t *page, int frame)
+{
+    sgl_event_t evt = {
+        .obj = bench_objs[0],
+        .type = SGL_EVENT_MOVE_UP,
+        .distance = 16,
+    };
+
+    SGL_UNUSED(page);
+    SGL_UNUSED(frame);
+
+    sgl_event_send(evt);
+}
+
+
+static void scene_keyboard_setup(sgl_obj_t *page)
+{
+    sgl_obj_t *keyboard = sgl_keyboard_create(page);
+    sgl_obj_set_pos(keyboard, 0, SGL_SCREEN_HEIGHT / 3);
+    sgl_obj_set_size(keyboard, SGL_SCREEN_WIDTH, SGL_SCREEN_HEIGHT - SGL_SCREEN_HEIGHT / 3);
+    sgl_keyboard_set_text_font(keyboard, &consolas14);
+    bench_objs[0] = keyboard;
+}
+
+
+static void scene_keyboard_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+    sgl_keyboard_set_btn_color(bench_objs[0], (frame & 1) ? SGL_COLOR_WHITE : SGL_COLOR_GREEN);
+}
+
+
+static void scene_touch_setup(sgl_obj_t *page)
+{
+    int16_t pw = SGL_SCREEN_WIDTH / 2, ph = SGL_SCREEN_HEIGHT / 2;
+    int16_t w = pw / BENCH_TOUCH_COLS, h = ph / BENCH_TOUCH_ROWS;
+
+    /* four panels full of small buttons, like a keypad or a settings page */
+    for (int p = 0; p < 4; p++) {
+        sgl_obj_t *panel = sgl_rect_create(page);
+        sgl_obj_set_pos(panel, (p & 1) * pw, (p >> 1) * ph);
+        sgl_obj_set_size(panel, pw, ph);
+
+        for (int i = 0; i < BENCH_TOUCH_ROWS; i++) {
+            for (int j = 0; j < BENCH_TOUCH_COLS; j++) {
+                sgl_obj_t *btn = sgl_button_create(panel);
+                sgl_obj_set_pos(btn, j * w + 1, i * h + 1);
+                sgl_obj_set_size(btn, w - 2, h - 2);
+                sgl_button_set_radius(btn, 4);
+                sgl_button_set_text(btn, "K");
+                sgl_button_set_font(btn, &consolas14);
+            }
+        }
+    }
+}
+
+
+static void scene_touch_update(sgl_obj_t *page, int frame)
+{
+    int16_t w = SGL_SCREEN_WIDTH / 2 / BENCH_TOUCH_COLS, h = SGL_SCREEN_HEIGHT / 2 / BENCH_TOUCH_ROWS;
+    int btn = frame % (4 * BENCH_TOUCH_COLS * BENCH_TOUCH_ROWS);
+    sgl_event_pos_t pos;
+
+    SGL_UNUSED(page);
+
+    /* motion samples of a finger that does not move anything, only hit-testing costs */
+    for (int i = 0; i < BENCH_TOUCH_MOTIONS; i++) {
+        pos.x = (frame * 37 + i * 53) % SGL_SCREEN_WIDTH;
+        pos.y = (frame * 29 + i * 41) % SGL_SCREEN_HEIGHT;
+        sgl_event_send_pos(pos, SGL_EVENT_MOTION);
+    }
+
+    /* tap one button, it is redrawn as pressed and released */
+    pos.x = (btn % (2 * BENCH_TOUCH_COLS)) * w + w / 2;
+    pos.y = (btn / (2 * BENCH_TOUCH_COLS)) * h + h / 2;
+    sgl_event_send_pos(pos, SGL_EVENT_PRESSED);
+    sgl_event_send_pos(pos, SGL_EVENT_RELEASED);
+}
+
+
+static void scene_idle_update(sgl_obj_t *page, int frame)
+{
+    /* nothing is changed, only the cost of a frame without dirty area is measured */
+    SGL_UNUSED(page);
+    SGL_UNUSED(frame);
+}
+
+
+#if (CONFIG_SGL_ANIMATION)
+static sgl_anim_t *bench_anims[BENCH_ANIM_COLS * BENCH_ANIM_ROWS];
+
+
+static void scene_anim_path(sgl_anim_t *anim, int32_t value)
+{
+    sgl_rect_set_alpha((sgl_obj_t*)anim->data, (uint8_t)value);
+}
+
+
+static void scene_anim_setup(sgl_obj_t *page)
+{
+    int16_t w = SGL_SCREEN_WIDTH / BENCH_ANIM_COLS, h = SGL_SCREEN_HEIGHT / BENCH_ANIM_ROWS;
+
+    /* status lights that pulse one after another, most of them wait in their delay */
+    for (int i = 0; i < BENCH_ANIM_COLS * BENCH_ANIM_ROWS; i++) {
+        sgl_obj_t *led = sgl_rect_create(page);
+        sgl_obj_set_pos(led, (i % BENCH_ANIM_COLS) * w + 4, (i / BENCH_ANIM_COLS) * h + 4);
+        sgl_obj_set_size(led, w - 8, h - 8);
+        sgl_rect_set_radius(led, 6);
+        sgl_rect_set_color(led, SGL_COLOR_GREEN);
+
+        sgl_anim_t *anim = sgl_anim_create();
+        sgl_anim_set_data(anim, led);
+        sgl_anim_set_act_delay(anim, 100 + (i * 37) % 500);
+        sgl_anim_set_act_duration(anim, 60);
+        sgl_anim_set_start_value(anim, 255);
+        sgl_anim_set_end_value(anim, 64);
+        sgl_anim_set_path(anim, scene_anim_path, SGL_ANIM_PATH_LINEAR);
+        sgl_anim_set_repeat_cnt(anim, SGL_ANIM_REPEAT_LOOP);
+        sgl_anim_start(anim);
+        bench_anims[i] = anim;
+    }
+}
+
+
+static void scene_anim_update(sgl_obj_t *page, int frame)
+{
+    /* animations change the scene by themselves */
+    SGL_UNUSED(page);
+    SGL_UNUSED(frame);
+}
+
+
+static void scene_anim_teardown(void)
+{
+    for (int i = 0; i < BENCH_ANIM_COLS * BENCH_ANIM_ROWS; i++) {
+        sgl_anim_free(bench_anims[i]);
+    }
+}
+#endif
+
+
+#if (CONFIG_SGL_EXTERNAL_PIXMAP)
+static sgl_pixmap_t bench_pixmap;
+
+
+static void scene_pixmap_setup(sgl_obj_t *page)
+{
+    size_t count = (size_t)SGL_SCREEN_WIDTH * SGL_SCREEN_HEIGHT;
+    sgl_color_t *pixels = malloc(count * sizeof(sgl_color_t));
+
+    if (pixels == NULL) {
+        return;
+    }
+
+    /* a background picture in SPI flash, only the read function knows where it is */
+    for (int y = 0; y < SGL_SCREEN_HEIGHT; y++) {
+        for (int x = 0; x < SGL_SCREEN_WIDTH; x++) {
+            pixels[y * SGL_SCREEN_WIDTH + x] = sgl_rgb(x * 255 / SGL_SCREEN_WIDTH, y * 255 / SGL_SCREEN_HEIGHT, (x ^ y) & 0xff);
+        }
+    }
+
+    if (sgl_headless_flash_init(pixels, count * sizeof(sgl_color_t)) == 0) {
+        bench_pixmap.bitmap = NULL;
+        bench_pixmap.width = SGL_SCREEN_WIDTH;
+        bench_pixmap.height = SGL_SCREEN_HEIGHT;
+        bench_pixmap.read = sgl_headless_flash_read;
+        sgl_page_set_pixmap(page, &bench_pixmap);
+    }
+    free(pixels);
+
+    /* a knob moves in a small part of the picture, the picture is redrawn under its old and new place */
+    bench_objs[0] = sgl_rect_create(page);
+    sgl_obj_set_size(bench_objs[0], BENCH_KNOB_SIZE, BENCH_KNOB_SIZE);
+    sgl_rect_set_radius(bench_objs[0], 8);
+}
+
+
+static void scene_pixmap_update(sgl_obj_t *page, int frame)
+{
+    sgl_obj_set_pos(bench_objs[0], SGL_SCREEN_WIDTH / 4 + (frame * 13) % (SGL_SCREEN_WIDTH / 4),
+                    SGL_SCREEN_HEIGHT / 4 + (frame * 7) % (SGL_SCREEN_HEIGHT / 4));
+
+    /* and the whole picture is redrawn sometimes, such as when a page slides in */
+    if (frame % 16 == 0) {
+        sgl_obj_set_dirty(page);
+    }
+}
+
+
+static void scene_pixmap_teardown(void)
+{
+#if (CONFIG_SGL_PIXMAP_CACHE)
+    sgl_pixmap_cache_clear(&bench_pixmap);
+#endif
+}
+#endif
+
+
+/**
+ * @brief encode a RGB565 image for unzip_image widget, it uses the literal, delta and repeat
+ *        codes that the decoder of sgl_unzip_image.c understands
+ * @return encoded length, or 0 if failed
+ */
+static uint32_t bench_img_encode(const uint16_t *pixels, uint32_t count, uint8_t *out)
+{
+    const uint16_t delta_mask = 0x18e3;
+    uint16_t unzip = 0;
+    uint32_t n = 0;
+    uint32_t i = 0;
+
+    while (i < count) {
+        uint16_t p = pixels[i];
+        uint32_t run = 1;
+
+        while (i + run < count && pixels[i + run] == p && run < 0xffff) {
+            run ++;
+        }
+
+        /* the first pixel must be a literal, because the repeat code is a copy of last literal */
+        if (i > 0 && ((p ^ unzip) & ~delta_mask) == 0) {
+            uint16_t d = p ^ unzip;
+            out[n++] = (d & 0x03) | (((d >> 5) & 0x07) << 2) | (((d >> 11) & 0x03) << 6);
+        }
+        else {
+            /* bit 5 marks literal code, so the lowest green bit is forced to 1 */
+            uint16_t lit = p | 0x20;
+            if (lit == unzip) {
+                out[n++] = 0;
+            }
+            else {
+                unzip = lit;
+                out[n++] = unzip & 0xff;
+                out[n++] = unzip >> 8;
+            }
+        }
+
+        if (run > 4) {
+            out[n++] = unzip & 0xff;
+            out[n++] = unzip >> 8;
+            out[n++] = (run - 1) >> 8;
+            out[n++] = (run - 1) & 0xff;
+        }
+        else {
+            for (uint32_t k = 1; k < run; k++) {
+                out[n++] = 0;
+            }
+        }
+
+        i += run;
+    }
+
+    return n;
+}
+
+
+static void bench_img_create(void)
+{
+    uint32_t count = BENCH_IMG_WIDTH * BENCH_IMG_HEIGHT;
+    uint16_t *pixels = malloc(count * sizeof(uint16_t));
+
+    /* encoded data is never larger than 4 bytes per pixel */
+    bench_img_map = malloc(count * 4);
+    if (pixels == NULL || bench_img_map == NULL) {
+        fprintf(stderr, "bench: image alloc failed\n");
+        exit(1);
+    }
+
+    /* a color band background with a flat disc in the middle */
+    for (int y = 0; y < BENCH_IMG_HEIGHT; y++) {
+        for (int x = 0; x < BENCH_IMG_WIDTH; x++) {
+            int dx = x - BENCH_IMG_WIDTH / 2, dy = y - BENCH_IMG_HEIGHT / 2;
+            uint16_t c;
+            if (dx * dx + dy * dy < (BENCH_IMG_HEIGHT / 3) * (BENCH_IMG_HEIGHT / 3)) {
+                c = 0xffe0;
+            }
+            else {
+                c = (((y / 8) & 0x1f) << 11) | (((x / 4) & 0x3f) << 5) | ((x / 16) & 0x1f);
+            }
+            pixels[y * BENCH_IMG_WIDTH + x] = c;
+        }
+    }
+
+    bench_img_encode(pixels, count, bench_img_map);
+    bench_img.width = BENCH_IMG_WIDTH;
+    bench_img.height = BENCH_IMG_HEIGHT;
+    bench_img.map = bench_img_map;
+    free(pixels);
+}
+
+
+static void scene_unzip_image_setup(sgl_obj_t *page)
+{
+    sgl_obj_t *img = sgl_unzip_img_create(page);
+    sgl_obj_set_pos(img, (SGL_SCREEN_WIDTH - BENCH_IMG_WIDTH) / 2, (SGL_SCREEN_HEIGHT - BENCH_IMG_HEIGHT) / 2);
+    sgl_obj_set_size(img, BENCH_IMG_WIDTH, BENCH_IMG_HEIGHT);
+    sgl_unzip_img_set_img(img, &bench_img);
+    bench_objs[0] = img;
+}
+
+
+static void scene_unzip_image_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+    SGL_UNUSED(frame);
+    sgl_obj_set_dirty(bench_objs[0]);
+}
+
+
+#if (CONFIG_SGL_PIXMAP_QOI)
+static sgl_pixmap_t bench_qoi;
+static uint8_t *bench_qoi_data;
+
+
+/**
+ * @brief encode RGBA pixels into SGL_PIXMAP_FORMAT_QOI, the same as tools/sgl_qoi_encode.py
+ * @return encoded length
+ */
+static uint32_t bench_qoi_encode(const uint8_t *rgba, int width, int height, int shift, uint8_t *out)
+{
+    int chunks = (height + (1 << shift) - 1) >> shift;
+    uint32_t n = SGL_QOI_HEADER_SIZE + chunks * 4;
+    uint32_t head[3] = { SGL_QOI_MAGIC, (uint32_t)width | ((uint32_t)height << 16), (uint32_t)shift };
+
+    memcpy(out, head, sizeof(head));
+
+    for (int c = 0; c < chunks; c++) {
+        uint8_t index[64][4] = { { 0 } };
+        uint8_t prev[4] = { 0, 0, 0, 255 };
+        int end = sgl_min((c + 1) << shift, height) * width;
+        int run = 0;
+
+        memcpy(out + SGL_QOI_HEADER_SIZE + c * 4, &n, 4);
+
+        for (int i = (c << shift) * width; i < end; i++) {
+            const uint8_t *px = rgba + i * 4;
+            int h = (px[0] * 3 + px[1] * 5 + px[2] * 7 + px[3] * 11) & 63;
+
+            if (memcmp(px, prev, 4) == 0) {
+                if (++run == 62) {
+                    out[n++] = 0xc0 | (run - 1);
+                    run = 0;
+                }
+                continue;
+            }
+            if (run) {
+                out[n++] = 0xc0 | (run - 1);
+                run = 0;
+            }
+
+            if (memcmp(index[h], px, 4) == 0) {
+                out[n++] = h;
+            }
+            else if (px[3] != prev[3]) {
+                out[n++] = 0xff;
+                memcpy(out + n, px, 4);
+                n += 4;
+            }
+            else {
+                int8_t vr = px[0] - prev[0], vg = px[1] - prev[1], vb = px[2] - prev[2];
+                int8_t vg_r = vr - vg, vg_b = vb - vg;
+
+                if (vr >= -2 && vr <= 1 && vg >= -2 && vg <= 1 && vb >= -2 && vb <= 1) {
+                    out[n++] = 0x40 | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2);
+                }
+                else if (vg >= -32 && vg <= 31 && vg_r >= -8 && vg_r <= 7 && vg_b >= -8 && vg_b <= 7) {
+                    out[n++] = 0x80 | (vg + 32);
+                    out[n++] = ((vg_r + 8) << 4) | (vg_b + 8);
+                }
+                else {
+                    out[n++] = 0xfe;
+                    memcpy(out + n, px, 3);
+                    n += 3;
+                }
+            }
+            memcpy(index[h], px, 4);
+            memcpy(prev, px, 4);
+        }
+
+        if (run) {
+            out[n++] = 0xc0 | (run - 1);
+        }
+    }
+
+    return n;
+}
+
+
+static void scene_qoi_setup(sgl_obj_t *page)
+{
+    uint8_t *rgba = malloc(BENCH_QOI_WIDTH * BENCH_QOI_HEIGHT * 4);
+
+    /* the worst case of QOI is 5 bytes per pixel */
+    bench_qoi_data = malloc(BENCH_QOI_WIDTH * BENCH_QOI_HEIGHT * 5 + SGL_QOI_HEADER_SIZE + BENCH_QOI_HEIGHT * 4);
+    if (rgba == NULL || bench_qoi_data == NULL) {
+        free(rgba);
+        return;
+    }
+
+    /* flat color bands under a glass disc that fades out to its edge */
+    for (int y = 0; y < BENCH_QOI_HEIGHT; y++) {
+        for (int x = 0; x < BENCH_QOI_WIDTH; x++) {
+            int dx = x - BENCH_QOI_WIDTH / 2, dy = y - BENCH_QOI_HEIGHT / 2;
+            int d2 = dx * dx + dy * dy, r = BENCH_QOI_HEIGHT / 3;
+            uint8_t *px = rgba + (y * BENCH_QOI_WIDTH + x) * 4;
+
+            px[0] = (x / 40) * 32;
+            px[1] = (y / 30) * 32;
+            px[2] = 160;
+            px[3] = 255;
+            if (d2 < r * r) {
+                px[0] = 255;
+                px[1] = 255 - y / 2;
+                px[2] = 64;
+                px[3] = 255 - d2 * 191 / (r * r);
+            }
+            else if (x < 16 || y < 16 || x >= BENCH_QOI_WIDTH - 16 || y >= BENCH_QOI_HEIGHT - 16) {
+                px[3] = 0;
+            }
+        }
+    }
+
+    bench_qoi_encode(rgba, BENCH_QOI_WIDTH, BENCH_QOI_HEIGHT, BENCH_QOI_SHIFT, bench_qoi_data);
+    free(rgba);
+
+    bench_qoi.bitmap = bench_qoi_data;
+    bench_qoi.width = BENCH_QOI_WIDTH;
+    bench_qoi.height = BENCH_QOI_HEIGHT;
+    bench_qoi.format = SGL_PIXMAP_FORMAT_QOI;
+
+    bench_objs[0] = sgl_rect_create(page);
+    sgl_obj_set_pos(bench_objs[0], (SGL_SCREEN_WIDTH - BENCH_QOI_WIDTH) / 2, (SGL_SCREEN_HEIGHT - BENCH_QOI_HEIGHT) / 2);
+    sgl_obj_set_size(bench_objs[0], BENCH_QOI_WIDTH, BENCH_QOI_HEIGHT);
+    sgl_rect_set_pixmap(bench_objs[0], &bench_qoi);
+}
+
+
+static void scene_qoi_update(sgl_obj_t *page, int frame)
+{
+    SGL_UNUSED(page);
+    SGL_UNUSED(frame);
+    sgl_obj_set_dirty(bench_objs[0]);
+}
+
+
+static void scene_qoi_teardown(void)
+{
+    free(bench_qoi_data);
+    bench_qoi_data = NULL;
+}
+#endif
+
+
+static const bench_scene_t bench_scenes[] = {
+    { "fill",        scene_fill_setup,        scene_fill_update,        NULL },
+    { "button",      scene_button_setup,      scene_button_update,      NULL },
+    { "arc",         scene_arc_setup,         scene_arc_update,         NULL },
+    { "ring",        scene_ring_setup,        scene_ring_update,        NULL },
+    { "dashboard",   scene_dashboard_setup,   scene_dashboard_update,   NULL },
+    { "labels",      scene_labels_setup,      scene_labels_update,      NULL },
+    { "textbox",     scene_textbox_setup,     scene_textbox_update,     NULL },
+    { "textlog",     scene_textlog_setup,     scene_textlog_update,     NULL },
+    { "keyboard",    scene_keyboard_setup,    scene_keyboard_update,    NULL },
+    { "unzip_image", scene_unzip_image_setup, scene_unzip_image_update, NULL },
+    { "touch",       scene_touch_setup,       scene_touch_update,       NULL },
+    { "idle",        scene_touch_setup,       scene_idle_update,        NULL },
+#if (CONFIG_SGL_ANIMATION)
+    { "anim",        scene_anim_setup,        scene_anim_update,        scene_anim_teardown },
+#endif
+#if (CONFIG_SGL_EXTERNAL_PIXMAP)
+    { "pixmap",      scene_pixmap_setup,      scene_pixmap_update,      scene_pixmap_teardown },
+#endif
+#if (CONFIG_SGL_PIXMAP_QOI)
+    { "qoi",         scene_qoi_setup,         scene_qoi_update,         scene_qoi_teardown },
+#endif
+};
+
+
+static uint64_t bench_time_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec;
+}
+
+
+static uint32_t bench_clock_ns(void)
+{
+    return (uint32_t)bench_time_ns();
+}
+
+
+/**
+ * @brief smallest time span that the benchmark clock can tell apart from zero
+ * @param none
+ * @return resolution in nanoseconds, at least 1
+ */
+static uint64_t bench_time_res_ns(void)
+{
+    struct timespec ts;
+
+    if (clock_getres(CLOCK_MONOTONIC, &ts) != 0) {
+        return 1000u;
+    }
+    return sgl_max((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec, 1u);
+}
+
+
+/**
+ * @brief format one timing column of the report
+ * @param buf: output buffer
+ * @param size: size of output buffer
+ * @param fmt: printf format of value
+ * @param value: value of column
+ * @param valid: false if the measured time is below the clock resolution
+ * @return buf, it holds "-" when value is not valid
+ */
+static const char *bench_fmt_time(char *buf, size_t size, const char *fmt, double value, bool valid)
+{
+    if (valid) {
+        snprintf(buf, size, fmt, value);
+    }
+    else {
+        snprintf(buf, size, "-");
+    }
+    return buf;
+}
+
+
+static void bench_print_heap(void)
+{
+    sgl_mm_monitor_t heap = sgl_mm_get_monitor();
+
+    printf("heap: %zu used, %zu peak, %zu largest free block, %zu free blocks, %zu allocs, %zu failed\n",
+           heap.used_size, heap.peak_size, heap.max_free_block, heap.free_block_num,
+           heap.alloc_num, heap.fail_num);
+    printf("alloc latency:");
+    for (int i = 0; i < SGL_MM_LATENCY_NUM; i++) {
+        if (heap.latency[i]) {
+            printf(" <%uns %u", 1u << i, heap.latency[i]);
+        }
+    }
+    printf("\n");
+
+#if (CONFIG_SGL_MM_TAG)
+    static const char *tag_name[SGL_MM_TAG_NUM] = {
+        "other", "obj", "anim", "font", "image", "draw", "event",
+    };
+    sgl_mm_tag_monitor_t tag;
+
+    printf("%-12s %10s %10s %10s\n", "heap tag", "used", "peak", "blocks");
+    for (int i = 0; i < SGL_MM_TAG_NUM; i++) {
+        sgl_mm_get_tag_monitor((sgl_mm_tag_t)i, &tag);
+        printf("%-12s %10zu %10zu %10zu\n", tag_name[i], tag.used_size, tag.peak_size, tag.block_num);
+    }
+#endif
+}
+
+
+static void bench_print_flash(void)
+{
+#if (CONFIG_SGL_EXTERNAL_PIXMAP)
+    sgl_headless_flash_t *flash = sgl_headless_flash_get();
+
+    printf("flash: %llu reads, %llu bytes\n",
+           (unsigned long long)flash->read_cnt, (unsigned long long)flash->read_bytes);
+#endif
+#if (CONFIG_SGL_EXTERNAL_PIXMAP && CONFIG_SGL_PIXMAP_CACHE)
+    sgl_pixmap_cache_stat_t stat;
+
+    sgl_pixmap_cache_get_stat(&stat);
+    printf("pixmap cache: %u hit, %u miss, %u prefetch, %u reads, %u bytes\n",
+           stat.hit, stat.miss, stat.prefetch, stat.read_num, stat.read_bytes);
+#endif
+}
+
+
+static void bench_print_event(void)
+{
+    sgl_event_stat_t stat;
+
+    sgl_event_get_stat(&stat);
+    printf("event queue: %u pushed, %u coalesced, %u dropped\n",
+           stat.pushed, stat.coalesced, stat.dropped);
+}
+
+
+#if (CONFIG_SGL_PROFILER)
+static uint32_t bench_clock_us(void)
+{
+    return (uint32_t)sgl_headless_time_us();
+}
+
+
+static void bench_log_puts(const char *str)
+{
+    fputs(str, stdout);
+}
+#endif
+
+
+static void bench_run_scene(const bench_scene_t *scene, int frames, const char *ppm_dir, bench_result_t *res)
+{
+    sgl_obj_t *old = &sgl_ctx.page->obj;
+    sgl_obj_t *page = sgl_obj_create(NULL);
+    uint64_t start;
+
+    memset(res, 0, sizeof(bench_result_t));
+
+    sgl_screen_load(page);
+    sgl_obj_free(old);
+    scene->setup(page);
+
+    /* first frames draw the whole page, they are not measured */
+    for (int i = 0; i < BENCH_WARMUP_FRAMES; i++) {
+        bench_frame();
+    }
+
+    sgl_headless_fb_reset_stats();
+    start = bench_time_ns();
+    for (int i = 0; i < frames; i++) {
+        scene->update(page, i);
+        res->draw_tasks += bench_frame();
+    }
+    /* the panel is updated when the last transfer is finished */
+    sgl_flush_wait();
+    res->time_ns = bench_time_ns() - start;
+    res->frames = frames;
+    res->flush_cnt = sgl_headless_fb_get()->flush_cnt;
+    res->flush_pixels = sgl_headless_fb_get()->flush_pixels;
+
+    /* one more frame to count the pixels that construct functions touch per frame */
+    bench_blended = 0;
+    bench_count_blend = true;
+    scene->update(page, frames);
+    bench_frame();
+    bench_count_blend = false;
+    res->blended_per_frame = bench_blended;
+
+    if (ppm_dir) {
+        char path[512];
+        snprintf(path, sizeof(path), "%s/%s.ppm", ppm_dir, scene->name);
+        if (sgl_headless_fb_save_ppm(path)) {
+            fprintf(stderr, "bench: failed to save %s\n", path);
+        }
+    }
+
+    if (scene->teardown) {
+        scene->teardown();
+    }
+}
+
+
+static void bench_usage(const char *prog)
+{
+    printf("usage: %s [options]\n", prog);
+    printf("  -n <frames>   measured frames per scene, default 200\n");
+    printf("  -s <scene>    run only one scene, can be repeated\n");
+    printf("  -W <width>    panel width, default 480\n");
+    printf("  -H <height>   panel height, default 320\n");
+    printf("  -l <lines>    lines of draw buffer, default 20\n");
+    printf("  -d            use double draw buffer\n");
+    printf("  -f <ns>       transfer time of one flushed pixel, default 0\n");
+    printf("  -r <ns>       command time of one flash read of external pixmap, default 0\n");
+    printf("  -b <ns>       transfer time of one byte read from flash, default 0\n");
+    printf("  -o <dir>      save the last frame of every scene as <dir>/<scene>.ppm\n");
+#if (CONFIG_SGL_PROFILER)
+    printf("  -p            dump profiler statistics of the last frame of every scene\n");
+#endif
+    printf("scenes:");
+    for (size_t i = 0; i < SGL_ARRAY_SIZE(bench_scenes); i++) {
+        printf(" %s", bench_scenes[i].name);
+    }
+    printf("\n");
+}
+
+
+int main(int argc, char *argv[])
+{
+    int frames = 200;
+    int16_t width = 480, height = 320, lines = 20;
+    uint32_t flush_delay = 0;
+    uint32_t read_delay = 0, byte_delay = 0;
+    bool double_buffer = false;
+    bool profiler = false;
+    const char *ppm_dir = NULL;
+    const char *only[SGL_ARRAY_SIZE(bench_scenes)];
+    size_t only_num = 0;
+    uint64_t time_res = bench_time_res_ns();
+
+    for (int i = 1; i < argc; i++) {
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "-d") == 0) {
+            double_buffer = true;
+            continue;
+        }
+        if (strcmp(arg, "-p") == 0) {
+            profiler = true;
+            continue;
+        }
+        if (strcmp(arg, "-h") == 0 || val == NULL) {
+            bench_usage(argv[0]);
+            return strcmp(arg, "-h") == 0 ? 0 : 1;
+        }
+
+        if (strcmp(arg, "-n") == 0) {
+            frames = atoi(val);
+        }
+        else if (strcmp(arg, "-s") == 0 && only_num < SGL_ARRAY_SIZE(only)) {
+            only[only_num++] = val;
+        }
+        else if (strcmp(arg, "-W") == 0) {
+            width = atoi(val);
+        }
+        else if (strcmp(arg, "-H") == 0) {
+            height = atoi(val);
+        }
+        else if (strcmp(arg, "-l") == 0) {
+            lines = atoi(val);
+        }
+        else if (strcmp(arg, "-o") == 0) {
+            ppm_dir = val;
+        }
+        else if (strcmp(arg, "-f") == 0) {
+            flush_delay = (uint32_t)atoi(val);
+        }
+        else if (strcmp(arg, "-r") == 0) {
+            read_delay = (uint32_t)atoi(val);
+        }
+        else if (strcmp(arg, "-b") == 0) {
+            byte_delay = (uint32_t)atoi(val);
+        }
+        else {
+            bench_usage(argv[0]);
+            return 1;
+        }
+        i++;
+    }
+
+    if (sgl_headless_fb_init(width, height, lines, double_buffer)) {
+        fprintf(stderr, "bench: failed to create headless frame buffer\n");
+        return 1;
+    }
+
+    sgl_headless_fb_set_flush_hook(bench_flush_hook);
+    if (sgl_headless_fb_set_flush_delay(flush_delay)) {
+        fprintf(stderr, "bench: failed to start flush worker\n");
+        return 1;
+    }
+    sgl_headless_flash_set_delay(read_delay, byte_delay);
+    sgl_mm_clock_register(bench_clock_ns);
+#if (CONFIG_SGL_PROFILER)
+    sgl_profiler_clock_register(bench_clock_us);
+    sgl_device_log_register(bench_log_puts);
+#endif
+    sgl_init();
+    bench_img_create();
+
+    printf("sgl bench: %dx%d, %d bpp, %d lines x %d buffer, %d frames per scene, %s flush %u ns/px\n",
+           width, height, CONFIG_SGL_PANEL_PIXEL_DEPTH, sgl_headless_fb_get()->lines,
+           double_buffer ? 2 : 1, frames, CONFIG_SGL_FLUSH_ASYNC ? "async" : "sync", flush_delay);
+    printf("%-12s %10s %10s %12s %10s %12s %14s\n",
+           "scene", "fps", "us/frame", "us/draw_task", "flushes", "flushed_px", "blended_px/s");
+
+    for (size_t i = 0; i < SGL_ARRAY_SIZE(bench_scenes); i++) {
+        const bench_scene_t *scene = &bench_scenes[i];
+        bench_result_t res;
+        bool selected = (only_num == 0);
+
+        for (size_t j = 0; j < only_num; j++) {
+            if (strcmp(only[j], scene->name) == 0) {
+                selected = true;
+            }
+        }
+        if (!selected) {
+            continue;
+        }
+
+        bench_run_scene(scene, frames, ppm_dir, &res);
+
+        /* a frame below the clock or the 0.1 us report resolution has no meaningful rate */
+        bool timed = res.frames > 0 && res.time_ns >= time_res
+                     && res.time_ns >= (uint64_t)res.frames * BENCH_TIME_RES_NS;
+        double secs = res.time_ns / 1e9;
+        double fps = timed ? res.frames / secs : 0;
+        char fps_str[16], frame_str[16], task_str[16], blend_str[24];
+
+        printf("%-12s %10s %10s %12s %10llu %12llu %14s\n",
+               scene->name,
+               bench_fmt_time(fps_str, sizeof(fps_str), "%.1f", fps, timed),
+               bench_fmt_time(frame_str, sizeof(frame_str), "%.1f",
+                              res.time_ns / 1e3 / sgl_max(res.frames, 1u), timed),
+               bench_fmt_time(task_str, sizeof(task_str), "%.1f",
+                              res.time_ns / 1e3 / sgl_max(res.draw_tasks, 1u), timed && res.draw_tasks > 0),
+               (unsigned long long)res.flush_cnt,
+               (unsigned long long)res.flush_pixels,
+               bench_fmt_time(blend_str, sizeof(blend_str), "%.0f", res.blended_per_frame * fps, timed));
+#if (CONFIG_SGL_PROFILER)
+        if (profiler) {
+            sgl_profiler_dump();
+        }
+#else
+        SGL_UNUSED(profiler);
+#endif
+    }
+
+#if (CONFIG_SGL_SLAB_SIZE)
+    sgl_slab_monitor_t mon;
+
+    printf("%-12s %10s %10s %10s %10s %10s\n", "slab size", "pages", "chunks", "used", "peak", "from heap");
+    for (int i = 0; sgl_slab_get_monitor(i, &mon) == 0; i++) {
+        printf("%-12zu %10zu %10zu %10zu %10zu %10zu\n",
+               mon.size, mon.page_num, mon.total, mon.used, mon.peak, mon.fallback);
+    }
+#endif
+    bench_print_heap();
+    bench_print_event();
+    bench_print_flash();
+
+    free(bench_img_map);
+    sgl_headless_flash_deinit();
+    sgl_headless_fb_deinit();
+
+    return 0;
+}
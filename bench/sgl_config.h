@@ -0,0 +1,76 @@
+//****************************************************************
+//* sgl bench configuration                                      *
+//* NOTE: this file shadows source/sgl_config.h for bench builds *
+//*       every macro can be overridden from the make command    *
+//****************************************************************
+
+#ifndef  __CONFIG_H__
+#define  __CONFIG_H__
+
+
+#ifndef  CONFIG_SGL_PANEL_PIXEL_DEPTH
+#define  CONFIG_SGL_PANEL_PIXEL_DEPTH                      16
+#endif
+#ifndef  CONFIG_SGL_EVENT_QUEUE_SIZE
+#define  CONFIG_SGL_EVENT_QUEUE_SIZE                       16
+#endif
+#ifndef  CONFIG_SGL_EVENT_HIT_GRID
+#define  CONFIG_SGL_EVENT_HIT_GRID                         0
+#endif
+#ifndef  CONFIG_SGL_SYSTICK_MS
+#define  CONFIG_SGL_SYSTICK_MS                             10
+#endif
+#ifndef  CONFIG_SGL_DIRTY_AREA_THRESHOLD
+#define  CONFIG_SGL_DIRTY_AREA_THRESHOLD                   64
+#endif
+#ifndef  CONFIG_SGL_USE_FULL_FB
+#define  CONFIG_SGL_USE_FULL_FB                            0
+#endif
+#define  CONFIG_SGL_COLOR16_SWAP                           0
+#ifndef  CONFIG_SGL_ANIMATION
+#define  CONFIG_SGL_ANIMATION                              0
+#endif
+#define  CONFIG_SGL_DEBUG                                  0
+#define  CONFIG_SGL_LOG_COLOR                              0
+#define  CONFIG_SGL_LOG_LEVEL                              0
+#ifndef  CONFIG_SGL_TEXT_UTF8
+#define  CONFIG_SGL_TEXT_UTF8                              0
+#endif
+#ifndef  CONFIG_SGL_EXTERNAL_PIXMAP
+#define  CONFIG_SGL_EXTERNAL_PIXMAP                        0
+#endif
+#ifndef  CONFIG_SGL_PIXMAP_QOI
+#define  CONFIG_SGL_PIXMAP_QOI                             0
+#endif
+#ifndef  CONFIG_SGL_TEXT_GLYPH_CACHE
+#define  CONFIG_SGL_TEXT_GLYPH_CACHE                       0
+#endif
+#define  CONFIG_SGL_OBJ_USE_NAME                           0
+#define  CONFIG_SGL_BOOT_LOGO                              0
+#define  CONFIG_SGL_BOOT_ANIMATION                         0
+#define  CONFIG_SGL_HEAP_ALGO                              lwmem
+#ifndef  CONFIG_SGL_HEAP_MEMORY_SIZE
+#define  CONFIG_SGL_HEAP_MEMORY_SIZE                       (4 * 1024 * 1024)
+#endif
+#ifndef  CONFIG_SGL_SLAB_SIZE
+#define  CONFIG_SGL_SLAB_SIZE                              0
+#endif
+#ifndef  CONFIG_SGL_MM_TAG
+#define  CONFIG_SGL_MM_TAG                                 1
+#endif
+#ifndef  CONFIG_SGL_FLUSH_ASYNC
+#define  CONFIG_SGL_FLUSH_ASYNC                            0
+#endif
+#ifndef  CONFIG_SGL_PROFILER
+#define  CONFIG_SGL_PROFILER                               0
+#endif
+#ifndef  CONFIG_SGL_DRAW_THREADS
+#define  CONFIG_SGL_DRAW_THREADS                           1
+#endif
+#define  CONFIG_SGL_FONT_SONG23                            1
+#define  CONFIG_SGL_FONT_CONSOLAS23                        0
+#define  CONFIG_SGL_FONT_KAI33                             0
+#define  CONFIG_SGL_FONT_CONSOLAS14                        1
+
+
+#endif  //!__CONFIG_H__
@@ -0,0 +1,386 @@
+/* bench/sgl_headless_fb.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200112L
+
+#include "sgl_headless_fb.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+
+static sgl_headless_fb_t headless_fb;
+
+
+/**
+ * @brief pending transfer of the worker thread, only one transfer is in flight
+ */
+typedef struct headless_xfer {
+    int16_t       x;
+    int16_t       y;
+    int16_t       w;
+    int16_t       h;
+    sgl_color_t   *src;
+    bool          pending;
+} headless_xfer_t;
+
+
+#if (CONFIG_SGL_FLUSH_ASYNC)
+static pthread_t       headless_worker;
+static pthread_mutex_t headless_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  headless_cond = PTHREAD_COND_INITIALIZER;
+static headless_xfer_t headless_xfer;
+static bool            headless_worker_run;
+#endif
+
+
+/**
+ * @brief copy rows of draw buffer into the in-memory panel
+ */
+static void headless_copy(int16_t x, int16_t y, int16_t w, int16_t h, sgl_color_t *src)
+{
+    sgl_headless_fb_t *fb = &headless_fb;
+    int16_t rows = h;
+
+    /* a single framebuffer is the panel memory itself */
+    if (src == &fb->screen[y * fb->xres + x]) {
+        return;
+    }
+
+    /* the last slice of a dirty area may run out of the panel, clip it */
+    if (y + rows > fb->yres) {
+        rows = fb->yres - y;
+    }
+
+    for (int16_t i = 0; i < rows; i++) {
+        memcpy(&fb->screen[(y + i) * fb->xres + x], &src[i * w], w * sizeof(sgl_color_t));
+    }
+}
+
+
+/**
+ * @brief sleep for the transfer time of pixels, the bus does not need CPU while it transfers
+ */
+static void headless_delay(uint32_t pixels)
+{
+    uint64_t ns = (uint64_t)pixels * headless_fb.flush_delay_ns;
+    struct timespec ts;
+
+    if (ns == 0) {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ns += ts.tv_nsec;
+    ts.tv_sec += ns / 1000000000u;
+    ts.tv_nsec = ns % 1000000000u;
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) != 0) {
+        /* interrupted by signal */
+    }
+}
+
+
+#if (CONFIG_SGL_FLUSH_ASYNC)
+/**
+ * @brief worker thread, it plays the role of DMA and its complete interrupt
+ */
+static void* headless_worker_entry(void *arg)
+{
+    headless_xfer_t xfer;
+    (void)arg;
+
+    pthread_mutex_lock(&headless_lock);
+    while (headless_worker_run) {
+        if (!headless_xfer.pending) {
+            pthread_cond_wait(&headless_cond, &headless_lock);
+            continue;
+        }
+
+        xfer = headless_xfer;
+        pthread_mutex_unlock(&headless_lock);
+
+        headless_delay((uint32_t)xfer.w * xfer.h);
+        headless_copy(xfer.x, xfer.y, xfer.w, xfer.h, xfer.src);
+
+        pthread_mutex_lock(&headless_lock);
+        headless_xfer.pending = false;
+        sgl_flush_ready();
+    }
+    pthread_mutex_unlock(&headless_lock);
+
+    return NULL;
+}
+#endif
+
+
+/**
+ * @brief flush area callback, copy the draw buffer into the in-memory panel
+ * @param x start x coordinate of area
+ * @param y start y coordinate of area
+ * @param w width of area
+ * @param h height of area
+ * @param src draw buffer, the pitch of it is w
+ * @return none
+ */
+static void headless_flush_area(int16_t x, int16_t y, int16_t w, int16_t h, sgl_color_t *src)
+{
+    sgl_headless_fb_t *fb = &headless_fb;
+
+    fb->flush_cnt ++;
+    fb->flush_pixels += (uint64_t)w * h;
+
+    if (fb->flush_hook) {
+        fb->flush_hook(x, y, w, h);
+    }
+
+#if (CONFIG_SGL_FLUSH_ASYNC)
+    if (fb->flush_delay_ns != 0) {
+        pthread_mutex_lock(&headless_lock);
+        headless_xfer = (headless_xfer_t) {
+            .x = x, .y = y, .w = w, .h = h, .src = src, .pending = true,
+        };
+        pthread_cond_signal(&headless_cond);
+        pthread_mutex_unlock(&headless_lock);
+        return;
+    }
+#endif
+
+    headless_delay((uint32_t)w * h);
+    headless_copy(x, y, w, h, src);
+    sgl_flush_ready();
+}
+
+
+/**
+ * @brief copy area callback, move pixels inside the in-memory panel like a panel with move command
+ * @param x start x coordinate of source area
+ * @param y start y coordinate of source area
+ * @param w width of area
+ * @param h height of area
+ * @param dx horizontal distance
+ * @param dy vertical distance
+ * @return none
+ */
+static void headless_copy_area(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx, int16_t dy)
+{
+    sgl_headless_fb_t *fb = &headless_fb;
+    int16_t row;
+
+    fb->copy_cnt ++;
+
+    /* copy rows in the order that source rows are read before they are written */
+    for (int16_t i = 0; i < h; i++) {
+        row = dy > 0 ? y + h - 1 - i : y + i;
+        memmove(&fb->screen[(row + dy) * fb->xres + x + dx], &fb->screen[row * fb->xres + x], w * sizeof(sgl_color_t));
+    }
+}
+
+
+int sgl_headless_fb_init(int16_t xres, int16_t yres, int16_t lines, bool double_buffer)
+{
+    sgl_headless_fb_t *fb = &headless_fb;
+    sgl_device_fb_t fb_dev;
+
+    memset(fb, 0, sizeof(sgl_headless_fb_t));
+    memset(&fb_dev, 0, sizeof(sgl_device_fb_t));
+
+    if (xres <= 0 || yres <= 0) {
+        return -1;
+    }
+
+    fb->xres = xres;
+    fb->yres = yres;
+    fb->screen = calloc((size_t)xres * yres, sizeof(sgl_color_t));
+    if (fb->screen == NULL) {
+        return -1;
+    }
+
+#if (CONFIG_SGL_USE_FULL_FB)
+    /* a single framebuffer is the panel memory, two framebuffers are flushed into it */
+    (void)lines;
+    fb->lines = yres;
+    fb->draw_buf[0] = fb->screen;
+    if (double_buffer) {
+        for (int i = 0; i < 2; i++) {
+            fb->draw_buf[i] = calloc((size_t)xres * yres, sizeof(sgl_color_t));
+            if (fb->draw_buf[i] == NULL) {
+                sgl_headless_fb_deinit();
+                return -1;
+            }
+        }
+    }
+#else
+    if (lines <= 0 || lines > yres) {
+        lines = yres;
+    }
+
+    fb->lines = lines;
+    for (int i = 0; i < (double_buffer ? 2 : 1); i++) {
+        fb->draw_buf[i] = calloc((size_t)xres * lines, sizeof(sgl_color_t));
+        if (fb->draw_buf[i] == NULL) {
+            sgl_headless_fb_deinit();
+            return -1;
+        }
+    }
+#endif
+
+    fb_dev.buffer[0] = fb->draw_buf[0];
+    fb_dev.buffer[1] = fb->draw_buf[1];
+    fb_dev.buffer_size = (uint32_t)xres * fb->lines;
+    fb_dev.xres = xres;
+    fb_dev.yres = yres;
+    fb_dev.xres_virtual = xres;
+    fb_dev.yres_virtual = yres;
+    fb_dev.flush_area = headless_flush_area;
+    fb_dev.copy_area = headless_copy_area;
+
+    return sgl_device_fb_register(&fb_dev);
+}
+
+
+void sgl_headless_fb_deinit(void)
+{
+    sgl_headless_fb_t *fb = &headless_fb;
+
+    sgl_headless_fb_set_flush_delay(0);
+
+    for (int i = 0; i < 2; i++) {
+        if (fb->draw_buf[i] != fb->screen) {
+            free(fb->draw_buf[i]);
+        }
+        fb->draw_buf[i] = NULL;
+    }
+
+    free(fb->screen);
+    fb->screen = NULL;
+}
+
+
+sgl_headless_fb_t* sgl_headless_fb_get(void)
+{
+    return &headless_fb;
+}
+
+
+void sgl_headless_fb_reset_stats(void)
+{
+    headless_fb.flush_cnt = 0;
+    headless_fb.flush_pixels = 0;
+    headless_fb.copy_cnt = 0;
+}
+
+
+void sgl_headless_fb_set_flush_hook(void (*hook)(int16_t x, int16_t y, int16_t w, int16_t h))
+{
+    headless_fb.flush_hook = hook;
+}
+
+
+/**
+ * @brief convert sgl color to 24 bits RGB
+ * @param color sgl color
+ * @param rgb output, 3 bytes
+ * @return none
+ */
+static void headless_color_to_rgb(sgl_color_t color, uint8_t *rgb)
+{
+#if (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_ARGB8888 || CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB888)
+    rgb[0] = color.ch.red;
+    rgb[1] = color.ch.green;
+    rgb[2] = color.ch.blue;
+#elif (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    rgb[0] = (color.ch.red << 3) | (color.ch.red >> 2);
+    rgb[1] = (color.ch.green << 2) | (color.ch.green >> 4);
+    rgb[2] = (color.ch.blue << 3) | (color.ch.blue >> 2);
+#elif (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB233)
+    rgb[0] = color.ch.red * 255 / 7;
+    rgb[1] = color.ch.green * 255 / 7;
+    rgb[2] = color.ch.blue * 255 / 3;
+#endif
+}
+
+
+int sgl_headless_fb_set_flush_delay(uint32_t ns_per_pixel)
+{
+#if (CONFIG_SGL_FLUSH_ASYNC)
+    sgl_flush_wait();
+
+    if (ns_per_pixel != 0 && !headless_worker_run) {
+        headless_worker_run = true;
+        if (pthread_create(&headless_worker, NULL, headless_worker_entry, NULL)) {
+            headless_worker_run = false;
+            return -1;
+        }
+    }
+    else if (ns_per_pixel == 0 && headless_worker_run) {
+        pthread_mutex_lock(&headless_lock);
+        headless_worker_run = false;
+        pthread_cond_signal(&headless_cond);
+        pthread_mutex_unlock(&headless_lock);
+        pthread_join(headless_worker, NULL);
+    }
+#endif
+
+    headless_fb.flush_delay_ns = ns_per_pixel;
+    return 0;
+}
+
+
+int sgl_headless_fb_save_ppm(const char *path)
+{
+    sgl_headless_fb_t *fb = &headless_fb;
+    uint8_t rgb[3];
+    FILE *fp;
+
+    /* the last transfer may be still in flight */
+    sgl_flush_wait();
+
+    if (fb->screen == NULL || path == NULL) {
+        return -1;
+    }
+
+    fp = fopen(path, "wb");
+    if (fp == NULL) {
+        return -1;
+    }
+
+    fprintf(fp, "P6\n%d %d\n255\n", fb->xres, fb->yres);
+    for (int32_t i = 0; i < (int32_t)fb->xres * fb->yres; i++) {
+        headless_color_to_rgb(fb->screen[i], rgb);
+        fwrite(rgb, 1, sizeof(rgb), fp);
+    }
+
+    return fclose(fp) == 0 ? 0 : -1;
+}
+
+
+uint64_t sgl_headless_time_us(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000u + ts.tv_nsec / 1000u;
+}
@@ -0,0 +1,131 @@
+/* bench/sgl_headless_fb.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SGL_HEADLESS_FB_H__
+#define __SGL_HEADLESS_FB_H__
+
+#include <sgl_core.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+
+/**
+ * @brief headless frame buffer device, it keeps a full copy of the panel in memory
+ * @screen: in-memory panel content, every flushed area is copied into it
+ * @draw_buf: draw buffers handed to sgl, draw_buf[1] is NULL for single buffer
+ * @xres: panel width
+ * @yres: panel height
+ * @lines: lines of one draw buffer
+ * @flush_cnt: number of flush_area calls since last reset
+ * @flush_pixels: number of pixels flushed since last reset
+ * @copy_cnt: number of copy_area calls since last reset
+ * @flush_hook: optional callback that is called on every flush, used by bench
+ * @flush_delay_ns: transfer time of one pixel, 0 means that flush_area copies at once
+ */
+typedef struct sgl_headless_fb {
+    sgl_color_t   *screen;
+    sgl_color_t   *draw_buf[2];
+    int16_t       xres;
+    int16_t       yres;
+    int16_t       lines;
+    uint64_t      flush_cnt;
+    uint64_t      flush_pixels;
+    uint64_t      copy_cnt;
+    void          (*flush_hook)(int16_t x, int16_t y, int16_t w, int16_t h);
+    uint32_t      flush_delay_ns;
+} sgl_headless_fb_t;
+
+
+/**
+ * @brief create headless frame buffer and register it into sgl
+ * @param xres panel width
+ * @param yres panel height
+ * @param lines lines of one draw buffer, it is ignored when CONFIG_SGL_USE_FULL_FB is enabled
+ * @param double_buffer true to use two draw buffers, they are two framebuffers when CONFIG_SGL_USE_FULL_FB
+ *        is enabled and they are flushed into the panel memory
+ * @return 0 if success, -1 if failed
+ * @note call this function before sgl_init()
+ */
+int sgl_headless_fb_init(int16_t xres, int16_t yres, int16_t lines, bool double_buffer);
+
+
+/**
+ * @brief release all buffers of headless frame buffer
+ * @param none
+ * @return none
+ */
+void sgl_headless_fb_deinit(void);
+
+
+/**
+ * @brief get headless frame buffer device
+ * @param none
+ * @return pointer of headless frame buffer device
+ */
+sgl_headless_fb_t* sgl_headless_fb_get(void);
+
+
+/**
+ * @brief reset flush statistics of headless frame buffer
+ * @param none
+ * @return none
+ */
+void sgl_headless_fb_reset_stats(void);
+
+
+/**
+ * @brief set flush hook, it is called after every flushed area
+ * @param hook flush hook, NULL to disable
+ * @return none
+ */
+void sgl_headless_fb_set_flush_hook(void (*hook)(int16_t x, int16_t y, int16_t w, int16_t h));
+
+
+/**
+ * @brief set transfer time of flush, it simulates a slow panel bus such as SPI
+ * @param ns_per_pixel transfer time of one pixel in nanoseconds, 0 to copy at once
+ * @return 0 if success, -1 if failed
+ * @note when CONFIG_SGL_FLUSH_ASYNC is enabled, the transfer is done by a worker thread which
+ *       calls sgl_flush_ready() after the delay, otherwise flush_area waits for the delay itself
+ */
+int sgl_headless_fb_set_flush_delay(uint32_t ns_per_pixel);
+
+
+/**
+ * @brief save current panel content into a binary PPM (P6) file
+ * @param path file path
+ * @return 0 if success, -1 if failed
+ */
+int sgl_headless_fb_save_ppm(const char *path);
+
+
+/**
+ * @brief get monotonic time in microseconds
+ * @param none
+ * @return microseconds
+ */
+uint64_t sgl_headless_time_us(void);
+
+
+#endif // !__SGL_HEADLESS_FB_H__
@@ -0,0 +1,114 @@
+/* bench/sgl_headless_flash.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "sgl_headless_flash.h"
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+
+static sgl_headless_flash_t headless_flash;
+static FILE *headless_flash_fp;
+
+
+/**
+ * @brief busy wait, a blocking SPI read keeps the CPU waiting for the bus
+ */
+static void headless_flash_delay(uint64_t ns)
+{
+    struct timespec ts;
+    uint64_t end;
+
+    if (ns == 0) {
+        return;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    end = (uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec + ns;
+
+    do {
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+    } while ((uint64_t)ts.tv_sec * 1000000000u + ts.tv_nsec < end);
+}
+
+
+int sgl_headless_flash_init(const void *data, size_t size)
+{
+    sgl_headless_flash_deinit();
+
+    headless_flash_fp = tmpfile();
+    if (headless_flash_fp == NULL) {
+        return -1;
+    }
+
+    if (fwrite(data, 1, size, headless_flash_fp) != size || fflush(headless_flash_fp) != 0) {
+        sgl_headless_flash_deinit();
+        return -1;
+    }
+
+    headless_flash.read_cnt = 0;
+    headless_flash.read_bytes = 0;
+
+    return 0;
+}
+
+
+void sgl_headless_flash_deinit(void)
+{
+    if (headless_flash_fp != NULL) {
+        fclose(headless_flash_fp);
+        headless_flash_fp = NULL;
+    }
+}
+
+
+sgl_headless_flash_t* sgl_headless_flash_get(void)
+{
+    return &headless_flash;
+}
+
+
+void sgl_headless_flash_set_delay(uint32_t read_ns, uint32_t byte_ns)
+{
+    headless_flash.read_delay_ns = read_ns;
+    headless_flash.byte_delay_ns = byte_ns;
+}
+
+
+void sgl_headless_flash_read(void *buff, uint32_t pos, size_t size)
+{
+    ssize_t len = pread(fileno(headless_flash_fp), buff, size, pos);
+
+    /* out of flash reads as erased */
+    if (len < (ssize_t)size) {
+        memset((uint8_t*)buff + (len > 0 ? len : 0), 0xff, size - (len > 0 ? len : 0));
+    }
+
+    headless_flash.read_cnt++;
+    headless_flash.read_bytes += size;
+    headless_flash_delay(headless_flash.read_delay_ns + (uint64_t)headless_flash.byte_delay_ns * size);
+}
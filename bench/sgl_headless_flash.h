@@ -0,0 +1,91 @@
+/* bench/sgl_headless_flash.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SGL_HEADLESS_FLASH_H__
+#define __SGL_HEADLESS_FLASH_H__
+
+#include <stddef.h>
+#include <stdint.h>
+
+
+/**
+ * @brief file backed external storage, it plays the role of SPI flash for external pixmaps
+ * @read_cnt: number of reads since last reset
+ * @read_bytes: number of bytes read since last reset
+ * @read_delay_ns: command and address time of one read
+ * @byte_delay_ns: transfer time of one byte
+ */
+typedef struct sgl_headless_flash {
+    uint64_t      read_cnt;
+    uint64_t      read_bytes;
+    uint32_t      read_delay_ns;
+    uint32_t      byte_delay_ns;
+} sgl_headless_flash_t;
+
+
+/**
+ * @brief write data into a temporary file that is read by sgl_headless_flash_read()
+ * @param data content of flash
+ * @param size bytes of data
+ * @return 0 if success, -1 if failed
+ */
+int sgl_headless_flash_init(const void *data, size_t size);
+
+
+/**
+ * @brief close the temporary file of flash
+ * @param none
+ * @return none
+ */
+void sgl_headless_flash_deinit(void);
+
+
+/**
+ * @brief get headless flash device
+ * @param none
+ * @return pointer of headless flash device
+ */
+sgl_headless_flash_t* sgl_headless_flash_get(void);
+
+
+/**
+ * @brief set access time of flash, the reader waits for it like a blocking SPI transfer
+ * @param read_ns command and address time of one read
+ * @param byte_ns transfer time of one byte
+ * @return none
+ */
+void sgl_headless_flash_set_delay(uint32_t read_ns, uint32_t byte_ns);
+
+
+/**
+ * @brief read function of external pixmap, see sgl_pixmap_t
+ * @param buff buffer that bytes are read into
+ * @param pos offset of bytes in flash
+ * @param size number of bytes
+ * @return none
+ */
+void sgl_headless_flash_read(void *buff, uint32_t pos, size_t size);
+
+
+#endif // !__SGL_HEADLESS_FLASH_H__
@@ -34,10 +34,19 @@
 sgl_anim_ctx_t anim_ctx = {
     .anim_list_head = NULL,
     .anim_list_tail = NULL,
+    .anim_iter = NULL,
     .anim_cnt = 0,
+    .delay_cnt = 0,
+    .tick_ms = 0,
+    .wheel_unit = 0,
+    .next_due_valid = false,
 };
 
 
+/* a time is due if it is not after now, it works when the time wraps */
+#define  anim_time_is_due(time, now)   ((int32_t)((time) - (now)) <= 0)
+
+
 /**
  * @brief  Animation static initialization
  * @param  anim - Animation object
@@ -46,8 +55,10 @@ sgl_anim_ctx_t anim_ctx = {
 void sgl_anim_init(sgl_anim_t *anim)
 {
     anim->next = NULL;
+    anim->prev = NULL;
     anim->data = NULL;
     anim->act_time = 0;
+    anim->act_start = 0;
     anim->act_delay = 0;
     anim->act_duration = 0;
     anim->start_value = 0;
@@ -60,6 +71,7 @@ void sgl_anim_init(sgl_anim_t *anim)
     anim->finish_cb = NULL;
     anim->auto_free = 0;
     anim->finished = 0;
+    anim->state = SGL_ANIM_STATE_IDLE;
 }
 
 
@@ -70,7 +82,7 @@ void sgl_anim_init(sgl_anim_t *anim)
 */
 sgl_anim_t* sgl_anim_create(void)
 {
-    sgl_anim_t *anim = sgl_malloc(sizeof(sgl_anim_t));
+    sgl_anim_t *anim = sgl_slab_alloc(sizeof(sgl_anim_t), SGL_MM_TAG_ANIM);
     if (anim == NULL) {
         SGL_LOG_ERROR("sgl_anim_create: malloc failed");
         return NULL;
@@ -82,87 +94,264 @@ sgl_anim_t* sgl_anim_create(void)
 
 
 /**
- * @brief add animation object to animation list
- * @param  anim animation object
+ * @brief get slot of timing wheel, it is the 8 ms unit of deadline
+ * @param  anim delayed animation object
+ * @return slot head
+ */
+static inline sgl_anim_t** anim_wheel_slot(sgl_anim_t *anim)
+{
+    uint32_t unit = anim->act_start >> SGL_ANIM_WHEEL_SHIFT;
+    return &anim_ctx.wheel[unit & (SGL_ANIM_WHEEL_SIZE - 1)];
+}
+
+
+/**
+ * @brief put animation into running list or timing wheel by its act_start
+ * @param  anim animation object that is not in any list
  * @return none
-*/
-void sgl_anim_add(sgl_anim_t *anim)
+ */
+static void anim_schedule(sgl_anim_t *anim)
 {
-    if (anim_ctx.anim_list_tail != NULL) {
-        anim_ctx.anim_list_tail->next = anim;
+    sgl_anim_t **slot;
+
+    if (anim_time_is_due(anim->act_start, anim_ctx.tick_ms)) {
+        anim->state = SGL_ANIM_STATE_RUNNING;
+        anim->next = NULL;
+        anim->prev = anim_ctx.anim_list_tail;
+
+        if (anim_ctx.anim_list_tail != NULL) {
+            anim_ctx.anim_list_tail->next = anim;
+        }
+        else {
+            anim_ctx.anim_list_head = anim;
+        }
         anim_ctx.anim_list_tail = anim;
+        return;
+    }
+
+    anim->state = SGL_ANIM_STATE_DELAYED;
+    slot = anim_wheel_slot(anim);
+    anim->prev = NULL;
+    anim->next = *slot;
+    if (*slot != NULL) {
+        (*slot)->prev = anim;
+    }
+    *slot = anim;
+
+    if (anim_ctx.delay_cnt == 0) {
+        anim_ctx.next_due = anim->act_start;
+        anim_ctx.next_due_valid = true;
+    }
+    else if (anim_ctx.next_due_valid && (int32_t)(anim->act_start - anim_ctx.next_due) < 0) {
+        anim_ctx.next_due = anim->act_start;
+    }
+    anim_ctx.delay_cnt ++;
+}
+
+
+/**
+ * @brief take animation out of running list or timing wheel
+ * @param  anim animation object that is in a list
+ * @return none
+ */
+static void anim_unschedule(sgl_anim_t *anim)
+{
+    if (anim->state == SGL_ANIM_STATE_RUNNING) {
+        /* sgl_anim_task() goes on with the next one */
+        if (anim_ctx.anim_iter == anim) {
+            anim_ctx.anim_iter = anim->next;
+        }
+
+        if (anim->prev != NULL) {
+            anim->prev->next = anim->next;
+        }
+        else {
+            anim_ctx.anim_list_head = anim->next;
+        }
+
+        if (anim->next != NULL) {
+            anim->next->prev = anim->prev;
+        }
+        else {
+            anim_ctx.anim_list_tail = anim->prev;
+        }
     }
     else {
-        anim_ctx.anim_list_head = anim;
-        anim_ctx.anim_list_tail = anim;
+        if (anim->prev != NULL) {
+            anim->prev->next = anim->next;
+        }
+        else {
+            *anim_wheel_slot(anim) = anim->next;
+        }
+
+        if (anim->next != NULL) {
+            anim->next->prev = anim->prev;
+        }
+
+        /* the earliest deadline is found again when it is asked */
+        if (anim->act_start == anim_ctx.next_due) {
+            anim_ctx.next_due_valid = false;
+        }
+        anim_ctx.delay_cnt --;
     }
 
+    anim->next = NULL;
+    anim->prev = NULL;
+    anim->state = SGL_ANIM_STATE_IDLE;
+}
+
+
+/**
+ * @brief add animation object to running list, or to timing wheel if it is in delay,
+ *        an animation that is already added is not changed
+ * @param  anim animation object
+ * @return none
+*/
+void sgl_anim_add(sgl_anim_t *anim)
+{
+    SGL_ASSERT(anim != NULL);
+
+    if (anim->state != SGL_ANIM_STATE_IDLE) {
+        return;
+    }
+
+    /* go on with the time of current cycle, it is 0 for a new animation */
+    anim->act_start = anim_ctx.tick_ms - anim->act_time + anim->act_delay;
+    anim_schedule(anim);
     anim_ctx.anim_cnt++;
 }
 
 
 /**
- * @brief remove animation object from animation list
+ * @brief remove animation object from running list or timing wheel,
+ *        the time of current cycle is kept for next sgl_anim_add()
  * @param  anim animation object
  * @return none
 */
 void sgl_anim_remove(sgl_anim_t *anim)
 {
     SGL_ASSERT(anim != NULL);
-    sgl_anim_t *prev = NULL;
 
-    if (anim_ctx.anim_list_head == anim) {
-        anim_ctx.anim_list_head = anim->next;
-        if (anim_ctx.anim_list_head == NULL) {
-            anim_ctx.anim_list_tail = NULL;
-        }
-        anim_ctx.anim_cnt--;
+    if (anim->state == SGL_ANIM_STATE_IDLE) {
         return;
     }
 
-    prev = anim_ctx.anim_list_head;
-    while (prev != NULL && prev->next != anim) {
-        prev = prev->next;
+    anim->act_time = anim_ctx.tick_ms - anim->act_start + anim->act_delay;
+    anim_unschedule(anim);
+    anim_ctx.anim_cnt--;
+}
+
+
+/**
+ * @brief wake up delayed animations whose deadline is passed, only the slots of
+ *        8 ms units since last call are visited, the last unit of last call is
+ *        visited again because it may hold deadlines later in that unit
+ * @param  none
+ * @return none
+ */
+static void anim_wheel_advance(void)
+{
+    uint32_t unit = anim_ctx.tick_ms >> SGL_ANIM_WHEEL_SHIFT;
+    uint32_t num = unit - anim_ctx.wheel_unit + 1;
+    sgl_anim_t *anim, *next;
+
+    if (num > SGL_ANIM_WHEEL_SIZE) {
+        num = SGL_ANIM_WHEEL_SIZE;
     }
 
-    if (prev == NULL) {
-        return;
+    for (uint32_t i = 0; i < num && anim_ctx.delay_cnt > 0; i++) {
+        anim = anim_ctx.wheel[(anim_ctx.wheel_unit + i) & (SGL_ANIM_WHEEL_SIZE - 1)];
+
+        /* a slot also holds deadlines of later rounds, they stay */
+        while (anim != NULL) {
+            next = anim->next;
+            if (anim_time_is_due(anim->act_start, anim_ctx.tick_ms)) {
+                anim_unschedule(anim);
+                anim_schedule(anim);
+            }
+            anim = next;
+        }
     }
-    prev->next = anim->next;
 
-    if (anim == anim_ctx.anim_list_tail) {
-        anim_ctx.anim_list_tail = prev;
+    anim_ctx.wheel_unit = unit;
+}
+
+
+/**
+ * @brief get time until the next animation is due
+ * @param  now  animation time that the result is relative to
+ * @return time until the next animation is due, ms
+ */
+static uint32_t anim_next_due(uint32_t now)
+{
+    sgl_anim_t *anim;
+
+    if (anim_ctx.anim_list_head != NULL) {
+        return 0;
     }
 
-    anim_ctx.anim_cnt--;
+    if (anim_ctx.delay_cnt == 0) {
+        return SGL_ANIM_NEVER;
+    }
+
+    if (!anim_ctx.next_due_valid) {
+        anim_ctx.next_due = anim_ctx.tick_ms + SGL_ANIM_NEVER / 2;
+        for (int i = 0; i < SGL_ANIM_WHEEL_SIZE; i++) {
+            for (anim = anim_ctx.wheel[i]; anim != NULL; anim = anim->next) {
+                if ((int32_t)(anim->act_start - anim_ctx.next_due) < 0) {
+                    anim_ctx.next_due = anim->act_start;
+                }
+            }
+        }
+        anim_ctx.next_due_valid = true;
+    }
+
+    return anim_time_is_due(anim_ctx.next_due, now) ? 0 : anim_ctx.next_due - now;
 }
 
 
 /**
- * @brief animation task, it will foreach all animation
+ * @brief get time until the next animation is due, the ticks that are counted
+ *        but not handled by sgl_task_handle() yet are taken into account
  * @param  none
- * @return none
+ * @return time until the next animation is due, ms, 0 if any animation is running,
+ *         SGL_ANIM_NEVER if there is no animation
+ */
+uint32_t sgl_anim_next_due(void)
+{
+    return anim_next_due(anim_ctx.tick_ms + sgl_tick_get());
+}
+
+
+/**
+ * @brief animation task, it wakes up delayed animations that are due and steps running animations,
+ *        animations in delay are not visited
+ * @param  none
+ * @return time until the next animation is due, ms, 0 if any animation is running,
+ *         SGL_ANIM_NEVER if there is no animation
  * @note   this function should be called in sgl_task()
  */
-void sgl_anim_task(void)
+uint32_t sgl_anim_task(void)
 {
     int32_t value = 0;
     uint32_t elaps_time = 0;
-    sgl_anim_t *anim = anim_ctx.anim_list_head, *next = NULL;
+    sgl_anim_t *anim;
+
+    anim_ctx.tick_ms += sgl_tick_get();
 
     /* if no anim object, do nothing */
     if (unlikely(anim_ctx.anim_cnt == 0)) {
-        return;
+        anim_ctx.wheel_unit = anim_ctx.tick_ms >> SGL_ANIM_WHEEL_SHIFT;
+        return SGL_ANIM_NEVER;
     }
 
-    while (anim != NULL) {
-        anim->act_time += sgl_tick_get();
+    anim_wheel_advance();
 
-        if(anim->act_time < anim->act_delay) {
-            continue;
-        }
-
-        elaps_time = anim->act_time - anim->act_delay;
+    /* callbacks may stop any animation, the iterator is moved on by sgl_anim_remove() */
+    anim = anim_ctx.anim_list_head;
+    while (anim != NULL) {
+        anim_ctx.anim_iter = anim->next;
+        elaps_time = anim_ctx.tick_ms - anim->act_start;
 
         /* check callback function for debug */
         SGL_ASSERT(anim->path_cb != NULL);
@@ -170,7 +359,7 @@ void sgl_anim_task(void)
         value = anim->path_algo(sgl_min(elaps_time, anim->act_duration), anim->act_duration, anim->start_value, anim->end_value);
         anim->path_cb(anim, value);
 
-        if (elaps_time > anim->act_duration) {
+        if (elaps_time > anim->act_duration && anim->state == SGL_ANIM_STATE_RUNNING) {
             if (anim->repeat_cnt != SGL_ANIM_REPEAT_LOOP) {
                 anim->repeat_cnt--;
             }
@@ -179,26 +368,31 @@ void sgl_anim_task(void)
                 anim->finish_cb(anim);
             }
 
-            /* reset anim active time */
-            anim->act_time = 0;
-
             /* remove anim object if repeat count is 0 */
             if (anim->repeat_cnt == 0) {
                 anim->finished = 1;
                 sgl_anim_stop(anim);
+                anim->act_time = 0;
 
                 /* if animation is auto free, free it */
                 if (anim->auto_free) {
-                    next = anim->next;
-                    sgl_free(anim);
-                    anim = next;
-                    continue;
+                    sgl_slab_free(anim);
+                }
+            }
+            else if (anim->state == SGL_ANIM_STATE_RUNNING) {
+                /* next cycle starts with its delay, it sleeps in timing wheel until then */
+                anim->act_start = anim_ctx.tick_ms + anim->act_delay;
+                if (anim->act_delay != 0) {
+                    anim_unschedule(anim);
+                    anim_schedule(anim);
                 }
             }
         }
 
-        anim = anim->next;
+        anim = anim_ctx.anim_iter;
     }
+
+    return anim_next_due(anim_ctx.tick_ms);
 }
 
 
@@ -0,0 +1,360 @@
+/* source/core/sgl_asset.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#if defined(__unix__) || defined(__APPLE__)
+#define _POSIX_C_SOURCE 200809L
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+#include <sgl_cfgfix.h>
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <sgl_asset.h>
+#include <string.h>
+
+
+#if (CONFIG_SGL_ASSET_PACK)
+
+/* the glyph table and the unicode list of a font in pack are used in place */
+typedef char sgl_asset_font_table_check[(sizeof(sgl_font_table_t) == 8) ? 1 : -1];
+typedef char sgl_asset_entry_check[(sizeof(sgl_asset_entry_t) == 48) ? 1 : -1];
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__)
+#error "asset pack can only be used on little endian targets"
+#endif
+
+
+/**
+ * @brief check the header and the index of pack
+ * @param header: header of pack
+ * @param entry: index of pack
+ * @param size: bytes of pack, 0 to take the size of header
+ * @return int: 0 if the pack is valid, otherwise -1
+ */
+static int asset_check(const sgl_asset_header_t *header, const sgl_asset_entry_t *entry, size_t size)
+{
+    const sgl_asset_entry_t *e;
+    uint32_t index_end;
+
+    if (header->magic != SGL_ASSET_MAGIC || header->version != SGL_ASSET_VERSION) {
+        SGL_LOG_ERROR("asset pack: bad magic or version");
+        return -1;
+    }
+
+    if (size == 0) {
+        size = header->size;
+    }
+
+    index_end = sizeof(sgl_asset_header_t) + header->count * sizeof(sgl_asset_entry_t);
+    if (header->size > size || index_end > header->size) {
+        SGL_LOG_ERROR("asset pack: truncated, %u of %u bytes", (unsigned)size, (unsigned)header->size);
+        return -1;
+    }
+
+    if (entry == NULL) {
+        return 0;
+    }
+
+    for (int i = 0; i < header->count; i++) {
+        e = &entry[i];
+
+        if (e->offset < index_end || e->offset > header->size || e->offset % 4
+            || e->size > header->size - e->offset
+            || e->name[SGL_ASSET_NAME_MAX - 1] != '\0') {
+            SGL_LOG_ERROR("asset pack: bad entry %d", i);
+            return -1;
+        }
+
+        if (e->type == SGL_ASSET_FONT
+            && (e->bitmap > e->size || e->bitmap < e->width * sizeof(sgl_font_table_t) + e->unicode_len * sizeof(uint16_t))) {
+            SGL_LOG_ERROR("asset pack: bad font %s", e->name);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+int sgl_asset_open(sgl_asset_pack_t *pack, const void *base, size_t size)
+{
+    const sgl_asset_header_t *header = (const sgl_asset_header_t*)base;
+
+    SGL_ASSERT(pack != NULL && base != NULL);
+    memset(pack, 0, sizeof(sgl_asset_pack_t));
+
+    if (((uintptr_t)base % 4) || size < sizeof(sgl_asset_header_t)) {
+        SGL_LOG_ERROR("asset pack: unaligned or too small");
+        return -1;
+    }
+
+    if (asset_check(header, (const sgl_asset_entry_t*)(header + 1), size)) {
+        return -1;
+    }
+
+    pack->base = (const uint8_t*)base;
+    pack->entry = (const sgl_asset_entry_t*)(header + 1);
+    pack->count = header->count;
+    pack->size = header->size;
+    return 0;
+}
+
+
+int sgl_asset_open_read(sgl_asset_pack_t *pack, void (*read)(void *buff, uint32_t pos, size_t size))
+{
+    sgl_asset_header_t header;
+    sgl_asset_entry_t *entry;
+
+    SGL_ASSERT(pack != NULL && read != NULL);
+    memset(pack, 0, sizeof(sgl_asset_pack_t));
+
+    read(&header, 0, sizeof(sgl_asset_header_t));
+    if (asset_check(&header, NULL, 0)) {
+        return -1;
+    }
+
+    /* index and the pointers of loaded data in one block */
+    entry = sgl_malloc_tag(header.count * (sizeof(sgl_asset_entry_t) + sizeof(uint8_t*)), SGL_MM_TAG_IMAGE);
+    if (entry == NULL) {
+        SGL_LOG_ERROR("asset pack: out of memory");
+        return -1;
+    }
+
+    read(entry, sizeof(sgl_asset_header_t), header.count * sizeof(sgl_asset_entry_t));
+    if (asset_check(&header, entry, 0)) {
+        sgl_free(entry);
+        return -1;
+    }
+
+    pack->entry = entry;
+    pack->count = header.count;
+    pack->size = header.size;
+    pack->read = read;
+    pack->loaded = (uint8_t**)&entry[header.count];
+    memset(pack->loaded, 0, header.count * sizeof(uint8_t*));
+    return 0;
+}
+
+
+#if defined(__unix__) || defined(__APPLE__)
+int sgl_asset_open_file(sgl_asset_pack_t *pack, const char *path)
+{
+    struct stat st;
+    void *base;
+    int fd;
+
+    SGL_ASSERT(pack != NULL && path != NULL);
+    memset(pack, 0, sizeof(sgl_asset_pack_t));
+
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        SGL_LOG_ERROR("asset pack: can not open %s", path);
+        return -1;
+    }
+
+    if (fstat(fd, &st) || st.st_size < (off_t)sizeof(sgl_asset_header_t)) {
+        SGL_LOG_ERROR("asset pack: bad file %s", path);
+        close(fd);
+        return -1;
+    }
+
+    /* the mapping keeps the file, so fd is not needed after mmap */
+    base = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED) {
+        SGL_LOG_ERROR("asset pack: can not map %s", path);
+        return -1;
+    }
+
+    if (sgl_asset_open(pack, base, st.st_size)) {
+        munmap(base, st.st_size);
+        return -1;
+    }
+
+    /* unmap the whole file even if the pack is shorter */
+    pack->size = st.st_size;
+    pack->mapped = true;
+    return 0;
+}
+#endif
+
+
+void sgl_asset_close(sgl_asset_pack_t *pack)
+{
+    SGL_ASSERT(pack != NULL);
+
+    /* the fonts of pack are cached by address of their struct, which may be filled again */
+    sgl_font_invalidate(NULL);
+
+    if (pack->read != NULL) {
+        for (int i = 0; i < pack->count; i++) {
+            if (pack->loaded[i] != NULL) {
+                sgl_free(pack->loaded[i]);
+            }
+        }
+        sgl_free((void*)pack->entry);
+    }
+#if defined(__unix__) || defined(__APPLE__)
+    else if (pack->mapped) {
+        munmap((void*)pack->base, pack->size);
+    }
+#endif
+
+    memset(pack, 0, sizeof(sgl_asset_pack_t));
+}
+
+
+const sgl_asset_entry_t* sgl_asset_find(sgl_asset_pack_t *pack, const char *name, sgl_asset_type_t type)
+{
+    SGL_ASSERT(pack != NULL && name != NULL);
+
+    for (int i = 0; i < pack->count; i++) {
+        if (pack->entry[i].type == type && strncmp(pack->entry[i].name, name, SGL_ASSET_NAME_MAX) == 0) {
+            return &pack->entry[i];
+        }
+    }
+
+    SGL_LOG_WARN("asset pack: %s is not found", name);
+    return NULL;
+}
+
+
+/**
+ * @brief get data of an asset, it points into the pack in memory, or it is loaded into
+ *        heap once for the pack that is read by function
+ * @param pack: asset pack
+ * @param entry: entry of asset
+ * @return const uint8_t*: data of asset, NULL if out of memory
+ */
+static const uint8_t* asset_data(sgl_asset_pack_t *pack, const sgl_asset_entry_t *entry)
+{
+    uint8_t **loaded;
+
+    if (pack->read == NULL) {
+        return pack->base + entry->offset;
+    }
+
+    loaded = &pack->loaded[entry - pack->entry];
+    if (*loaded == NULL) {
+        *loaded = sgl_malloc_tag(entry->size, SGL_MM_TAG_IMAGE);
+        if (*loaded == NULL) {
+            SGL_LOG_ERROR("asset pack: out of memory for %s", entry->name);
+            return NULL;
+        }
+        pack->read(*loaded, entry->offset, entry->size);
+    }
+
+    return *loaded;
+}
+
+
+int sgl_asset_get_pixmap(sgl_asset_pack_t *pack, const char *name, sgl_pixmap_t *pixmap)
+{
+    const sgl_asset_entry_t *entry = sgl_asset_find(pack, name, SGL_ASSET_PIXMAP);
+
+    SGL_ASSERT(pixmap != NULL);
+    if (entry == NULL) {
+        return -1;
+    }
+
+    memset(pixmap, 0, sizeof(sgl_pixmap_t));
+    pixmap->width = entry->width;
+    pixmap->height = entry->height;
+    pixmap->format = entry->format;
+
+#if (CONFIG_SGL_EXTERNAL_PIXMAP)
+    /* the raw pixels are read when they are drawn, bitmap is the offset in pack,
+     * a compressed pixmap is decoded from memory so it is loaded as a whole */
+    if (pack->read != NULL && entry->format == SGL_PIXMAP_FORMAT_RAW) {
+        pixmap->bitmap = (const uint8_t*)(uintptr_t)entry->offset;
+        pixmap->read = pack->read;
+        return 0;
+    }
+#endif
+
+    pixmap->bitmap = asset_data(pack, entry);
+    return pixmap->bitmap != NULL ? 0 : -1;
+}
+
+
+int sgl_asset_get_icon(sgl_asset_pack_t *pack, const char *name, sgl_icon_pixmap_t *icon)
+{
+    const sgl_asset_entry_t *entry = sgl_asset_find(pack, name, SGL_ASSET_ICON);
+
+    SGL_ASSERT(icon != NULL);
+    if (entry == NULL) {
+        return -1;
+    }
+
+    icon->bitmap = asset_data(pack, entry);
+    icon->width = entry->width;
+    icon->height = entry->height;
+    icon->bpp = entry->format;
+    return icon->bitmap != NULL ? 0 : -1;
+}
+
+
+int sgl_asset_get_font(sgl_asset_pack_t *pack, const char *name, sgl_font_t *font)
+{
+    const sgl_asset_entry_t *entry = sgl_asset_find(pack, name, SGL_ASSET_FONT);
+    const uint8_t *data;
+
+    SGL_ASSERT(font != NULL);
+    if (entry == NULL) {
+        return -1;
+    }
+
+#if (CONFIG_SGL_TEXT_UTF8)
+    if (entry->unicode_len == 0) {
+        SGL_LOG_ERROR("asset pack: font %s has no unicode list", entry->name);
+        return -1;
+    }
+#endif
+
+    data = asset_data(pack, entry);
+    if (data == NULL) {
+        return -1;
+    }
+
+    /* the struct may hold another font that is cached */
+    sgl_font_invalidate(font);
+    memset(font, 0, sizeof(sgl_font_t));
+    font->bitmap = data + entry->bitmap;
+    font->table = (const sgl_font_table_t*)data;
+    font->font_table_size = entry->width;
+    font->font_height = entry->height;
+    font->bpp = entry->format;
+#if (CONFIG_SGL_TEXT_UTF8)
+    font->unicode_list = (const uint16_t*)(data + entry->width * sizeof(sgl_font_table_t));
+    font->unicode_list_len = entry->unicode_len;
+#endif
+    return 0;
+}
+
+#endif // !CONFIG_SGL_ASSET_PACK
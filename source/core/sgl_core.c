@@ -31,6 +31,11 @@
 #include <sgl_draw.h>
 #include <sgl_font.h>
 #include <sgl_theme.h>
+#include <sgl_profiler.h>
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+#include <pthread.h>
+#include <stdint.h>
+#endif
 
 
 /* current context, page pointer, and dirty area */
@@ -49,9 +54,44 @@ sgl_context_t sgl_ctx = {
     },
     .page = NULL,
     .tick_ms = 0,
+    .frame_ms = 0,
 };
 
 
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+/**
+ * @brief parallel draw context, every thread draws slices of a dirty area into its own buffer
+ * @thread: draw threads, the thread that calls sgl_task_handle() is the first one
+ * @buffer: slice buffer of every thread
+ * @num: number of threads that are running
+ * @dirty: dirty area that is being drawn
+ * @slice_h: height of one slice
+ * @slice_num: number of slices in dirty area
+ * @flush_next: index of slice that flushes next
+ * @running: number of other threads that have not finished current dirty area
+ * @seq: sequence of dirty area, it wakes up other threads
+ */
+typedef struct sgl_draw_parallel {
+    pthread_t          thread[CONFIG_SGL_DRAW_THREADS - 1];
+    pthread_mutex_t    lock;
+    pthread_cond_t     start_cond;
+    pthread_cond_t     turn_cond;
+    pthread_cond_t     done_cond;
+    sgl_color_t        *buffer[CONFIG_SGL_DRAW_THREADS];
+    int                num;
+    sgl_area_t         dirty;
+    int16_t            slice_h;
+    int                slice_num;
+    int                flush_next;
+    int                running;
+    uint32_t           seq;
+} sgl_draw_parallel_t;
+
+static sgl_draw_parallel_t sgl_draw_par;
+static int sgl_draw_parallel_init(void);
+#endif // !CONFIG_SGL_DRAW_THREADS
+
+
 /**
  * the memory pool, it will be used to allocate memory for the page pool
 */
@@ -95,6 +135,7 @@ int sgl_device_fb_register(sgl_device_fb_t *fb_dev)
     sgl_ctx.fb_dev.xres_virtual     = fb_dev->xres_virtual;
     sgl_ctx.fb_dev.yres_virtual     = fb_dev->yres_virtual;
     sgl_ctx.fb_dev.flush_area       = fb_dev->flush_area;
+    sgl_ctx.fb_dev.copy_area        = fb_dev->copy_area;
 
     return 0;
 }
@@ -115,6 +156,32 @@ static inline void sgl_dirty_area_init(void)
 }
 
 
+/**
+ * @brief check if there is no dirty area
+ * @param none
+ * @return true if nothing is to be drawn, false if any area is dirty
+ */
+static inline bool sgl_dirty_area_is_empty(void)
+{
+#if CONFIG_SGL_DIRTY_AREA_THRESHOLD
+    return sgl_ctx.dirty_num == 0;
+#else
+    return sgl_ctx.dirty.x1 > sgl_ctx.dirty.x2;
+#endif
+}
+
+
+/**
+ * @brief mark draw list as out of date, it is rebuilt before the next frame is drawn
+ * @param none
+ * @return none
+ */
+static inline void sgl_draw_list_invalidate(void)
+{
+    sgl_ctx.draw_list_valid = false;
+}
+
+
 /**
  * @brief add object to parent
  * @param parent: pointer of parent object
@@ -137,6 +204,8 @@ void sgl_obj_add_child(sgl_obj_t *parent, sgl_obj_t *obj)
     }
 
     obj->parent = parent;
+    sgl_obj_dirty_propagate(obj);
+    sgl_draw_list_invalidate();
 }
 
 
@@ -164,6 +233,7 @@ void sgl_obj_remove(sgl_obj_t *obj)
     }
 
     obj->sibling = NULL;
+    sgl_draw_list_invalidate();
 }
 
 
@@ -182,7 +252,7 @@ void sgl_obj_set_pos(sgl_obj_t *obj, int16_t x, int16_t y)
     int16_t x_inc = x - obj->coords.x1;
     int16_t y_inc = y - obj->coords.y1;
 
-    obj->dirty = 1;
+    sgl_obj_set_dirty(obj);
     obj->coords.x1 = x + obj->parent->coords.x1;
     obj->coords.x2 += x_inc;
     obj->coords.y1 = y + obj->parent->coords.y1;
@@ -194,12 +264,15 @@ void sgl_obj_set_pos(sgl_obj_t *obj, int16_t x, int16_t y)
         return;
     }
     stack[top++] = obj->child;
+    /* all children are dirty, descend into them */
+    obj->dirty_child = 1;
 
     while (top > 0) {
 		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
 		obj = stack[--top];
 
         obj->dirty = 1;
+        obj->dirty_child = 1;
         obj->coords.x1 += x_inc;
         obj->coords.x2 += x_inc;
         obj->coords.y1 += y_inc;
@@ -255,6 +328,7 @@ void sgl_obj_move_up(sgl_obj_t *obj)
         obj->sibling = obj->sibling->sibling;
         /* mark object as dirty */
         sgl_obj_set_dirty(obj);
+        sgl_draw_list_invalidate();
         return;
     }
 
@@ -267,6 +341,7 @@ void sgl_obj_move_up(sgl_obj_t *obj)
             next->sibling = obj;
             /* mark object as dirty */
             sgl_obj_set_dirty(obj);
+            sgl_draw_list_invalidate();
             return;
         }
     }
@@ -296,6 +371,7 @@ void sgl_obj_move_down(sgl_obj_t *obj)
         parent->child = obj;
         /* mark object as dirty */
         sgl_obj_set_dirty(obj);
+        sgl_draw_list_invalidate();
         return;
     }
 
@@ -309,6 +385,7 @@ void sgl_obj_move_down(sgl_obj_t *obj)
             obj->sibling = prev;
             /* mark object as dirty */
             sgl_obj_set_dirty(obj);
+            sgl_draw_list_invalidate();
             return;
         }
     }
@@ -359,6 +436,7 @@ void sgl_obj_move_foreground(sgl_obj_t *obj)
     }
 
     sgl_obj_set_dirty(obj);
+    sgl_draw_list_invalidate();
 }
 
 
@@ -390,6 +468,7 @@ void sgl_obj_move_background(sgl_obj_t *obj)
     parent->child = obj;
     /* mark object as dirty */
     sgl_obj_set_dirty(obj);
+    sgl_draw_list_invalidate();
 }
 
 
@@ -409,7 +488,7 @@ int16_t sgl_obj_fix_radius(sgl_obj_t *obj, size_t radius)
         radius = r_min;
     }
 
-    obj->radius = radius & 0xFFF;
+    obj->radius = radius & 0x7FF;
     return radius;
 }
 
@@ -468,7 +547,11 @@ static void sgl_page_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
             sgl_draw_fill_rect(surf, &obj->area, &obj->coords, page->color, SGL_ALPHA_MAX);
         }
         else {
-            sgl_draw_fill_rect_pixmap(surf, &obj->area, &obj->coords, page->bg_img, SGL_ALPHA_MAX);
+            /* page is always opaque, fill the transparent pixels of a compressed pixmap with color */
+            if (!sgl_pixmap_is_opaque(pixmap)) {
+                sgl_draw_fill_rect(surf, &obj->area, &obj->coords, page->color, SGL_ALPHA_MAX);
+            }
+            sgl_draw_fill_rect_pixmap(surf, &obj->area, &obj->coords, pixmap, SGL_ALPHA_MAX);
         }
     }
     else {
@@ -512,7 +595,7 @@ void sgl_page_set_pixmap(sgl_obj_t* obj, const sgl_pixmap_t *pixmap)
  */
 static sgl_page_t* sgl_page_create(void)
 {
-    sgl_page_t *page = sgl_malloc(sizeof(sgl_page_t));
+    sgl_page_t *page = sgl_slab_alloc(sizeof(sgl_page_t), SGL_MM_TAG_OBJ);
     if (page == NULL) {
         SGL_LOG_ERROR("sgl_page_create: malloc failed");
         return NULL;
@@ -525,7 +608,7 @@ static sgl_page_t* sgl_page_create(void)
 
     if (sgl_ctx.fb_dev.buffer[0] == NULL) {
         SGL_LOG_ERROR("sgl_page_create: framebuffer is NULL");
-        sgl_free(page);
+        sgl_slab_free(page);
         return NULL;
     }
 
@@ -534,6 +617,7 @@ static sgl_page_t* sgl_page_create(void)
     page->surf.y = 0;
     page->surf.w = sgl_ctx.fb_dev.xres;
     page->surf.h = sgl_ctx.fb_dev.yres;
+    page->surf.pitch = sgl_ctx.fb_dev.xres;
     page->surf.size = sgl_ctx.fb_dev.buffer_size;
     page->color = SGL_THEME_DESKTOP;
 
@@ -541,6 +625,8 @@ static sgl_page_t* sgl_page_create(void)
     obj->clickable = 0;
     obj->construct_fn = sgl_page_construct_cb;
     obj->dirty = 1;
+    /* page always fills its area with color or pixmap */
+    obj->opaque = 1;
     obj->coords = (sgl_area_t) {
         .x1 = 0,
         .y1 = 0,
@@ -582,7 +668,7 @@ sgl_obj_t* sgl_obj_create(sgl_obj_t *parent)
         return obj;
     }
     else {
-        obj = (sgl_obj_t*)sgl_malloc(sizeof(sgl_obj_t));
+        obj = (sgl_obj_t*)sgl_slab_alloc(sizeof(sgl_obj_t), SGL_MM_TAG_OBJ);
         if (obj == NULL) {
             SGL_LOG_ERROR("malloc failed");
             return NULL;
@@ -621,10 +707,7 @@ void sgl_init(void)
 
 #if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
     /* alloc memory for dirty area */
-    sgl_ctx.dirty_num = ((sgl_panel_resolution_height() + SGL_DIRTY_AREA_THRESHOLD - 1) / SGL_DIRTY_AREA_THRESHOLD) *
-                        ((sgl_panel_resolution_width()  + SGL_DIRTY_AREA_THRESHOLD - 1) / SGL_DIRTY_AREA_THRESHOLD);
-
-    sgl_ctx.dirty = sgl_malloc(sgl_ctx.dirty_num * sizeof(sgl_area_t));
+    sgl_ctx.dirty = sgl_malloc_tag(SGL_DIRTY_AREA_NUM_MAX * sizeof(sgl_area_t), SGL_MM_TAG_DRAW);
     if (sgl_ctx.dirty == NULL) {
         SGL_LOG_ERROR("sgl dirty area memory alloc failed");
         SGL_ASSERT(0);
@@ -633,22 +716,38 @@ void sgl_init(void)
 #endif // !CONFIG_SGL_DIRTY_AREA_THRESHOLD
 
 #if (CONFIG_SGL_EXTERNAL_PIXMAP)
-    sgl_ctx.pixmap_buff = sgl_malloc(sgl_panel_resolution_width() * sizeof(sgl_color_t));
+    sgl_ctx.pixmap_buff = sgl_malloc_tag(sgl_panel_resolution_width() * sizeof(sgl_color_t), SGL_MM_TAG_IMAGE);
     if (sgl_ctx.pixmap_buff == NULL) {
         SGL_LOG_ERROR("sgl pixmap buff memory alloc failed");
         SGL_ASSERT(0);
         return;
     }
+
+#if (CONFIG_SGL_PIXMAP_CACHE)
+    /* pixmaps are read directly if it fails */
+    sgl_pixmap_cache_init();
+#endif
 #endif
 
     /* initialize dirty area */
     sgl_dirty_area_init();
 
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+    /* objects are found by walking all of them if it fails */
+    sgl_event_hit_init();
+#endif
+
     /* create a screen object for drawing */
     sgl_obj_create(NULL);
 
     /* create event queue */
     sgl_event_queue_init();
+
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+    if (sgl_draw_parallel_init()) {
+        SGL_LOG_WARN("sgl draws with %d threads", sgl_draw_par.num);
+    }
+#endif
 }
 
 
@@ -662,12 +761,23 @@ void sgl_screen_load(sgl_obj_t *obj)
     SGL_ASSERT(obj != NULL);
     sgl_ctx.page = (sgl_page_t*)obj;
 
+    /* the first draw buffer may be still in transfer */
+    sgl_flush_wait();
+
     /* initilize framebuffer swap */
     sgl_ctx.fb_swap = 0;
 
     /* initialize dirty area */
     sgl_dirty_area_init();
     sgl_obj_set_dirty(obj);
+
+    /* the whole page is redrawn, the pending scroll is useless */
+    sgl_ctx.scroll_obj = NULL;
+    sgl_draw_list_invalidate();
+
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+    sgl_event_hit_reset(obj);
+#endif
 }
 
 
@@ -822,57 +932,117 @@ void sgl_area_selfmerge(sgl_area_t *merge, sgl_area_t *area)
 }
 
 
+#if CONFIG_SGL_DIRTY_AREA_THRESHOLD
 /**
- * @brief merge area with current dirty area
- * @param merge [in] merge area
+ * @brief get number of pixels in an area
+ * @param area [in] area
+ * @return number of pixels
+ */
+static inline int32_t sgl_dirty_area_size(sgl_area_t *area)
+{
+    return (int32_t)(area->x2 - area->x1 + 1) * (area->y2 - area->y1 + 1);
+}
+
+
+/**
+ * @brief get the cost of drawing two dirty areas as one
+ * @param area_a [in] area a
+ * @param area_b [in] area b
+ * @param merge  [out] merged area
+ * @return extra pixels that merging costs, negative or zero means merging is cheaper
+ * @note drawing an area separately has a fixed cost (object walk and flush setup), it is
+ *       counted as SGL_DIRTY_AREA_MERGE_COST pixels
+ */
+static inline int32_t sgl_dirty_area_merge_cost(sgl_area_t *area_a, sgl_area_t *area_b, sgl_area_t *merge)
+{
+    sgl_area_merge(area_a, area_b, merge);
+    return sgl_dirty_area_size(merge) - sgl_dirty_area_size(area_a) - sgl_dirty_area_size(area_b) - SGL_DIRTY_AREA_MERGE_COST;
+}
+
+
+/**
+ * @brief add an area into dirty area list
+ * @param area [in] area that need to redraw
  * @return none
+ * @note the area is merged into the existing dirty area that costs least, if no merging is
+ *       cheaper than a separate area, it is appended. If the list is full, the whole screen
+ *       becomes the only dirty area.
  */
-void sgl_obj_dirty_merge(sgl_obj_t *obj)
+static void sgl_dirty_area_push(sgl_area_t *area)
 {
-    SGL_ASSERT(obj != NULL);
-#if CONFIG_SGL_DIRTY_AREA_THRESHOLD
-    int interval_x, interval_y;
+    sgl_area_t merge, best_merge;
+    int32_t cost, best_cost = 1;
+    int best = -1;
 
     /* skip invalid area */
-    if (obj->area.x1 >= obj->area.x2 || obj->area.y1 >= obj->area.y2) {
+    if (area->x1 > area->x2 || area->y1 > area->y2) {
         return;
     }
 
     for (int i = 0; i < sgl_ctx.dirty_num; i++) {
-        if (obj->area.x2 < sgl_ctx.dirty[i].x1) {
-            interval_x = sgl_ctx.dirty[i].x1 - obj->area.x2;
-        }
-        else if (obj->area.x1 > sgl_ctx.dirty[i].x2) {
-            interval_x = obj->area.x1 - sgl_ctx.dirty[i].x2;
-        }
-        else {
-            interval_x = 0;
+        cost = sgl_dirty_area_merge_cost(&sgl_ctx.dirty[i], area, &merge);
+        if (cost < best_cost) {
+            best_cost = cost;
+            best_merge = merge;
+            best = i;
         }
+    }
 
-        if (obj->area.y2 < sgl_ctx.dirty[i].y1) {
-            interval_y = sgl_ctx.dirty[i].y1 - obj->area.y2;
-        }
-        else if (obj->area.y1 > sgl_ctx.dirty[i].y2) {
-            interval_y = obj->area.y1 - sgl_ctx.dirty[i].y2;
-        }
-        else {
-            interval_y = 0;
-        }
+    if (best >= 0) {
+        sgl_ctx.dirty[best] = best_merge;
+        return;
+    }
 
-        /* If the object's area is near the dirty rectangle, merge it.*/
-        if (interval_x <= SGL_DIRTY_AREA_THRESHOLD && interval_y <= SGL_DIRTY_AREA_THRESHOLD) {
-            /* merge object area with dirty area */
-            sgl_ctx.dirty[i].x1 = sgl_min(sgl_ctx.dirty[i].x1, obj->area.x1);
-            sgl_ctx.dirty[i].x2 = sgl_max(sgl_ctx.dirty[i].x2, obj->area.x2);
-            sgl_ctx.dirty[i].y1 = sgl_min(sgl_ctx.dirty[i].y1, obj->area.y1);
-            sgl_ctx.dirty[i].y2 = sgl_max(sgl_ctx.dirty[i].y2, obj->area.y2);
+    if (sgl_ctx.dirty_num < SGL_DIRTY_AREA_NUM_MAX) {
+        sgl_ctx.dirty[sgl_ctx.dirty_num++] = *area;
+        return;
+    }
 
-            return;
+    SGL_LOG_TRACE("sgl_dirty_area_push: dirty area list is full, redraw whole screen");
+    sgl_ctx.dirty[0] = sgl_ctx.page->obj.coords;
+    sgl_ctx.dirty_num = 1;
+}
+
+
+/**
+ * @brief merge dirty areas again after all objects are visited
+ * @param none
+ * @return none
+ * @note an area that grows by merging may make it cheaper to merge with other areas, so it
+ *       repeats until no pair of areas should be merged
+ */
+static void sgl_dirty_area_remerge(void)
+{
+    sgl_area_t merge;
+    bool merged = true;
+
+    while (merged) {
+        merged = false;
+
+        for (int i = 0; i < sgl_ctx.dirty_num; i++) {
+            for (int j = i + 1; j < sgl_ctx.dirty_num; j++) {
+                if (sgl_dirty_area_merge_cost(&sgl_ctx.dirty[i], &sgl_ctx.dirty[j], &merge) <= 0) {
+                    sgl_ctx.dirty[i] = merge;
+                    sgl_ctx.dirty[j--] = sgl_ctx.dirty[--sgl_ctx.dirty_num];
+                    merged = true;
+                }
+            }
         }
     }
+}
+#endif // !CONFIG_SGL_DIRTY_AREA_THRESHOLD
+
 
-    sgl_ctx.dirty[sgl_ctx.dirty_num] = obj->area;
-    sgl_ctx.dirty_num ++;
+/**
+ * @brief merge area with current dirty area
+ * @param merge [in] merge area
+ * @return none
+ */
+void sgl_obj_dirty_merge(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+#if CONFIG_SGL_DIRTY_AREA_THRESHOLD
+    sgl_dirty_area_push(&obj->area);
 #else
     /* direct to merge object area with dirty area  */
     sgl_ctx.dirty.x1 = sgl_min(sgl_ctx.dirty.x1, obj->area.x1);
@@ -883,6 +1053,66 @@ void sgl_obj_dirty_merge(sgl_obj_t *obj)
 }
 
 
+/**
+ * @brief check that pixels on panel can be moved
+ * @param none
+ * @return true if pixels can be moved, otherwise false
+ * @note the framebuffer is moved by CPU when it is the only buffer, bytes of it are swapped by
+ *       flush when CONFIG_SGL_COLOR16_SWAP is enabled, so it can not be moved in this case.
+ *       With two framebuffers the lines are flushed from a buffer that is not moved, so the
+ *       moved pixels on panel would be overwritten, copy_area is not used in full framebuffer mode
+ */
+static inline bool sgl_scroll_is_supported(void)
+{
+#if (CONFIG_SGL_USE_FULL_FB)
+    return !CONFIG_SGL_COLOR16_SWAP && sgl_ctx.fb_dev.buffer[1] == NULL;
+#else
+    return sgl_ctx.fb_dev.copy_area != NULL;
+#endif
+}
+
+
+/**
+ * @brief scroll the content of object by moving its pixels on panel
+ * @param obj point to object
+ * @param view area of object that is moved
+ * @param dx horizontal distance of content
+ * @param dy vertical distance of content
+ * @return true if the scroll is accepted, otherwise false
+ * @note the pixels are moved before the next frame is drawn, it needs a dirty area list, the
+ *       single dirty area of CONFIG_SGL_DIRTY_AREA_THRESHOLD 0 would cover the moved pixels
+ */
+bool sgl_obj_scroll(sgl_obj_t *obj, sgl_area_t *view, int16_t dx, int16_t dy)
+{
+    SGL_ASSERT(obj != NULL && view != NULL);
+#if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
+    if (!sgl_scroll_is_supported()) {
+        return false;
+    }
+
+    if (sgl_ctx.scroll_obj == NULL) {
+        sgl_ctx.scroll_obj = obj;
+        sgl_ctx.scroll_view = *view;
+        sgl_ctx.scroll_dx = 0;
+        sgl_ctx.scroll_dy = 0;
+    }
+    else if (sgl_ctx.scroll_obj != obj || memcmp(&sgl_ctx.scroll_view, view, sizeof(sgl_area_t))) {
+        return false;
+    }
+
+    sgl_ctx.scroll_dx += dx;
+    sgl_ctx.scroll_dy += dy;
+    return true;
+#else
+    SGL_UNUSED(obj);
+    SGL_UNUSED(view);
+    SGL_UNUSED(dx);
+    SGL_UNUSED(dy);
+    return false;
+#endif
+}
+
+
 /**
  * @brief sgl set object layout type
  * @param obj [in] object
@@ -916,6 +1146,7 @@ void sgl_obj_set_layout(sgl_obj_t *obj, sgl_layout_type_t type)
             child->coords.y1 = obj->coords.y1 + obj->margin;
             child->coords.y2 = obj->coords.y2 - obj->margin;
             child_pos += (child_span[i++] + obj->margin);
+            sgl_obj_needinit(child);
         }
         break;
 
@@ -929,6 +1160,7 @@ void sgl_obj_set_layout(sgl_obj_t *obj, sgl_layout_type_t type)
             child->coords.y1 = child_pos;
             child->coords.y2 = child_pos + child_span[i] - 1;
             child_pos += (child_span[i++] + obj->margin);
+            sgl_obj_needinit(child);
         }
         break;
 
@@ -1004,8 +1236,17 @@ void sgl_obj_free(sgl_obj_t *obj)
 			stack[top++] = obj->child;
 		}
 
-        sgl_free(obj);
+        if (obj == sgl_ctx.scroll_obj) {
+            sgl_ctx.scroll_obj = NULL;
+        }
+
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+        sgl_event_hit_remove(obj);
+#endif
+        sgl_slab_free(obj);
     }
+
+    sgl_draw_list_invalidate();
 }
 
 
@@ -1045,17 +1286,66 @@ uint32_t sgl_utf8_to_unicode(const char *utf8_str, uint32_t *p_unicode_buffer)
 }
 
 
+/**
+ * @brief Find the index of a Unicode character by the unicode index of font
+ * @param index unicode index of font
+ * @param unicode Unicode of the character to be searched
+ * @param ch_index output, index of the character in the font table
+ * @return true if found, false if the character is not in the font
+ */
+static bool sgl_font_unicode_index_find(const sgl_font_unicode_index_t *index, uint32_t unicode, uint32_t *ch_index)
+{
+    const sgl_font_unicode_page_t *page;
+    uint32_t word, bit, page_num;
+
+    if (unicode - index->range_start < index->range_len) {
+        *ch_index = index->range_index + (unicode - index->range_start);
+        return true;
+    }
+
+    if (index->page_map == NULL || unicode > 0xFFFF) {
+        return false;
+    }
+
+    page_num = index->page_map[unicode >> 8];
+    if (page_num == 0xFF) {
+        return false;
+    }
+
+    page = &index->pages[page_num];
+    word = (unicode >> 5) & 0x7;
+    bit = 1u << (unicode & 0x1F);
+    if ((page->bits[word] & bit) == 0) {
+        return false;
+    }
+
+    *ch_index = page->base[word] + sgl_popcount(page->bits[word] & (bit - 1));
+    return true;
+}
+
+
 /**
  * @brief Search for the index of a Unicode character in the font table
  * @param font Pointer to the font structure containing character data
  * @param unicode Unicode of the character to be searched
  * @return Index of the character in the font table
+ * @note if the font has unicode index, the character is found in constant time,
+ *       otherwise the unicode list is searched by binary search
  */
 uint32_t sgl_search_unicode_ch_index(const sgl_font_t *font, uint32_t unicode)
 {
     uint32_t left = 0;
     uint32_t right = font->unicode_list_len - 1, mid = 0;
 
+    if (font->unicode_index != NULL) {
+        if (sgl_font_unicode_index_find(font->unicode_index, unicode, &mid)) {
+            return mid;
+        }
+
+        SGL_LOG_WARN("sgl_search_unicode_ch_index: unicode not found in font table");
+        return 0;
+    }
+
     while (left <= right) {
         mid = left + (right - left) / 2;
 
@@ -1390,143 +1680,534 @@ void sgl_obj_set_pos_align_ref(sgl_obj_t *ref, sgl_obj_t *obj, sgl_align_type_t
 
 
 /**
- * @brief draw object slice completely
- * @param obj it should point to active root object
+ * @brief check if an opaque object covers the whole slice
+ * @param obj point to object
+ * @param slice slice area
+ * @return true if every pixel of slice is drawn by object with full alpha
+ * @note an object with round corners is opaque over the cross of its coords without corners
+ */
+static inline bool sgl_obj_is_cover(sgl_obj_t *obj, sgl_area_t *slice)
+{
+    sgl_area_t *area = &obj->area;
+    sgl_area_t *coords = &obj->coords;
+    int16_t radius = obj->radius;
+
+    if (slice->x1 < area->x1 || slice->x2 > area->x2 || slice->y1 < area->y1 || slice->y2 > area->y2) {
+        return false;
+    }
+
+    if (radius == 0) {
+        return true;
+    }
+
+    return (slice->y1 >= coords->y1 + radius && slice->y2 <= coords->y2 - radius) ||
+           (slice->x1 >= coords->x1 + radius && slice->x2 <= coords->x2 - radius);
+}
+
+
+/**
+ * @brief find the last drawn opaque object that covers the whole slice
+ * @param slice slice area
+ * @return index of the draw node that covers the slice, 0 if not found
+ * @note objects are drawn from parent to child and from first to last sibling, so all objects
+ *       drawn before the returned object are hidden by it in this slice
+ */
+static inline uint16_t draw_obj_find_occluder(sgl_area_t *slice)
+{
+    sgl_draw_node_t *node;
+    uint16_t occluder = 0;
+    uint16_t i = 0;
+
+    while (i < sgl_ctx.draw_num) {
+        node = &sgl_ctx.draw_list[i];
+
+        if (!sgl_area_is_overlap(slice, &node->area) || sgl_obj_is_hidden(node->obj)) {
+            i = node->next;
+            continue;
+        }
+
+        if (sgl_obj_is_opaque(node->obj) && !sgl_obj_is_invalid(node->obj) && sgl_obj_is_cover(node->obj, slice)) {
+            occluder = i;
+        }
+
+        i ++;
+    }
+
+    return occluder;
+}
+
+
+/**
+ * @brief draw all objects into slice buffer, it does not flush
  * @param surf surface that draw to
  * @param dirty_h dirty height
  * @return none
  */
-static inline void draw_obj_slice(sgl_obj_t *obj, sgl_surf_t *surf, int16_t dirty_h)
+static inline void draw_obj_render(sgl_surf_t *surf, int16_t dirty_h)
 {
-    int top = 0;
 	sgl_event_t evt;
-	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
+    sgl_draw_node_t *node;
+    uint16_t occluder, i = 0;
+    sgl_area_t slice = {
+        .x1 = surf->x,
+        .y1 = surf->y,
+        .x2 = surf->x + surf->w - 1,
+        .y2 = surf->y + dirty_h - 1,
+    };
 
-	SGL_ASSERT(obj != NULL);
-	stack[top++] = obj;
+    /* skip all objects that are hidden by an opaque object in this slice */
+    occluder = draw_obj_find_occluder(&slice);
 
-	while (top > 0) {
-		SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
-		obj = stack[--top];
+    while (i < sgl_ctx.draw_num) {
+        node = &sgl_ctx.draw_list[i];
 
-		if (obj->sibling != NULL) {
-			stack[top++] = obj->sibling;
-		}
-
-        if (sgl_obj_is_hidden(obj)) {
+        /* the children of object are skipped with it */
+        if (!sgl_surf_area_is_overlap(surf, &node->area) || sgl_obj_is_hidden(node->obj)) {
+            i = node->next;
             continue;
         }
 
-		if (sgl_surf_area_is_overlap(surf, &obj->area)) {
-			evt.type = SGL_EVENT_DRAW_MAIN;
-			SGL_ASSERT(obj->construct_fn != NULL);
-			obj->construct_fn(surf, obj, &evt);
+        if (i >= occluder) {
+            evt.type = SGL_EVENT_DRAW_MAIN;
+            SGL_ASSERT(node->obj->construct_fn != NULL);
+            SGL_PROFILER_OBJ_BEGIN(t_obj);
+            node->obj->construct_fn(surf, node->obj, &evt);
+            SGL_PROFILER_OBJ_END(node->obj, t_obj);
+        }
 
-            if (obj->child != NULL) {
-                stack[top++] = obj->child;
-            }
-		}
-	}
+        i ++;
+    }
+}
+
+
+/**
+ * @brief draw object slice completely
+ * @param surf surface that draw to
+ * @param dirty_h dirty height
+ * @return none
+ */
+static inline void draw_obj_slice(sgl_surf_t *surf, int16_t dirty_h)
+{
+    /* without the second buffer, the only buffer may be still in transfer */
+    if (sgl_ctx.fb_dev.buffer[1] == NULL) {
+        sgl_flush_wait();
+    }
+
+    draw_obj_render(surf, dirty_h);
 
     /* flush dirty area into screen */
+    SGL_PROFILER_FLUSH_BEGIN(t_flush);
+#if (CONFIG_SGL_USE_FULL_FB)
+    /* the source of flush must be continuous, flush the whole lines of framebuffer */
+    sgl_panel_flush_area(0, surf->y, surf->pitch, dirty_h, surf->buffer - surf->x);
+    SGL_PROFILER_FLUSH_END(t_flush, surf->pitch, dirty_h);
+#else
     sgl_panel_flush_area(surf->x, surf->y, surf->w, dirty_h, surf->buffer);
+    SGL_PROFILER_FLUSH_END(t_flush, surf->w, dirty_h);
+#endif
 }
 
 
 /**
- * @brief calculate dirty area by for each all object that is dirty and visible
+ * @brief build draw list of all objects from root object in drawing order
  * @param obj it should point to active root object
- * @return true if there is dirty area, otherwise false
- * @note if there is no dirty area, the dirty area will remain unchanged
+ * @return 0 if success, -1 if out of memory
+ * @note while the list is built, next of an unfinished node keeps the index of its parent node,
+ *       so that no stack is needed and the depth of objects is not limited
  */
-static inline bool sgl_dirty_area_calculate(sgl_obj_t *obj)
+static int sgl_draw_list_build(sgl_obj_t *obj)
 {
-    bool need_draw = false;
-	sgl_obj_t *stack[SGL_OBJ_DEPTH_MAX];
-    int top = 0;
-    stack[top++] = obj;
+    sgl_draw_node_t *node;
+    uint16_t parent = 0, index;
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+    bool hit_sorted = true;
+#endif
 
-    /* for each all object from the first task of page */
-	while (top > 0) {
-        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
-		obj = stack[--top];
+    sgl_ctx.draw_num = 0;
 
-        /* if sibling exists, push it to stack, it will be pop in next loop */
-		if (obj->sibling != NULL) {
-			stack[top++] = obj->sibling;
-		}
+    while (1) {
+        if (unlikely(sgl_ctx.draw_num == sgl_ctx.draw_cap)) {
+            uint32_t cap = sgl_min((sgl_ctx.draw_cap + 8u) * 2u, UINT16_MAX);
+
+            node = (cap > sgl_ctx.draw_cap) ? sgl_realloc_tag(sgl_ctx.draw_list, cap * sizeof(sgl_draw_node_t), SGL_MM_TAG_DRAW) : NULL;
+            if (node == NULL) {
+                SGL_LOG_ERROR("sgl_draw_list_build: out of memory");
+                return -1;
+            }
+            sgl_ctx.draw_list = node;
+            sgl_ctx.draw_cap = cap;
+        }
+
+        index = sgl_ctx.draw_num ++;
+        node = &sgl_ctx.draw_list[index];
+        node->obj = obj;
+        node->area = obj->area;
+        node->next = parent;
+
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+        /* the cells of hit grid are sorted by drawing order, sort them again if it is changed */
+        if (obj->hit_seq != index) {
+            obj->hit_seq = index;
+            hit_sorted = false;
+        }
+#endif
 
-        /* if object is hidden, skip it */
-        if (unlikely(sgl_obj_is_hidden(obj))) {
+        if (obj->child != NULL) {
+            parent = index;
+            obj = obj->child;
             continue;
         }
 
-        /* check if obj is destroyed */
-        if (unlikely(sgl_obj_is_destroyed(obj))) {
-            /* merge destroy area */
-            sgl_obj_dirty_merge(obj);
+        /* finish the nodes whose children are all added, until one of them has next sibling */
+        while (1) {
+            node = &sgl_ctx.draw_list[index];
+            parent = node->next;
+            node->next = sgl_ctx.draw_num;
+
+            if (index == 0) {
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+                if (!hit_sorted) {
+                    sgl_event_hit_sort();
+                }
+#endif
+                sgl_ctx.draw_list_valid = true;
+                return 0;
+            }
 
-            /* if the object is active, do not remove it */
-            if (unlikely(obj == sgl_screen_act())) {
-                obj->destroyed = 0;
-                sgl_obj_node_init(obj);
-                return false;
+            if (node->obj->sibling != NULL) {
+                obj = node->obj->sibling;
+                break;
             }
 
-            /* update parent layout */
-            sgl_obj_set_layout(obj->parent, (sgl_layout_type_t)obj->parent->layout);
+            index = parent;
+        }
+    }
+}
+
+
+/**
+ * @brief set the children of object to dirty, so that they are clipped by its new area
+ * @param obj point to object
+ * @return none
+ * @note the children outside of parent are not dirty after they are checked, they are found
+ *       again here when the area of parent is changed
+ */
+static inline void sgl_obj_dirty_child_clip(sgl_obj_t *obj)
+{
+    sgl_obj_t *child;
+
+    sgl_obj_for_each_child(child, obj) {
+        child->dirty = 1;
+        obj->dirty_child = 1;
+    }
+}
 
-            /* remove obj from parent */
-            sgl_obj_remove(obj);
 
-            /* free obj resource */
-            sgl_obj_free(obj);
+/**
+ * @brief calculate dirty area by for each all object that is dirty and visible
+ * @param head it should point to active root object
+ * @return true if there is dirty area, otherwise false
+ * @note if there is no dirty area, the dirty area will remain unchanged, the draw list is valid
+ *       after it unless the heap is out of memory, only the objects that are marked by
+ *       sgl_obj_dirty_propagate() are visited, so an idle page costs nothing
+ */
+static inline bool sgl_dirty_area_calculate(sgl_obj_t *head)
+{
+    bool need_draw = false;
+    sgl_draw_node_t *node;
+    sgl_obj_t *obj;
+    sgl_area_t area;
+    uint16_t i;
 
-            need_draw = true;
-            /* object is destroyed, skip */
-            continue;
+    /* destroyed objects are removed and DRAW_INIT may create objects, scan the new list again */
+    do {
+        if (!sgl_ctx.draw_list_valid && sgl_draw_list_build(head)) {
+            return false;
         }
 
-        /* check child need init coords */
-        if (unlikely(sgl_obj_is_needinit(obj))) {
-            sgl_event_t evt = {
-                .type = SGL_EVENT_DRAW_INIT,
-            };
-
-            /* check construct function */
-            SGL_ASSERT(obj->construct_fn != NULL);
-            obj->construct_fn(NULL, obj, &evt);
-            /* maybe no need to clear flag */
-            sgl_obj_clear_needinit(obj);
-        }
+        /* for each all object from the first node of page */
+        for (i = 0; i < sgl_ctx.draw_num; ) {
+            node = &sgl_ctx.draw_list[i];
+            obj = node->obj;
 
-        /* check child dirty and merge all dirty area */
-        if (sgl_obj_is_dirty(obj)) {
-            /* update obj area */
-            if (unlikely(!sgl_area_clip(&obj->parent->area, &obj->coords, &obj->area))) {
-                sgl_obj_set_invalid(obj);
+            /* if object is hidden or nothing is changed in it and its children, skip them */
+            if (sgl_obj_is_hidden(obj) || !(obj->dirty | obj->destroyed | obj->needinit | obj->dirty_child)) {
+                i = node->next;
                 continue;
             }
+
+            /* check if obj is destroyed */
+            if (unlikely(sgl_obj_is_destroyed(obj))) {
+                /* merge destroy area */
+                sgl_obj_dirty_merge(obj);
+
+                /* if the object is active, do not remove it */
+                if (unlikely(obj == sgl_screen_act())) {
+                    obj->destroyed = 0;
+                    sgl_obj_node_init(obj);
+                    sgl_draw_list_invalidate();
+                    return false;
+                }
+
+                /* update parent layout */
+                sgl_obj_set_layout(obj->parent, (sgl_layout_type_t)obj->parent->layout);
+
+                /* remove obj from parent */
+                sgl_obj_remove(obj);
+
+                /* free obj resource, the nodes of its children are skipped */
+                sgl_obj_free(obj);
+
+                need_draw = true;
+                i = node->next;
+                continue;
+            }
+
+            /* check child need init coords */
+            if (unlikely(sgl_obj_is_needinit(obj))) {
+                sgl_event_t evt = {
+                    .type = SGL_EVENT_DRAW_INIT,
+                };
+
+                /* check construct function */
+                SGL_ASSERT(obj->construct_fn != NULL);
+                obj->construct_fn(NULL, obj, &evt);
+                /* maybe no need to clear flag */
+                sgl_obj_clear_needinit(obj);
+            }
+
+            /* check child dirty and merge all dirty area */
+            if (sgl_obj_is_dirty(obj)) {
+                /* update obj area */
+                if (unlikely(!sgl_area_clip(&obj->parent->area, &obj->coords, &area))) {
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+                    sgl_event_hit_update(obj, NULL);
+#endif
+                    sgl_obj_set_invalid(obj);
+                    /* it is checked again when it or its parent is changed, see below */
+                    sgl_obj_clear_dirty(obj);
+                    i = node->next;
+                    continue;
+                }
+                else {
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+                    sgl_event_hit_update(obj, &area);
+#endif
+                    /* children are clipped by the old area, such as the ones outside of it */
+                    if (sgl_obj_is_invalid(obj) || !sgl_area_is_equal(&obj->area, &area)) {
+                        sgl_obj_dirty_child_clip(obj);
+                    }
+                    obj->area = area;
+                    node->area = area;
+                    sgl_obj_set_valid(obj);
+                }
+
+                /* merge dirty area */
+                sgl_obj_dirty_merge(obj);
+
+                need_draw = true;
+
+                /* clear dirty flag */
+                sgl_obj_clear_dirty(obj);
+            }
+
+            /* children are marked again if they are changed by the objects before them */
+            if (obj->dirty_child) {
+                obj->dirty_child = 0;
+                i ++;
+            }
             else {
-                sgl_obj_set_valid(obj);
+                i = node->next;
             }
+        }
+    } while (!sgl_ctx.draw_list_valid);
 
-            /* merge dirty area */
-            sgl_obj_dirty_merge(obj);
+    return need_draw;
+}
 
-            need_draw = true;
 
-            /* clear dirty flag */
-            sgl_obj_clear_dirty(obj);
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+/**
+ * @brief draw slices of current dirty area that belong to one thread
+ * @param index index of thread, 0 is the thread that calls sgl_task_handle()
+ * @return none
+ * @note slices are handed out in turn, slice i is drawn by thread i % num, so that every
+ *       thread keeps working while the others wait for their turn to flush
+ */
+static void sgl_draw_parallel_slices(int index)
+{
+    sgl_draw_parallel_t *par = &sgl_draw_par;
+    sgl_surf_t surf = {
+        .buffer = par->buffer[index],
+        .x = par->dirty.x1,
+        .w = par->dirty.x2 - par->dirty.x1 + 1,
+        .h = par->slice_h,
+        .pitch = par->dirty.x2 - par->dirty.x1 + 1,
+        .size = sgl_ctx.page->surf.size,
+    };
+    int16_t dirty_h;
+
+    for (int i = index; i < par->slice_num; i += par->num) {
+        surf.y = par->dirty.y1 + i * par->slice_h;
+        dirty_h = sgl_min(par->dirty.y2 - surf.y + 1, surf.h);
+
+        draw_obj_render(&surf, dirty_h);
+
+        /* flush in order of slices */
+        pthread_mutex_lock(&par->lock);
+        while (par->flush_next != i) {
+            pthread_cond_wait(&par->turn_cond, &par->lock);
         }
+        pthread_mutex_unlock(&par->lock);
 
-		if (obj->child != NULL) {
-			stack[top++] = obj->child;
-		}
+        sgl_panel_flush_area(surf.x, surf.y, surf.w, dirty_h, surf.buffer);
+        /* buffer of this thread is used for next slice at once */
+        sgl_flush_wait();
+
+        pthread_mutex_lock(&par->lock);
+        par->flush_next ++;
+        pthread_cond_broadcast(&par->turn_cond);
+        pthread_mutex_unlock(&par->lock);
     }
+}
 
-    return need_draw;
+
+/**
+ * @brief entry of draw thread, it waits for a dirty area and draws its slices
+ * @param arg index of thread
+ * @return NULL
+ */
+static void* sgl_draw_parallel_entry(void *arg)
+{
+    sgl_draw_parallel_t *par = &sgl_draw_par;
+    int index = (int)(intptr_t)arg;
+    uint32_t seq = 0;
+
+    while (1) {
+        pthread_mutex_lock(&par->lock);
+        while (par->seq == seq) {
+            pthread_cond_wait(&par->start_cond, &par->lock);
+        }
+        seq = par->seq;
+        pthread_mutex_unlock(&par->lock);
+
+        sgl_draw_parallel_slices(index);
+
+        pthread_mutex_lock(&par->lock);
+        par->running --;
+        pthread_cond_signal(&par->done_cond);
+        pthread_mutex_unlock(&par->lock);
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief create draw threads and their slice buffers
+ * @param none
+ * @return 0 if success, -1 if failed
+ * @note if some threads can not be created, sgl draws with the created ones
+ */
+static int sgl_draw_parallel_init(void)
+{
+    sgl_draw_parallel_t *par = &sgl_draw_par;
+
+    pthread_mutex_init(&par->lock, NULL);
+    pthread_cond_init(&par->start_cond, NULL);
+    pthread_cond_init(&par->turn_cond, NULL);
+    pthread_cond_init(&par->done_cond, NULL);
+
+    par->num = 1;
+    par->buffer[0] = sgl_ctx.fb_dev.buffer[0];
+
+    for (int i = 1; i < CONFIG_SGL_DRAW_THREADS; i++) {
+        /* the second draw buffer is not swapped in parallel mode, use it as slice buffer */
+        if (i == 1 && sgl_ctx.fb_dev.buffer[1] != NULL) {
+            par->buffer[i] = sgl_ctx.fb_dev.buffer[1];
+        }
+        else {
+            par->buffer[i] = sgl_malloc_tag(sgl_ctx.fb_dev.buffer_size * sizeof(sgl_color_t), SGL_MM_TAG_DRAW);
+        }
+
+        if (par->buffer[i] == NULL) {
+            SGL_LOG_ERROR("sgl_draw_parallel_init: slice buffer alloc failed");
+            return -1;
+        }
+
+        if (pthread_create(&par->thread[i - 1], NULL, sgl_draw_parallel_entry, (void*)(intptr_t)i)) {
+            SGL_LOG_ERROR("sgl_draw_parallel_init: create draw thread failed");
+            return -1;
+        }
+
+        par->num = i + 1;
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief draw a dirty area with all draw threads
+ * @param dirty the dirty area that need to upate, it has been fixed into screen
+ * @return none
+ */
+static inline void sgl_draw_parallel(sgl_area_t *dirty)
+{
+    sgl_draw_parallel_t *par = &sgl_draw_par;
+    int16_t w = dirty->x2 - dirty->x1 + 1;
+
+    par->dirty = *dirty;
+    par->slice_h = sgl_ctx.page->surf.size / w;
+    par->slice_num = (dirty->y2 - dirty->y1 + par->slice_h) / par->slice_h;
+    par->flush_next = 0;
+    par->buffer[0] = sgl_ctx.page->surf.buffer;
+
+    /* one slice does not need other threads */
+    if (par->slice_num == 1 || par->num == 1) {
+        int num = par->num;
+        par->num = 1;
+        sgl_draw_parallel_slices(0);
+        par->num = num;
+        return;
+    }
+
+    pthread_mutex_lock(&par->lock);
+    par->running = par->num - 1;
+    par->seq ++;
+    pthread_cond_broadcast(&par->start_cond);
+    pthread_mutex_unlock(&par->lock);
+
+    sgl_draw_parallel_slices(0);
+
+    pthread_mutex_lock(&par->lock);
+    while (par->running > 0) {
+        pthread_cond_wait(&par->done_cond, &par->lock);
+    }
+    pthread_mutex_unlock(&par->lock);
 }
+#endif // !CONFIG_SGL_DRAW_THREADS
+
+
+#if (CONFIG_SGL_USE_FULL_FB && !CONFIG_SGL_COLOR16_SWAP)
+/**
+ * @brief copy an area from one framebuffer to the other one
+ * @param dst framebuffer to copy to
+ * @param src framebuffer to copy from
+ * @param pitch pixels of a line of framebuffer
+ * @param area area to copy
+ * @return none
+ */
+static inline void sgl_fb_copy_area(sgl_color_t *dst, const sgl_color_t *src, int16_t pitch, const sgl_area_t *area)
+{
+    size_t offset = (size_t)area->y1 * pitch + area->x1;
+    size_t bytes = (area->x2 - area->x1 + 1) * sizeof(sgl_color_t);
+
+    for (int16_t y = area->y1; y <= area->y2; y++, offset += pitch) {
+        memcpy(dst + offset, src + offset, bytes);
+    }
+}
+#endif
 
 
 /**
@@ -1538,55 +2219,279 @@ static inline bool sgl_dirty_area_calculate(sgl_obj_t *obj)
 static inline void sgl_draw_task(sgl_area_t *dirty)
 {
     sgl_surf_t *surf = &sgl_ctx.page->surf;
-    sgl_obj_t *head = &sgl_ctx.page->obj;
 
-    /* fix dirty area if it is out of screen */
+    /* fix dirty area if it is out of screen, the x2 and y2 of dirty area are inclusive */
     dirty->x1 = sgl_max(dirty->x1, 0);
-    /**
-     * dirty->x2 should be sgl_panel_resolution_width() - 1, but later surf->w is dirty->x2 - dirty->x1 + 1,
-     * so dirty->x2 can be sgl_panel_resolution_width(), the surf->w can be dirty->x2 - dirty->x1, for dirty->y2 is also.
-    */
-    dirty->x2 = sgl_min(dirty->x2, sgl_panel_resolution_width());
+    dirty->x2 = sgl_min(dirty->x2, sgl_panel_resolution_width() - 1);
     dirty->y1 = sgl_max(dirty->y1, 0);
-    dirty->y2 = sgl_min(dirty->y2, sgl_panel_resolution_height());
+    dirty->y2 = sgl_min(dirty->y2, sgl_panel_resolution_height() - 1);
 
-#if (!CONFIG_SGL_USE_FULL_FB)
+    if (dirty->x1 > dirty->x2 || dirty->y1 > dirty->y2) {
+        return;
+    }
+    SGL_PROFILER_DIRTY(dirty);
+
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+    SGL_UNUSED(surf);
+    sgl_draw_parallel(dirty);
+#elif (!CONFIG_SGL_USE_FULL_FB)
     /* to set start x and y position for dirty area */
     surf->y = dirty->y1;
     surf->x = dirty->x1;
-    surf->w = dirty->x2 - dirty->x1;
+    surf->w = dirty->x2 - dirty->x1 + 1;
     surf->h = surf->size / surf->w;
+    surf->pitch = surf->w;
     SGL_LOG_TRACE("sgl_draw_task: dirty area: x: %d, y: %d, w: %d, h: %d", dirty->x1, dirty->y1, surf->w, dirty->y2 - dirty->y1 + 1);
 
-    while (surf->y < dirty->y2) {
+    while (surf->y <= dirty->y2) {
         /* cycle draw widget slice until the end of dirty area */
-        draw_obj_slice(head, surf, sgl_min(dirty->y2 - surf->y + 1, surf->h));
+        draw_obj_slice(surf, sgl_min(dirty->y2 - surf->y + 1, surf->h));
         surf->y += surf->h;
 
         /* swap buffer for dma operation, but it depends on double buffer */
         sgl_surf_buffer_swap(surf);
     }
 #else
-    SGL_LOG_TRACE("sgl_draw_task: dirty area: x: %d, y: %d, w: %d, h: %d", dirty->x1, dirty->y1, surf->w, dirty->y2 - dirty->y1 + 1);
-    draw_obj_slice(head, surf, sgl_min(dirty->y2 - surf->y + 1, surf->h));
+#if (CONFIG_SGL_COLOR16_SWAP)
+    /* flush swaps the bytes of whole lines in place, so whole lines are drawn again */
+    dirty->x1 = 0;
+    dirty->x2 = sgl_panel_resolution_width() - 1;
+#endif
+
+    /* draw the dirty area inside framebuffer only, the surface keeps the pitch of framebuffer */
+    sgl_surf_t area_surf = {
+        .buffer = surf->buffer + dirty->y1 * surf->pitch + dirty->x1,
+        .x = dirty->x1,
+        .y = dirty->y1,
+        .w = dirty->x2 - dirty->x1 + 1,
+        .h = dirty->y2 - dirty->y1 + 1,
+        .pitch = surf->pitch,
+        .size = surf->size,
+    };
+
+    SGL_LOG_TRACE("sgl_draw_task: dirty area: x: %d, y: %d, w: %d, h: %d", dirty->x1, dirty->y1, area_surf.w, area_surf.h);
+    draw_obj_slice(&area_surf, area_surf.h);
+
     /* swap buffer for dma operation, but it depends on double buffer */
-    sgl_surf_buffer_swap(surf);
+    if (sgl_ctx.fb_dev.buffer[1] != NULL) {
+        sgl_color_t *front = surf->buffer;
+
+        sgl_surf_buffer_swap(surf);
+#if (!CONFIG_SGL_COLOR16_SWAP)
+        /* the other buffer misses this area and whole lines of it are flushed later, copy the
+         * area into it, the buffer is not in transfer because only one flush is in flight */
+        sgl_fb_copy_area(surf->buffer, front, surf->pitch, dirty);
+#else
+        SGL_UNUSED(front);
+#endif
+    }
 #endif
 }
 
 
+#if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
 /**
- * @brief sgl task handle function
- * @param none
+ * @brief check that nothing is drawn over the view of scrolling object
+ * @param obj scrolling object
+ * @param view view of object
+ * @return 1 if pixels of view can be moved, 0 if the object should be redrawn, -1 if the object
+ *         is not visible
+ * @note objects are drawn in order of draw list, the objects after the scrolling object,
+ *       include its children, are drawn over it
+ */
+static int sgl_scroll_check(sgl_obj_t *obj, sgl_area_t *view)
+{
+    sgl_draw_node_t *node;
+    bool found = false;
+    uint16_t i = 0;
+
+    while (i < sgl_ctx.draw_num) {
+        node = &sgl_ctx.draw_list[i];
+
+        if (sgl_obj_is_hidden(node->obj)) {
+            i = node->next;
+            continue;
+        }
+
+        if (node->obj == obj) {
+            found = true;
+        }
+        else if (found && sgl_area_is_overlap(&node->area, view)) {
+            return 0;
+        }
+
+        i ++;
+    }
+
+    if (!found || sgl_obj_is_invalid(obj)) {
+        return -1;
+    }
+
+    for (int i = 0; i < sgl_ctx.dirty_num; i++) {
+        if (sgl_area_is_overlap(&sgl_ctx.dirty[i], view)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+
+/**
+ * @brief move pixels of area on panel
+ * @param dst destination area, it is inside of panel
+ * @param dx horizontal distance
+ * @param dy vertical distance
  * @return none
- * @note this function should be called in main loop or timer or thread
  */
-void sgl_task_handle(void)
+static void sgl_scroll_move(sgl_area_t *dst, int16_t dx, int16_t dy)
 {
-    /* If the system tick time has not been reached, skip directly. */
-    if (sgl_tick_get() < SGL_SYSTEM_TICK_MS) {
+    int16_t w = dst->x2 - dst->x1 + 1;
+    int16_t h = dst->y2 - dst->y1 + 1;
+
+    /* the last transfer may still read the framebuffer or write the panel */
+    sgl_flush_wait();
+
+#if (CONFIG_SGL_USE_FULL_FB && !CONFIG_SGL_COLOR16_SWAP)
+    if (sgl_ctx.fb_dev.buffer[1] == NULL) {
+        sgl_surf_t *surf = &sgl_ctx.page->surf;
+        sgl_color_t *buf;
+
+        /* copy rows in the order that source rows are read before they are written */
+        for (int16_t i = 0; i < h; i++) {
+            buf = sgl_surf_get_buf(surf, dst->x1, dy > 0 ? dst->y2 - i : dst->y1 + i);
+            memmove(buf, buf - dy * surf->pitch - dx, w * sizeof(sgl_color_t));
+        }
+
+        /* the source of flush must be continuous, flush the whole lines of framebuffer */
+        sgl_panel_flush_area(0, dst->y1, surf->pitch, h, sgl_surf_get_buf(surf, 0, dst->y1));
         return;
     }
+#endif
+
+    sgl_ctx.fb_dev.copy_area(dst->x1 - dx, dst->y1 - dy, w, h, dx, dy);
+}
+
+
+/**
+ * @brief apply pending scroll, move the pixels that are still valid and add the rest of object
+ *        into dirty area
+ * @param none
+ * @return true if there is dirty area, otherwise false
+ */
+static bool sgl_scroll_apply(void)
+{
+    sgl_obj_t *obj = sgl_ctx.scroll_obj;
+    sgl_area_t view, dst, piece[4];
+    int16_t dx = sgl_ctx.scroll_dx, dy = sgl_ctx.scroll_dy;
+    int ret;
+
+    if (obj == NULL) {
+        return false;
+    }
+    sgl_ctx.scroll_obj = NULL;
+
+    if (!sgl_area_clip(&obj->area, &sgl_ctx.scroll_view, &view)) {
+        sgl_dirty_area_push(&obj->area);
+        return true;
+    }
+
+    ret = sgl_scroll_check(obj, &view);
+    if (ret < 0) {
+        return false;
+    }
+
+    /* the moved content of view, the pixels out of it are not valid */
+    dst.x1 = sgl_max(view.x1, view.x1 + dx);
+    dst.x2 = sgl_min(view.x2, view.x2 + dx);
+    dst.y1 = sgl_max(view.y1, view.y1 + dy);
+    dst.y2 = sgl_min(view.y2, view.y2 + dy);
+
+    if (ret == 0 || dst.x1 > dst.x2 || dst.y1 > dst.y2) {
+        sgl_dirty_area_push(&obj->area);
+        return true;
+    }
+
+    if (dx != 0 || dy != 0) {
+        sgl_scroll_move(&dst, dx, dy);
+    }
+
+    /* the rest of object area, top, bottom, left and right of destination */
+    piece[0] = (sgl_area_t){ obj->area.x1, obj->area.y1, obj->area.x2, dst.y1 - 1 };
+    piece[1] = (sgl_area_t){ obj->area.x1, dst.y2 + 1, obj->area.x2, obj->area.y2 };
+    piece[2] = (sgl_area_t){ obj->area.x1, dst.y1, dst.x1 - 1, dst.y2 };
+    piece[3] = (sgl_area_t){ dst.x2 + 1, dst.y1, obj->area.x2, dst.y2 };
+
+    for (int i = 0; i < 4; i++) {
+        sgl_dirty_area_push(&piece[i]);
+    }
+
+    return true;
+}
+#endif // !CONFIG_SGL_DIRTY_AREA_THRESHOLD
+
+
+/**
+ * @brief check if the next frame has something to draw
+ * @param none
+ * @return true if any object is changed or any area is dirty
+ */
+static bool sgl_draw_is_pending(void)
+{
+    sgl_obj_t *page = &sgl_ctx.page->obj;
+
+    if (page->dirty | page->destroyed | page->needinit | page->dirty_child) {
+        return true;
+    }
+
+    if (!sgl_ctx.draw_list_valid || sgl_ctx.scroll_obj != NULL) {
+        return true;
+    }
+
+    return !sgl_dirty_area_is_empty();
+}
+
+
+/**
+ * @brief get milliseconds until sgl_task_handle() has something to do, it is the
+ *        time to next frame if an event is pending or something is to be drawn,
+ *        otherwise the time until the next animation is due
+ * @param none
+ * @return milliseconds that the host can sleep, 0 if the work is due now,
+ *         SGL_TASK_NEVER if nothing is pending
+ * @note an event that is sent while the host sleeps calls the hook that is registered
+ *       by sgl_event_wakeup_register(), so the host can stop sleeping
+ */
+uint32_t sgl_task_next_due(void)
+{
+    uint32_t elaps = sgl_tick_get();
+    uint32_t frame = elaps < SGL_SYSTEM_TICK_MS ? SGL_SYSTEM_TICK_MS - elaps : 0;
+    uint32_t due = SGL_TASK_NEVER;
+
+    if (sgl_event_is_pending() || sgl_draw_is_pending()) {
+        return frame;
+    }
+
+#if (CONFIG_SGL_ANIMATION)
+    due = sgl_anim_next_due();
+    if (due != SGL_ANIM_NEVER) {
+        due = sgl_max(due, frame);
+    }
+#endif // !CONFIG_SGL_ANIMATION
+
+    return due;
+}
+
+
+/**
+ * @brief handle a frame, events, animations and dirty areas
+ * @param none
+ * @return none
+ */
+static void sgl_task_frame(void)
+{
+    bool need_draw;
+
     /* event task */
     sgl_event_task();
 
@@ -1595,13 +2500,32 @@ void sgl_task_handle(void)
 #endif // !CONFIG_SGL_ANIMATION
     sgl_tick_reset();
 
+    SGL_PROFILER_FRAME_BEGIN();
+
     /* calculate dirty area, if no dirty area, return directly */
-    if (! sgl_dirty_area_calculate(&sgl_ctx.page->obj)) {
+    SGL_PROFILER_CALC_BEGIN();
+    need_draw = sgl_dirty_area_calculate(&sgl_ctx.page->obj);
+
+    /* the draw list can not be built without memory, try it again in next frame */
+    if (unlikely(!sgl_ctx.draw_list_valid)) {
+        SGL_PROFILER_FRAME_END(false);
+        return;
+    }
+#if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
+    need_draw |= sgl_scroll_apply();
+#endif
+    /* areas may be merged without a dirty object, such as the old area of a moved hidden object */
+    need_draw |= !sgl_dirty_area_is_empty();
+    if (! need_draw) {
+        SGL_PROFILER_FRAME_END(false);
         return;
     }
+    SGL_PROFILER_CALC_END();
 
     /* draw task  */
 #if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
+    sgl_dirty_area_remerge();
+
     for (int i = 0; i < sgl_ctx.dirty_num; i++) {
         sgl_draw_task(&sgl_ctx.dirty[i]);
     }
@@ -1609,4 +2533,24 @@ void sgl_task_handle(void)
     sgl_draw_task(&sgl_ctx.dirty);
 #endif
     sgl_dirty_area_init();
+
+    SGL_PROFILER_FRAME_END(true);
+}
+
+
+/**
+ * @brief sgl task handle function, a frame is handled if SGL_SYSTEM_TICK_MS
+ *        milliseconds are passed since last frame
+ * @param none
+ * @return milliseconds that the host can sleep before next call, see sgl_task_next_due()
+ * @note this function should be called in main loop or timer or thread
+ */
+uint32_t sgl_task_handle(void)
+{
+    /* If the system tick time has not been reached, skip directly. */
+    if (sgl_tick_get() >= SGL_SYSTEM_TICK_MS) {
+        sgl_task_frame();
+    }
+
+    return sgl_task_next_due();
 }
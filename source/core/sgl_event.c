@@ -45,17 +45,81 @@ static sgl_event_pos_t touch_atc_pos[2] = {
 };
 
 
+/* memory model of event queue, it is shared by interrupts, threads and sgl_task_handle() */
+#define evtq_load(ptr)                 __atomic_load_n(ptr, __ATOMIC_ACQUIRE)
+#define evtq_store(ptr, val)           __atomic_store_n(ptr, val, __ATOMIC_RELEASE)
+#define evtq_cas(ptr, exp, val)        __atomic_compare_exchange_n(ptr, exp, val, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#define evtq_add(ptr, val)             __atomic_fetch_add(ptr, val, __ATOMIC_RELAXED)
+
+
+/* slots that only press, release and other events can use, motion events are dropped before */
+#define SGL_EVENT_QUEUE_RESERVE        (SGL_EVENT_QUEUE_SIZE / 4)
+
+
+/**
+ * @brief slot of event queue
+ * @event: event of slot
+ * @seq: position that the slot is waiting for, it is the position when the slot is free,
+ *       and the position + 1 when the event is ready to pop
+ * @busy: the slot is being read by sgl_event_task() or its motion is being coalesced
+ */
+typedef struct sgl_event_slot {
+    sgl_event_t       event;
+    uint32_t          seq;
+    uint8_t           busy;
+} sgl_event_slot_t;
+
+
+/**
+ * @brief lock free event queue, many senders push and sgl_event_task() pops
+ * @slot: ring of slots
+ * @head: position of next pop, it is only changed by sgl_event_task()
+ * @tail: position of next push
+ * @stat: counters of queue
+ */
 static struct event_queue {
-    sgl_event_t* buffer;
-    uint16_t capacity;
-    uint16_t head;
-    uint16_t tail;
-    uint16_t size;
+    sgl_event_slot_t  *slot;
+    uint32_t          capacity;
+    uint32_t          head;
+    uint32_t          tail;
+    sgl_event_stat_t  stat;
 } evtq;
 
 
 /* define event queue buffer  */
-static sgl_event_t evtq_buffer[SGL_EVENT_QUEUE_SIZE] = {0};
+static sgl_event_slot_t evtq_buffer[SGL_EVENT_QUEUE_SIZE] = {0};
+
+
+/* called after an event is pushed, so a sleeping host can handle it */
+static void (*event_wakeup)(void) = NULL;
+
+
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+/**
+ * @brief objects whose area overlaps a cell of hit grid
+ * @obj: objects, sorted by paint order
+ * @num: number of objects
+ * @cap: capacity of obj array
+ */
+typedef struct sgl_hit_cell {
+    struct sgl_obj **obj;
+    uint16_t       num;
+    uint16_t       cap;
+} sgl_hit_cell_t;
+
+
+/**
+ * @brief hit grid of active page, the panel is split into cells of CONFIG_SGL_EVENT_HIT_GRID
+ *        pixels, every cell keeps the objects that overlap it
+ * @note the grid is invalid if it failed to alloc memory, then the object tree is walked
+ */
+static struct hit_grid {
+    sgl_hit_cell_t *cell;
+    int16_t        cols;
+    int16_t        rows;
+    bool           valid;
+} hit;
+#endif
 
 
 /**
@@ -71,9 +135,15 @@ int sgl_event_queue_init(void)
         return -1;
     }
 
-    evtq.buffer = evtq_buffer;
+    evtq.slot = evtq_buffer;
     evtq.capacity = SGL_EVENT_QUEUE_SIZE;
-    evtq.head = evtq.tail = evtq.size = 0;
+    evtq.head = evtq.tail = 0;
+    memset(&evtq.stat, 0, sizeof(evtq.stat));
+
+    for (uint32_t i = 0; i < evtq.capacity; i++) {
+        evtq.slot[i].seq = i;
+        evtq.slot[i].busy = 0;
+    }
 
     return 0;
 }
@@ -86,42 +156,161 @@ int sgl_event_queue_init(void)
  */
 static inline bool sgl_event_queue_is_empty(void)
 {
-    return evtq.size == 0;
+    return evtq_load(&evtq.tail) == evtq_load(&evtq.head);
+}
+
+
+/**
+ * @brief Coalesce a motion event into the last event of queue, if it is a motion event
+ *        that is not popped yet, only the position of the last one is kept
+ * @param event The motion event to be pushed
+ * @param tail The position of next push
+ * @return true if the event is coalesced, false if it should be pushed
+ */
+static bool sgl_event_queue_coalesce(sgl_event_t *event, uint32_t tail)
+{
+    sgl_event_slot_t *slot = &evtq.slot[(tail - 1) & (evtq.capacity - 1)];
+    uint8_t idle = 0;
+    bool done = false;
+
+    if (evtq_load(&slot->seq) != tail) {
+        return false;
+    }
+
+    /* never wait here, the sender may be an interrupt that stops sgl_event_task() */
+    if (!evtq_cas(&slot->busy, &idle, 1)) {
+        return false;
+    }
+
+    /* the slot may be popped or a new event may be pushed before it is locked */
+    if (evtq_load(&slot->seq) == tail && evtq_load(&evtq.tail) == tail
+        && slot->event.type == SGL_EVENT_MOTION && slot->event.obj == NULL) {
+        slot->event.pos = event->pos;
+        done = true;
+    }
+
+    evtq_store(&slot->busy, 0);
+    return done;
 }
 
 
 /**
- * @brief Push an event into the event queue
+ * @brief Push an event into the event queue, it is safe to be called from interrupts
+ *        and threads while sgl_event_task() pops
  * @param event The event to be pushed
- * @return 0 on success, -1 on failure
+ * @return none
+ * @note a motion event is coalesced into the last one if it is a motion event too, motion
+ *       events are dropped if the queue is almost full, so the last slots are kept for press
+ *       and release events, they are only dropped if the whole queue is full of them
  */
 void sgl_event_queue_push(sgl_event_t event)
 {
-    if (unlikely( evtq.size == evtq.capacity )) {
-        SGL_LOG_ERROR("Event queue is full, maybe system is too slow");
-        evtq.head = evtq.tail = evtq.size = 0;
+    bool motion = (event.type == SGL_EVENT_MOTION && event.obj == NULL);
+    uint32_t limit = evtq.capacity - (motion ? SGL_EVENT_QUEUE_RESERVE : 0);
+    uint32_t tail = evtq_load(&evtq.tail);
+    sgl_event_slot_t *slot;
+    int32_t diff;
+
+    while (1) {
+        if (motion && sgl_event_queue_coalesce(&event, tail)) {
+            evtq_add(&evtq.stat.coalesced, 1);
+            return;
+        }
+
+        /* tail may be old if other senders have pushed, then it is reloaded below */
+        if ((int32_t)(tail - evtq_load(&evtq.head)) >= (int32_t)limit) {
+            SGL_LOG_WARN("Event queue is full, drop event %d, maybe system is too slow", event.type);
+            evtq_add(&evtq.stat.dropped, 1);
+            return;
+        }
+
+        slot = &evtq.slot[tail & (evtq.capacity - 1)];
+        diff = (int32_t)(evtq_load(&slot->seq) - tail);
+
+        if (diff == 0) {
+            if (evtq_cas(&evtq.tail, &tail, tail + 1)) {
+                break;
+            }
+            /* tail is reloaded by failed cas */
+        }
+        else {
+            /* the slot is not popped yet or another sender has taken it */
+            tail = evtq_load(&evtq.tail);
+        }
     }
 
-    evtq.buffer[evtq.tail] = event;
-    evtq.tail = ((evtq.tail + 1) & (evtq.capacity - 1));
-    evtq.size++;
+    slot->event = event;
+    evtq_store(&slot->seq, tail + 1);
+    evtq_add(&evtq.stat.pushed, 1);
+
+    if (event_wakeup != NULL) {
+        event_wakeup();
+    }
 }
 
 
 /**
- * @brief Pop an event from the event queue
+ * @brief Check whether any event is waiting to be handled
+ * @param none
+ * @return true if the event queue is not empty
+ */
+bool sgl_event_is_pending(void)
+{
+    return !sgl_event_queue_is_empty();
+}
+
+
+/**
+ * @brief Register the hook that is called after an event is pushed
+ * @param wakeup hook function, NULL to remove it
+ * @return none
+ * @note the hook is called in the context of the sender, such as an interrupt handler,
+ *       so it should only wake up the thread that calls sgl_task_handle()
+ */
+void sgl_event_wakeup_register(void (*wakeup)(void))
+{
+    event_wakeup = wakeup;
+}
+
+
+/**
+ * @brief Get counters of event queue
+ * @param stat [out] counters of event queue
+ * @return none
+ */
+void sgl_event_get_stat(sgl_event_stat_t *stat)
+{
+    stat->pushed = evtq_load(&evtq.stat.pushed);
+    stat->coalesced = evtq_load(&evtq.stat.coalesced);
+    stat->dropped = evtq_load(&evtq.stat.dropped);
+}
+
+
+/**
+ * @brief Pop an event from the event queue, only sgl_event_task() pops
  * @param out_event The event to be popped
  * @return 0 on success, -1 on failure
  */
 static inline int sgl_event_queue_pop(sgl_event_t* out_event)
 {
-    if (sgl_event_queue_is_empty()) {
+    uint32_t head = evtq.head;
+    sgl_event_slot_t *slot = &evtq.slot[head & (evtq.capacity - 1)];
+    uint8_t idle = 0;
+
+    /* the slot is taken by a sender but the event is not written yet */
+    if (evtq_load(&slot->seq) != head + 1) {
+        return -1;
+    }
+
+    /* a sender is coalescing motion into the slot, pop it in next frame */
+    if (!evtq_cas(&slot->busy, &idle, 1)) {
         return -1;
     }
 
-    *out_event = evtq.buffer[evtq.head];
-    evtq.head = ((evtq.head + 1) & (evtq.capacity - 1));
-    evtq.size--;
+    *out_event = slot->event;
+    evtq_store(&slot->seq, head + evtq.capacity);
+    evtq_store(&slot->busy, 0);
+    evtq_store(&evtq.head, head + 1);
 
     return 0;
 }
@@ -175,12 +364,289 @@ static bool pos_is_focus_on_obj(sgl_event_pos_t *pos, sgl_rect_t *rect, int16_t
 }
 
 
+#if (CONFIG_SGL_EVENT_HIT_GRID)
 /**
- * @brief check whether the position is clicked on the object
+ * @brief get cells that an area overlaps
+ * @param area [in] area
+ * @param range [out] range of cell column and row, inclusive
+ * @return true if the area overlaps the grid, otherwise false
+ */
+static bool hit_cell_range(sgl_area_t *area, sgl_area_t *range)
+{
+    if (area->x1 > area->x2 || area->y1 > area->y2 || area->x2 < 0 || area->y2 < 0) {
+        return false;
+    }
+
+    range->x1 = sgl_max(area->x1, 0) / CONFIG_SGL_EVENT_HIT_GRID;
+    range->y1 = sgl_max(area->y1, 0) / CONFIG_SGL_EVENT_HIT_GRID;
+    range->x2 = sgl_min(area->x2 / CONFIG_SGL_EVENT_HIT_GRID, hit.cols - 1);
+    range->y2 = sgl_min(area->y2 / CONFIG_SGL_EVENT_HIT_GRID, hit.rows - 1);
+
+    return range->x1 <= range->x2 && range->y1 <= range->y2;
+}
+
+
+/**
+ * @brief get the cell of a position
+ * @param pos position
+ * @return cell, NULL if the position is out of panel
+ */
+static inline sgl_hit_cell_t* hit_cell_at(sgl_event_pos_t *pos)
+{
+    int16_t col = pos->x / CONFIG_SGL_EVENT_HIT_GRID;
+    int16_t row = pos->y / CONFIG_SGL_EVENT_HIT_GRID;
+
+    if (pos->x < 0 || pos->y < 0 || col >= hit.cols || row >= hit.rows) {
+        return NULL;
+    }
+
+    return &hit.cell[row * hit.cols + col];
+}
+
+
+/**
+ * @brief insert an object into a cell, in paint order
+ * @param cell cell
+ * @param obj object
+ * @return 0 on success, -1 on failure
+ */
+static int hit_cell_insert(sgl_hit_cell_t *cell, struct sgl_obj *obj)
+{
+    struct sgl_obj **buf;
+    int pos = cell->num;
+
+    if (cell->num == cell->cap) {
+        buf = sgl_realloc_tag(cell->obj, (cell->cap + 4) * 2 * sizeof(struct sgl_obj*), SGL_MM_TAG_EVENT);
+        if (buf == NULL) {
+            return -1;
+        }
+        cell->obj = buf;
+        cell->cap = (cell->cap + 4) * 2;
+    }
+
+    /* objects are mostly added in paint order, so search from the end */
+    while (pos > 0 && cell->obj[pos - 1]->hit_seq > obj->hit_seq) {
+        pos --;
+    }
+
+    memmove(&cell->obj[pos + 1], &cell->obj[pos], (cell->num - pos) * sizeof(struct sgl_obj*));
+    cell->obj[pos] = obj;
+    cell->num ++;
+
+    return 0;
+}
+
+
+/**
+ * @brief remove an object from a cell
+ * @param cell cell
+ * @param obj object
+ * @return none
+ */
+static void hit_cell_remove(sgl_hit_cell_t *cell, struct sgl_obj *obj)
+{
+    for (int i = 0; i < cell->num; i++) {
+        if (cell->obj[i] == obj) {
+            cell->num --;
+            memmove(&cell->obj[i], &cell->obj[i + 1], (cell->num - i) * sizeof(struct sgl_obj*));
+            return;
+        }
+    }
+}
+
+
+/**
+ * @brief add or remove an object in all cells that an area overlaps
+ * @param obj object
+ * @param area area of object
+ * @param insert true to add, false to remove
+ * @return none
+ * @note the grid becomes invalid if it fails to alloc memory
+ */
+static void hit_grid_set(struct sgl_obj *obj, sgl_area_t *area, bool insert)
+{
+    sgl_area_t range;
+
+    if (!hit.valid || !hit_cell_range(area, &range)) {
+        return;
+    }
+
+    for (int16_t row = range.y1; row <= range.y2; row++) {
+        for (int16_t col = range.x1; col <= range.x2; col++) {
+            if (!insert) {
+                hit_cell_remove(&hit.cell[row * hit.cols + col], obj);
+            }
+            else if (hit_cell_insert(&hit.cell[row * hit.cols + col], obj)) {
+                SGL_LOG_WARN("hit grid: out of memory, walk all objects");
+                hit.valid = false;
+                return;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief alloc the cells of hit grid, it is called by sgl_init()
+ * @param none
+ * @return 0 on success, -1 on failure
+ * @note the grid covers the panel with cells of CONFIG_SGL_EVENT_HIT_GRID pixels, it stays
+ *       invalid if it fails, then objects are found by walking all of them
+ */
+int sgl_event_hit_init(void)
+{
+    hit.cols = (sgl_panel_resolution_width() + CONFIG_SGL_EVENT_HIT_GRID - 1) / CONFIG_SGL_EVENT_HIT_GRID;
+    hit.rows = (sgl_panel_resolution_height() + CONFIG_SGL_EVENT_HIT_GRID - 1) / CONFIG_SGL_EVENT_HIT_GRID;
+    hit.cell = sgl_malloc_tag(hit.cols * hit.rows * sizeof(sgl_hit_cell_t), SGL_MM_TAG_EVENT);
+    if (hit.cell == NULL) {
+        SGL_LOG_ERROR("hit grid memory alloc failed");
+        hit.valid = false;
+        return -1;
+    }
+
+    memset(hit.cell, 0, hit.cols * hit.rows * sizeof(sgl_hit_cell_t));
+    hit.valid = true;
+    return 0;
+}
+
+
+/**
+ * @brief rebuild hit grid with the drawn objects of a page, it is called when the page is loaded
+ * @param page page object
+ * @return none
+ * @note it also numbers the objects in paint order, the cells are sorted by the number
+ */
+void sgl_event_hit_reset(struct sgl_obj *page)
+{
+    struct sgl_obj *stack[SGL_OBJ_DEPTH_MAX], *obj;
+    uint16_t seq = 0;
+    int top = 0;
+
+    if (hit.cell == NULL) {
+        return;
+    }
+
+    /* the memory of cells is kept, it is enough for the last page in most cases */
+    for (int i = 0; i < hit.cols * hit.rows; i++) {
+        hit.cell[i].num = 0;
+    }
+    hit.valid = true;
+
+    /* objects that have been drawn, include hidden objects, they may be shown without redraw */
+    stack[top++] = page;
+    while (top > 0) {
+        SGL_ASSERT(top < SGL_OBJ_DEPTH_MAX);
+        obj = stack[--top];
+
+        if (obj->sibling != NULL) {
+            stack[top++] = obj->sibling;
+        }
+
+        if (obj->child != NULL) {
+            stack[top++] = obj->child;
+        }
+
+        obj->hit_seq = seq ++;
+        if (!sgl_obj_is_invalid(obj)) {
+            hit_grid_set(obj, &obj->area, true);
+        }
+    }
+}
+
+
+/**
+ * @brief update the cells of an object when its area is calculated again
+ * @param obj object, its area and invalid flag are not updated yet
+ * @param area new area of object, NULL if the object is out of its parent
+ * @return none
+ */
+void sgl_event_hit_update(struct sgl_obj *obj, sgl_area_t *area)
+{
+    bool indexed = !sgl_obj_is_invalid(obj);
+
+    if (indexed && area != NULL && !memcmp(&obj->area, area, sizeof(sgl_area_t))) {
+        return;
+    }
+
+    if (indexed) {
+        hit_grid_set(obj, &obj->area, false);
+    }
+
+    if (area != NULL) {
+        hit_grid_set(obj, area, true);
+    }
+}
+
+
+/**
+ * @brief remove an object from hit grid, it is called before the object is freed
+ * @param obj object
+ * @return none
+ */
+void sgl_event_hit_remove(struct sgl_obj *obj)
+{
+    if (!sgl_obj_is_invalid(obj)) {
+        hit_grid_set(obj, &obj->area, false);
+    }
+}
+
+
+/**
+ * @brief sort the objects of every cell in paint order, it is called when the order is changed
+ * @param none
+ * @return none
+ * @note hit_seq of objects is numbered again by the draw list build before it is called
+ */
+void sgl_event_hit_sort(void)
+{
+    sgl_hit_cell_t *cell;
+    struct sgl_obj *obj;
+    int j;
+
+    /* the order of a few objects is changed, insertion sort is fast for it */
+    for (int i = 0; i < hit.cols * hit.rows; i++) {
+        cell = &hit.cell[i];
+
+        for (int k = 1; k < cell->num; k++) {
+            obj = cell->obj[k];
+            for (j = k; j > 0 && cell->obj[j - 1]->hit_seq > obj->hit_seq; j--) {
+                cell->obj[j] = cell->obj[j - 1];
+            }
+            cell->obj[j] = obj;
+        }
+    }
+}
+
+
+/**
+ * @brief check whether the position is focus on the object and all of its parents
+ * @param obj object
+ * @param pos position
+ * @return true if focus, otherwise false
+ * @note this is the rule of object walk, a child is checked only if the position is on its parent
+ */
+static bool hit_obj_is_focus(struct sgl_obj *obj, sgl_event_pos_t *pos)
+{
+    struct sgl_obj *page = sgl_screen_act();
+
+    while (obj != page) {
+        if (sgl_obj_is_hidden(obj) || !pos_is_focus_on_obj(pos, &obj->coords, obj->radius)) {
+            return false;
+        }
+        obj = obj->parent;
+    }
+
+    return !sgl_obj_is_hidden(page);
+}
+#endif // !CONFIG_SGL_EVENT_HIT_GRID
+
+
+/**
+ * @brief find the topmost object at the position by walking all objects
  * @param pos The position to be clicked
- * @return The object that is clicked on, NULL if no object is clicked
+ * @return The topmost object, NULL if no object is at the position
  */
-static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
+static struct sgl_obj* click_walk_object(sgl_event_pos_t *pos)
 {
     struct sgl_obj *stack[SGL_OBJ_DEPTH_MAX], *obj = sgl_screen_act()->child, *find = NULL;
     int top = 0;
@@ -198,6 +664,10 @@ static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
             stack[top++] = obj->sibling;
         }
 
+        if (sgl_obj_is_hidden(obj)) {
+            continue;
+        }
+
         if (pos_is_focus_on_obj(pos, &obj->coords, obj->radius)) {
             find = obj;
             if (sgl_obj_has_child(obj)) {
@@ -206,6 +676,49 @@ static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
         }
     }
 
+    return find;
+}
+
+
+/**
+ * @brief find the topmost object at the position
+ * @param pos The position to be clicked
+ * @return The topmost object, NULL if no object is at the position
+ * @note the page itself is never found
+ */
+static struct sgl_obj* click_topmost_object(sgl_event_pos_t *pos)
+{
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+    if (hit.valid) {
+        sgl_hit_cell_t *cell = hit_cell_at(pos);
+
+        /* the objects that are drawn later are on the top, the page is drawn first */
+        for (int i = (cell != NULL ? cell->num : 0) - 1; i >= 0; i--) {
+            if (cell->obj[i] == sgl_screen_act()) {
+                break;
+            }
+            if (hit_obj_is_focus(cell->obj[i], pos)) {
+                return cell->obj[i];
+            }
+        }
+
+        return NULL;
+    }
+#endif
+
+    return click_walk_object(pos);
+}
+
+
+/**
+ * @brief check whether the position is clicked on the object
+ * @param pos The position to be clicked
+ * @return The object that is clicked on, NULL if no object is clicked
+ */
+static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
+{
+    struct sgl_obj *find = click_topmost_object(pos);
+
     /**
      * if the object is clickable, return it, otherwise return its parent 
      * because the object may be a label attached to the object
@@ -219,11 +732,11 @@ static struct sgl_obj* click_detect_object(sgl_event_pos_t *pos)
 
 
 /**
- * @brief check whether the position is motion on the object
+ * @brief find the first movable object at the position by walking all objects
  * @param pos The position to be motion
  * @return The object that is motion on, NULL if no object is motion
  */
-static struct sgl_obj* motion_detect_object(sgl_event_pos_t *pos)
+static struct sgl_obj* motion_walk_object(sgl_event_pos_t *pos)
 {
     struct sgl_obj *stack[SGL_OBJ_DEPTH_MAX], *obj = NULL;
     int top = 0;
@@ -237,6 +750,10 @@ static struct sgl_obj* motion_detect_object(sgl_event_pos_t *pos)
             stack[top++] = obj->sibling;
         }
 
+        if (sgl_obj_is_hidden(obj)) {
+            continue;
+        }
+
         if (pos_is_focus_on_obj(pos, &obj->coords, obj->radius)) {
             if (sgl_obj_is_movable(obj)) {
                 return obj;
@@ -251,6 +768,32 @@ static struct sgl_obj* motion_detect_object(sgl_event_pos_t *pos)
 }
 
 
+/**
+ * @brief check whether the position is motion on the object
+ * @param pos The position to be motion
+ * @return The object that is motion on, NULL if no object is motion
+ * @note a parent is found before its children, so a movable parent takes the motion
+ */
+static struct sgl_obj* motion_detect_object(sgl_event_pos_t *pos)
+{
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+    if (hit.valid) {
+        sgl_hit_cell_t *cell = hit_cell_at(pos);
+
+        for (int i = 0; cell != NULL && i < cell->num; i++) {
+            if (sgl_obj_is_movable(cell->obj[i]) && hit_obj_is_focus(cell->obj[i], pos)) {
+                return cell->obj[i];
+            }
+        }
+
+        return NULL;
+    }
+#endif
+
+    return motion_walk_object(pos);
+}
+
+
 /**
  * @brief Handle the position event
  * @param pos The position to be handled
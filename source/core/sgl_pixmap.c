@@ -0,0 +1,375 @@
+/* source/core/sgl_pixmap.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl_core.h>
+#include <sgl_mm.h>
+#include <sgl_math.h>
+#include <sgl_log.h>
+#include <sgl_cfgfix.h>
+#include <string.h>
+
+
+#if (CONFIG_SGL_EXTERNAL_PIXMAP && CONFIG_SGL_PIXMAP_CACHE)
+
+#define  SGL_PIXMAP_BLOCK_SIZE             (CONFIG_SGL_PIXMAP_CACHE_BLOCK)
+#define  SGL_PIXMAP_BLOCK_NUM              (CONFIG_SGL_PIXMAP_CACHE / CONFIG_SGL_PIXMAP_CACHE_BLOCK)
+/* number of hash buckets of block cache, it must be power of 2 */
+#define  SGL_PIXMAP_HASH_SIZE              (64)
+
+
+/**
+ * @brief block of external pixmap in cache
+ * @hash_next: next block in the same hash bucket
+ * @prev: previous block in LRU list, the head is the most recently used one
+ * @next: next block in LRU list
+ * @pixmap: pixmap of block, NULL if the block is free
+ * @index: index of block in pixmap, the offset is index * SGL_PIXMAP_BLOCK_SIZE bytes
+ * @data: bytes of block
+ */
+typedef struct sgl_pixmap_block {
+    struct sgl_pixmap_block  *hash_next;
+    struct sgl_pixmap_block  *prev;
+    struct sgl_pixmap_block  *next;
+    const sgl_pixmap_t       *pixmap;
+    uint32_t                 index;
+    uint8_t                  *data;
+} sgl_pixmap_block_t;
+
+
+/**
+ * @brief LRU block cache of external pixmaps, all blocks are allocated in sgl_init()
+ * @hash: hash buckets
+ * @head: the most recently used block
+ * @tail: the least recently used block, free blocks are at the tail
+ * @block: all blocks
+ * @ahead: buffer that blocks are read into
+ * @ahead_num: max number of blocks in one read, it is the size of ahead buffer
+ * @last: pixmap of last read
+ * @next_pos: position that follows last read
+ * @stat: counters of cache
+ */
+static struct {
+    sgl_pixmap_block_t       *hash[SGL_PIXMAP_HASH_SIZE];
+    sgl_pixmap_block_t       *head;
+    sgl_pixmap_block_t       *tail;
+    sgl_pixmap_block_t       block[SGL_PIXMAP_BLOCK_NUM];
+    uint8_t                  *ahead;
+    uint32_t                 ahead_num;
+    const sgl_pixmap_t       *last;
+    uint32_t                 next_pos;
+    sgl_pixmap_cache_stat_t  stat;
+} pixmap_cache;
+
+
+static inline uint32_t pixmap_cache_hash(const sgl_pixmap_t *pixmap, uint32_t index)
+{
+    return (((uint32_t)(uintptr_t)pixmap >> 4) ^ (index * 2654435761u)) & (SGL_PIXMAP_HASH_SIZE - 1);
+}
+
+
+static inline void pixmap_cache_lru_remove(sgl_pixmap_block_t *block)
+{
+    if (block->prev) {
+        block->prev->next = block->next;
+    }
+    else {
+        pixmap_cache.head = block->next;
+    }
+
+    if (block->next) {
+        block->next->prev = block->prev;
+    }
+    else {
+        pixmap_cache.tail = block->prev;
+    }
+}
+
+
+static inline void pixmap_cache_lru_push(sgl_pixmap_block_t *block)
+{
+    block->prev = NULL;
+    block->next = pixmap_cache.head;
+
+    if (pixmap_cache.head) {
+        pixmap_cache.head->prev = block;
+    }
+    else {
+        pixmap_cache.tail = block;
+    }
+
+    pixmap_cache.head = block;
+}
+
+
+static sgl_pixmap_block_t* pixmap_cache_find(const sgl_pixmap_t *pixmap, uint32_t index)
+{
+    sgl_pixmap_block_t *block = pixmap_cache.hash[pixmap_cache_hash(pixmap, index)];
+
+    while (block != NULL && (block->pixmap != pixmap || block->index != index)) {
+        block = block->hash_next;
+    }
+
+    return block;
+}
+
+
+/**
+ * @brief remove a block from its hash bucket, the block becomes free
+ * @param block block that is cached
+ * @return none
+ */
+static void pixmap_cache_unhash(sgl_pixmap_block_t *block)
+{
+    sgl_pixmap_block_t **pp = &pixmap_cache.hash[pixmap_cache_hash(block->pixmap, block->index)];
+
+    while (*pp != block) {
+        pp = &(*pp)->hash_next;
+    }
+
+    *pp = block->hash_next;
+    block->pixmap = NULL;
+}
+
+
+/**
+ * @brief take the least recently used block and cache a block of pixmap in it
+ * @param pixmap pixmap of block
+ * @param index index of block in pixmap
+ * @return block, it is the most recently used one, its data is not read yet
+ */
+static sgl_pixmap_block_t* pixmap_cache_take(const sgl_pixmap_t *pixmap, uint32_t index)
+{
+    sgl_pixmap_block_t *block = pixmap_cache.tail;
+    uint32_t hash = pixmap_cache_hash(pixmap, index);
+
+    if (block->pixmap != NULL) {
+        pixmap_cache_unhash(block);
+    }
+
+    block->pixmap = pixmap;
+    block->index = index;
+    block->hash_next = pixmap_cache.hash[hash];
+    pixmap_cache.hash[hash] = block;
+
+    pixmap_cache_lru_remove(block);
+    pixmap_cache_lru_push(block);
+
+    return block;
+}
+
+
+/**
+ * @brief read blocks in one read and cache them, the first block is the most recently used
+ * @param pixmap pixmap of blocks
+ * @param index index of first block
+ * @param num number of blocks
+ * @return bytes of all blocks
+ */
+static const uint8_t* pixmap_cache_fill(const sgl_pixmap_t *pixmap, uint32_t index, uint32_t num)
+{
+    sgl_pixmap_block_t *block;
+
+    /* whole blocks are read, the last one may be out of pixmap as the rows that are read directly */
+    pixmap->read(pixmap_cache.ahead, SGL_PIXMAP_READ_BASE(pixmap) + index * SGL_PIXMAP_BLOCK_SIZE, num * SGL_PIXMAP_BLOCK_SIZE);
+    pixmap_cache.stat.read_num++;
+    pixmap_cache.stat.read_bytes += num * SGL_PIXMAP_BLOCK_SIZE;
+
+    for (int i = num - 1; i >= 0; i--) {
+        block = pixmap_cache_take(pixmap, index + i);
+        memcpy(block->data, pixmap_cache.ahead + i * SGL_PIXMAP_BLOCK_SIZE, SGL_PIXMAP_BLOCK_SIZE);
+    }
+
+    return pixmap_cache.ahead;
+}
+
+
+/**
+ * @brief copy the bytes of [pos, end) that are in [start, start + len) of pixmap
+ * @param out bytes of [pos, end)
+ * @param src bytes of [start, start + len)
+ * @return none
+ */
+static inline void pixmap_cache_copy(uint8_t *out, uint32_t pos, uint32_t end, const uint8_t *src, uint32_t start, uint32_t len)
+{
+    uint32_t from = sgl_max(pos, start);
+    uint32_t to = sgl_min(end, start + len);
+
+    memcpy(out + (from - pos), src + (from - start), to - from);
+}
+
+
+/**
+ * @brief initialize block cache of external pixmaps
+ * @param none
+ * @return 0 on success, -1 on failure
+ */
+int sgl_pixmap_cache_init(void)
+{
+    uint32_t row = sgl_panel_resolution_width() * sizeof(sgl_color_t);
+    uint32_t ahead = (row * (1 + CONFIG_SGL_PIXMAP_READ_AHEAD) + SGL_PIXMAP_BLOCK_SIZE - 1) / SGL_PIXMAP_BLOCK_SIZE + 1;
+    uint8_t *data = sgl_malloc_tag(SGL_PIXMAP_BLOCK_NUM * SGL_PIXMAP_BLOCK_SIZE, SGL_MM_TAG_IMAGE);
+
+    if (data == NULL) {
+        SGL_LOG_ERROR("sgl pixmap cache memory alloc failed");
+        return -1;
+    }
+
+    /* a read must not evict the blocks that it has read, and a row of panel is read at once */
+    pixmap_cache.ahead_num = sgl_max(sgl_min(ahead, SGL_PIXMAP_BLOCK_NUM / 2), 1);
+    pixmap_cache.ahead = sgl_malloc_tag(pixmap_cache.ahead_num * SGL_PIXMAP_BLOCK_SIZE, SGL_MM_TAG_IMAGE);
+    if (pixmap_cache.ahead == NULL) {
+        SGL_LOG_ERROR("sgl pixmap cache memory alloc failed");
+        sgl_free(data);
+        return -1;
+    }
+
+    for (int i = 0; i < SGL_PIXMAP_BLOCK_NUM; i++) {
+        pixmap_cache.block[i].data = data + i * SGL_PIXMAP_BLOCK_SIZE;
+        pixmap_cache_lru_push(&pixmap_cache.block[i]);
+    }
+
+    return 0;
+}
+
+
+/**
+ * @brief read bytes of external pixmap through block cache, blocks that are not cached are
+ *        read at once, if the bytes follow the last read, such as when whole rows of a pixmap
+ *        are drawn from top to bottom, the next rows are read too
+ * @param pixmap pixmap that has read function
+ * @param pos offset of bytes in pixmap
+ * @param size number of bytes, it is not larger than a row of panel
+ * @param buff buffer that bytes are copied into if they are in more than one block
+ * @return address of bytes, it is valid until next read
+ */
+const uint8_t* sgl_pixmap_cache_read(const sgl_pixmap_t *pixmap, uint32_t pos, size_t size, uint8_t *buff)
+{
+    uint32_t total = pixmap->width * pixmap->height * sizeof(sgl_color_t);
+    uint32_t blocks = (total + SGL_PIXMAP_BLOCK_SIZE - 1) / SGL_PIXMAP_BLOCK_SIZE;
+    uint32_t end = pos + size;
+    uint32_t index = pos / SGL_PIXMAP_BLOCK_SIZE;
+    uint32_t last = (end - 1) / SGL_PIXMAP_BLOCK_SIZE;
+    bool stream = (pixmap == pixmap_cache.last && pos == pixmap_cache.next_pos);
+    sgl_pixmap_block_t *block;
+    const uint8_t *data;
+    uint32_t num, need;
+
+    /* it is not initialized or out of memory, read pixmap directly */
+    if (pixmap_cache.ahead == NULL) {
+        pixmap->read(buff, SGL_PIXMAP_READ_BASE(pixmap) + pos, size);
+        return buff;
+    }
+
+    pixmap_cache.last = pixmap;
+    pixmap_cache.next_pos = end;
+
+    while (index <= last) {
+        block = pixmap_cache_find(pixmap, index);
+
+        if (block != NULL) {
+            if (block != pixmap_cache.head) {
+                pixmap_cache_lru_remove(block);
+                pixmap_cache_lru_push(block);
+            }
+            pixmap_cache.stat.hit++;
+            data = block->data;
+            num = need = 1;
+        }
+        else {
+            /* blocks that are not cached one after another are read at once */
+            num = 1;
+            while (index + num <= last && num < pixmap_cache.ahead_num && pixmap_cache_find(pixmap, index + num) == NULL) {
+                num++;
+            }
+            need = num;
+
+            /* the next rows are read ahead if the rows are read one after another */
+            if (stream && index + num > last) {
+                while (num < pixmap_cache.ahead_num && index + num < blocks && pixmap_cache_find(pixmap, index + num) == NULL) {
+                    num++;
+                }
+            }
+
+            pixmap_cache.stat.miss += need;
+            pixmap_cache.stat.prefetch += num - need;
+            data = pixmap_cache_fill(pixmap, index, num);
+        }
+
+        /* the bytes are in one block, it is the most recently used one */
+        if (pos / SGL_PIXMAP_BLOCK_SIZE == last) {
+            return pixmap_cache.head->data + pos % SGL_PIXMAP_BLOCK_SIZE;
+        }
+
+        pixmap_cache_copy(buff, pos, end, data, index * SGL_PIXMAP_BLOCK_SIZE, need * SGL_PIXMAP_BLOCK_SIZE);
+        index += need;
+    }
+
+    return buff;
+}
+
+
+/**
+ * @brief drop cached blocks of pixmap
+ * @param pixmap pixmap whose blocks are dropped, NULL to drop all blocks
+ * @return none
+ * @note call it if the content of external pixmap is changed or the pixmap is freed
+ */
+void sgl_pixmap_cache_clear(const sgl_pixmap_t *pixmap)
+{
+    for (int i = 0; i < SGL_PIXMAP_BLOCK_NUM; i++) {
+        sgl_pixmap_block_t *block = &pixmap_cache.block[i];
+
+        if (block->pixmap == NULL || (pixmap != NULL && block->pixmap != pixmap)) {
+            continue;
+        }
+
+        /* free blocks are used first */
+        pixmap_cache_unhash(block);
+        pixmap_cache_lru_remove(block);
+        block->next = NULL;
+        block->prev = pixmap_cache.tail;
+        if (pixmap_cache.tail) {
+            pixmap_cache.tail->next = block;
+        }
+        else {
+            pixmap_cache.head = block;
+        }
+        pixmap_cache.tail = block;
+    }
+
+    pixmap_cache.last = NULL;
+}
+
+
+/**
+ * @brief get counters of block cache of external pixmaps
+ * @param stat [out] counters of cache
+ * @return none
+ */
+void sgl_pixmap_cache_get_stat(sgl_pixmap_cache_stat_t *stat)
+{
+    *stat = pixmap_cache.stat;
+}
+
+#endif // !CONFIG_SGL_EXTERNAL_PIXMAP && CONFIG_SGL_PIXMAP_CACHE
@@ -0,0 +1,223 @@
+/* source/core/sgl_profiler.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl_core.h>
+#include <sgl_math.h>
+#include <sgl_profiler.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+
+#if (CONFIG_SGL_PROFILER)
+
+static uint32_t (*profiler_clock)(void) = NULL;
+static sgl_profiler_frame_t profiler_cur;
+static sgl_profiler_frame_t profiler_last;
+static uint32_t profiler_frame_seq = 0;
+static uint32_t profiler_frame_start;
+static uint32_t profiler_calc_start;
+
+
+/**
+ * @brief get current microsecond of profiler clock
+ * @param none
+ * @return microsecond, 0 if no clock is registered
+ */
+static inline uint32_t profiler_now(void)
+{
+    return profiler_clock ? profiler_clock() : 0;
+}
+
+
+void sgl_profiler_clock_register(uint32_t (*clock_us)(void))
+{
+    profiler_clock = clock_us;
+}
+
+
+const sgl_profiler_frame_t* sgl_profiler_get_frame(void)
+{
+    return &profiler_last;
+}
+
+
+/**
+ * @brief start a new frame, it is called at the beginning of sgl_task_handle()
+ * @param none
+ * @return none
+ */
+void sgl_profiler_frame_begin(void)
+{
+    memset(&profiler_cur, 0, sizeof(sgl_profiler_frame_t));
+    profiler_frame_start = profiler_now();
+}
+
+
+/**
+ * @brief finish current frame, only the frame that draws something is published
+ * @param drawn true if something is drawn in current frame
+ * @return none
+ */
+void sgl_profiler_frame_end(bool drawn)
+{
+    if (!drawn) {
+        return;
+    }
+
+    profiler_cur.total_us = profiler_now() - profiler_frame_start;
+    profiler_cur.frame = ++profiler_frame_seq;
+    memcpy(&profiler_last, &profiler_cur, sizeof(sgl_profiler_frame_t));
+}
+
+
+void sgl_profiler_calc_begin(void)
+{
+    profiler_calc_start = profiler_now();
+}
+
+
+void sgl_profiler_calc_end(void)
+{
+    profiler_cur.calc_us += profiler_now() - profiler_calc_start;
+}
+
+
+void sgl_profiler_dirty(const sgl_area_t *dirty)
+{
+    if (profiler_cur.dirty_cnt < CONFIG_SGL_PROFILER_DIRTY_MAX) {
+        profiler_cur.dirty[profiler_cur.dirty_cnt] = *dirty;
+    }
+    profiler_cur.dirty_cnt ++;
+}
+
+
+uint32_t sgl_profiler_obj_begin(void)
+{
+    return profiler_now();
+}
+
+
+void sgl_profiler_obj_end(const sgl_obj_t *obj, uint32_t start)
+{
+    uint32_t elapsed = profiler_now() - start;
+    sgl_profiler_obj_t *item = NULL;
+
+    profiler_cur.draw_us += elapsed;
+
+    for (int i = 0; i < profiler_cur.obj_cnt; i++) {
+        if (profiler_cur.obj[i].obj == obj) {
+            item = &profiler_cur.obj[i];
+            break;
+        }
+    }
+
+    if (item == NULL) {
+        if (profiler_cur.obj_cnt >= CONFIG_SGL_PROFILER_OBJ_MAX) {
+            return;
+        }
+        item = &profiler_cur.obj[profiler_cur.obj_cnt++];
+        item->obj = obj;
+#if (CONFIG_SGL_OBJ_USE_NAME)
+        item->name = obj->name;
+#endif
+    }
+
+    item->draw_cnt ++;
+    item->time_us += elapsed;
+}
+
+
+uint32_t sgl_profiler_flush_begin(void)
+{
+    return profiler_now();
+}
+
+
+void sgl_profiler_flush_end(uint32_t start, int16_t w, int16_t h)
+{
+    profiler_cur.flush_us += profiler_now() - start;
+    profiler_cur.flush_bytes += (uint32_t)w * h * sizeof(sgl_color_t);
+    profiler_cur.slice_cnt ++;
+}
+
+
+/**
+ * @brief print a line by log device
+ * @param format print format
+ * @return none
+ */
+static void profiler_print(const char *format, ...)
+{
+    char buffer[128];
+    int  len;
+
+    va_list va;
+    va_start(va, format);
+    len = vsnprintf(buffer, sizeof(buffer) - 2, format, va);
+    va_end(va);
+
+    if (len < 0) {
+        return;
+    }
+
+    len = sgl_min(len, (int)sizeof(buffer) - 3);
+    buffer[len++] = '\r';
+    buffer[len++] = '\n';
+    buffer[len] = 0;
+
+    sgl_log_stdout(buffer);
+}
+
+
+void sgl_profiler_dump(void)
+{
+    const sgl_profiler_frame_t *f = &profiler_last;
+
+    profiler_print("[PROFILER] frame %lu: total %lu us, calc %lu us, draw %lu us, flush %lu us",
+                   (unsigned long)f->frame, (unsigned long)f->total_us, (unsigned long)f->calc_us,
+                   (unsigned long)f->draw_us, (unsigned long)f->flush_us);
+    profiler_print("[PROFILER] slices %u, flush bytes %lu, dirty areas %u",
+                   f->slice_cnt, (unsigned long)f->flush_bytes, f->dirty_cnt);
+
+    for (int i = 0; i < sgl_min(f->dirty_cnt, CONFIG_SGL_PROFILER_DIRTY_MAX); i++) {
+        profiler_print("[PROFILER]   dirty %d: (%d, %d) - (%d, %d)", i,
+                       f->dirty[i].x1, f->dirty[i].y1, f->dirty[i].x2, f->dirty[i].y2);
+    }
+
+    for (int i = 0; i < f->obj_cnt; i++) {
+        const sgl_profiler_obj_t *item = &f->obj[i];
+#if (CONFIG_SGL_OBJ_USE_NAME)
+        if (item->name) {
+            profiler_print("[PROFILER]   obj %s: %lu us, %lu draws", item->name,
+                           (unsigned long)item->time_us, (unsigned long)item->draw_cnt);
+            continue;
+        }
+#endif
+        profiler_print("[PROFILER]   obj %p: %lu us, %lu draws", (const void *)item->obj,
+                       (unsigned long)item->time_us, (unsigned long)item->draw_cnt);
+    }
+}
+
+#endif // !CONFIG_SGL_PROFILER
@@ -0,0 +1,203 @@
+/* source/core/sgl_slab.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl_core.h>
+#include <sgl_mm.h>
+#include <sgl_log.h>
+#include <sgl_cfgfix.h>
+#include <string.h>
+
+
+#if (CONFIG_SGL_SLAB_SIZE)
+
+/* the slab memory is split into pages, a page is given to one class when it has no free chunk */
+#define  SGL_SLAB_PAGE_SIZE            (1024)
+#define  SGL_SLAB_PAGE_NUM             (CONFIG_SGL_SLAB_SIZE / SGL_SLAB_PAGE_SIZE)
+/* the sizes of all widgets are less than it, larger chunks waste too much of a page */
+#define  SGL_SLAB_CHUNK_MAX            (SGL_SLAB_PAGE_SIZE / 2)
+#define  SGL_SLAB_CLASS_MAX            (16)
+#define  SGL_SLAB_ALIGN                (8)
+
+#if (SGL_SLAB_PAGE_NUM == 0 || SGL_SLAB_PAGE_NUM > 65535)
+#error "CONFIG_SGL_SLAB_SIZE should be between 1024 and 64M"
+#endif
+
+
+/**
+ * @brief slab class, the free chunks are linked by the pointer that is stored in each chunk
+ * @free: first free chunk
+ * @size: size of chunk
+ * @page_num: number of pages of class
+ * @used: number of chunks in use
+ * @peak: the most chunks in use
+ * @fallback: number of allocations that are taken from heap
+ */
+typedef struct sgl_slab_class {
+    void               *free;
+    uint16_t           size;
+    uint16_t           page_num;
+    uint32_t           used;
+    uint32_t           peak;
+    uint32_t           fallback;
+} sgl_slab_class_t;
+
+
+static uint64_t sgl_slab_mem[SGL_SLAB_PAGE_NUM * SGL_SLAB_PAGE_SIZE / sizeof(uint64_t)];
+static uint8_t sgl_slab_page_class[SGL_SLAB_PAGE_NUM];
+static uint16_t sgl_slab_page_used = 0;
+static sgl_slab_class_t sgl_slab_class[SGL_SLAB_CLASS_MAX];
+static uint8_t sgl_slab_class_num = 0;
+
+
+/**
+ * @brief find the class of chunk size, create it if not found
+ * @param size size of chunk, it is aligned
+ * @return class, NULL if there are too many sizes
+ */
+static sgl_slab_class_t* sgl_slab_class_get(size_t size)
+{
+    sgl_slab_class_t *cls;
+
+    for (int i = 0; i < sgl_slab_class_num; i++) {
+        if (sgl_slab_class[i].size == size) {
+            return &sgl_slab_class[i];
+        }
+    }
+
+    if (sgl_slab_class_num == SGL_SLAB_CLASS_MAX) {
+        return NULL;
+    }
+
+    cls = &sgl_slab_class[sgl_slab_class_num ++];
+    memset(cls, 0, sizeof(sgl_slab_class_t));
+    cls->size = size;
+
+    return cls;
+}
+
+
+/**
+ * @brief give a free page to class and link all chunks of it
+ * @param cls slab class
+ * @return 0 if success, -1 if there is no free page
+ */
+static int sgl_slab_class_grow(sgl_slab_class_t *cls)
+{
+    uint8_t *page, *chunk;
+    size_t num = SGL_SLAB_PAGE_SIZE / cls->size;
+
+    if (sgl_slab_page_used == SGL_SLAB_PAGE_NUM) {
+        return -1;
+    }
+
+    sgl_slab_page_class[sgl_slab_page_used] = (uint8_t)(cls - sgl_slab_class);
+    page = (uint8_t*)sgl_slab_mem + sgl_slab_page_used * SGL_SLAB_PAGE_SIZE;
+    sgl_slab_page_used ++;
+    cls->page_num ++;
+
+    /* link chunks from the last one, so the first chunk of page is used first */
+    for (size_t i = num; i > 0; i--) {
+        chunk = page + (i - 1) * cls->size;
+        *(void**)chunk = cls->free;
+        cls->free = chunk;
+    }
+
+    return 0;
+}
+
+
+void* sgl_slab_alloc(size_t size, sgl_mm_tag_t tag)
+{
+    sgl_slab_class_t *cls;
+    void *chunk;
+
+    /* every chunk keeps the link of free list */
+    size = (size + SGL_SLAB_ALIGN - 1) & ~(size_t)(SGL_SLAB_ALIGN - 1);
+    if (size == 0) {
+        size = SGL_SLAB_ALIGN;
+    }
+    else if (size > SGL_SLAB_CHUNK_MAX) {
+        return sgl_malloc_tag(size, tag);
+    }
+
+    cls = sgl_slab_class_get(size);
+    if (cls == NULL) {
+        SGL_LOG_WARN("sgl_slab_alloc: too many sizes, %d bytes are taken from heap", (int)size);
+        return sgl_malloc_tag(size, tag);
+    }
+
+    if (cls->free == NULL && sgl_slab_class_grow(cls)) {
+        cls->fallback ++;
+        return sgl_malloc_tag(size, tag);
+    }
+
+    chunk = cls->free;
+    cls->free = *(void**)chunk;
+    cls->used ++;
+    if (cls->used > cls->peak) {
+        cls->peak = cls->used;
+    }
+
+    return chunk;
+}
+
+
+void sgl_slab_free(void *p)
+{
+    sgl_slab_class_t *cls;
+    size_t offset = (uint8_t*)p - (uint8_t*)sgl_slab_mem;
+
+    /* the chunks that are taken from heap are out of slab memory */
+    if ((uint8_t*)p < (uint8_t*)sgl_slab_mem || offset >= sizeof(sgl_slab_mem)) {
+        sgl_free(p);
+        return;
+    }
+
+    cls = &sgl_slab_class[sgl_slab_page_class[offset / SGL_SLAB_PAGE_SIZE]];
+    *(void**)p = cls->free;
+    cls->free = p;
+    cls->used --;
+}
+
+
+int sgl_slab_get_monitor(int index, sgl_slab_monitor_t *mon)
+{
+    sgl_slab_class_t *cls;
+
+    if (index < 0 || index >= sgl_slab_class_num || mon == NULL) {
+        return -1;
+    }
+
+    cls = &sgl_slab_class[index];
+    mon->size = cls->size;
+    mon->page_num = cls->page_num;
+    mon->total = cls->page_num * (SGL_SLAB_PAGE_SIZE / cls->size);
+    mon->used = cls->used;
+    mon->peak = cls->peak;
+    mon->fallback = cls->fallback;
+
+    return 0;
+}
+
+#endif // !CONFIG_SGL_SLAB_SIZE
@@ -23,6 +23,7 @@
  */
 
 #include <sgl_core.h>
+#include <sgl_log.h>
 #include <sgl_draw.h>
 #include <sgl_math.h>
 
@@ -105,6 +106,12 @@ void sgl_draw_fill_circle_pixmap(sgl_surf_t *surf, sgl_area_t *area, int16_t cx,
     sgl_area_t clip = SGL_AREA_MAX;
     uint8_t edge_alpha = 0;
 
+    /* a compressed pixmap is only drawn by sgl_draw_fill_rect_pixmap() */
+    if (pixmap->format != SGL_PIXMAP_FORMAT_RAW) {
+        SGL_LOG_WARN("only raw pixmap can be drawn with radius");
+        return;
+    }
+
     sgl_surf_clip_area_return(surf, area, &clip);
 
     sgl_area_t c_rect = {
@@ -28,6 +28,12 @@
 #include <sgl_math.h>
 
 
+/**
+ * @brief pixels of an icon row that are decoded and blended at once
+ */
+#define  SGL_ICON_MASK_CHUNK               (32)
+
+
 /**
  * @brief draw icon with alpha
  * @param surf   surface
@@ -62,19 +68,28 @@ void sgl_draw_icon( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sg
     }
 
     if (icon->bpp == 4) {
+        uint8_t mask[SGL_ICON_MASK_CHUNK];
+        int16_t len;
+
         for (int y = clip.y1; y <= clip.y2; y++) {
             buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
             rel_y = y - icon_rect.y1;
 
-            for (int x = clip.x1; x <= clip.x2; x++) {
-                rel_x = x - icon_rect.x1;
+            /* decode coverage of a chunk of pixels and blend them as one span */
+            for (int x = clip.x1; x <= clip.x2; x += len) {
+                len = sgl_min(clip.x2 - x + 1, SGL_ICON_MASK_CHUNK);
 
-                byte_x = rel_x >> 1;
-                dot_index = byte_x + (rel_y * (icon->width >> 1));
-                alpha_dot = (rel_x & 1) ? dot[dot_index] & 0xF : (dot[dot_index] >> 4);
-                alpha_dot = alpha_dot | (alpha_dot << 4);
-                *buf = (alpha == SGL_ALPHA_MAX ? sgl_color_mixer(color, *buf, alpha_dot) : sgl_color_mixer(sgl_color_mixer(color, *buf, alpha_dot), *buf, alpha));
-                buf++;
+                for (int i = 0; i < len; i++) {
+                    rel_x = x + i - icon_rect.x1;
+
+                    byte_x = rel_x >> 1;
+                    dot_index = byte_x + (rel_y * (icon->width >> 1));
+                    alpha_dot = (rel_x & 1) ? dot[dot_index] & 0xF : (dot[dot_index] >> 4);
+                    mask[i] = alpha_dot | (alpha_dot << 4);
+                }
+
+                sgl_draw_blend_span_mask(buf, len, color, mask, alpha);
+                buf += len;
             }
         }
     }
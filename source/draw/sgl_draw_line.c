@@ -94,7 +94,7 @@ void sgl_draw_fill_vline(sgl_surf_t *surf, int16_t x, int16_t y1, int16_t y2, in
         for (int x = clip.x1; x <= clip.x2; x++, buf++) {
             *buf = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *buf, alpha));
         }
-        buf += surf->w;
+        buf += surf->pitch;
     }
 }
 
@@ -0,0 +1,268 @@
+/* source/draw/sgl_draw_qoi.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl_core.h>
+#include <sgl_log.h>
+#include <sgl_draw.h>
+#include <sgl_math.h>
+#include <string.h>
+
+
+#if (CONFIG_SGL_PIXMAP_QOI)
+
+#define  SGL_QOI_OP_INDEX                  (0x00)
+#define  SGL_QOI_OP_DIFF                   (0x40)
+#define  SGL_QOI_OP_LUMA                   (0x80)
+#define  SGL_QOI_OP_RUN                    (0xc0)
+#define  SGL_QOI_OP_RGB                    (0xfe)
+#define  SGL_QOI_OP_RGBA                   (0xff)
+#define  SGL_QOI_MASK                      (0xc0)
+
+#define  SGL_QOI_HASH(px)                  (((px).r * 3 + (px).g * 5 + (px).b * 7 + (px).a * 11) & 63)
+
+
+/**
+ * @brief a RGBA pixel of QOI stream
+ */
+typedef struct sgl_qoi_rgba {
+    uint8_t r, g, b, a;
+} sgl_qoi_rgba_t;
+
+
+/**
+ * @brief QOI decoder, its state is reset at the start of every chunk
+ * @data: start of QOI pixmap
+ * @p: next op
+ * @row: row of pixmap that is decoded next
+ * @run: pixels of px that are not taken yet
+ * @px: current pixel
+ * @index: previously seen pixels
+ */
+typedef struct sgl_qoi_dec {
+    const uint8_t  *data;
+    const uint8_t  *p;
+    int16_t        row;
+    uint8_t        run;
+    sgl_qoi_rgba_t px;
+    sgl_qoi_rgba_t index[64];
+} sgl_qoi_dec_t;
+
+
+#if (CONFIG_SGL_DRAW_THREADS == 1)
+/* decoder of last drawn rows, the slices that follow it go on without seeking */
+static struct {
+    const sgl_pixmap_t *pixmap;
+    sgl_qoi_dec_t      dec;
+} qoi_last;
+#endif
+
+
+static inline uint32_t sgl_qoi_u32(const uint8_t *p)
+{
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+
+/**
+ * @brief reset decoder to the start of the chunk of a row
+ * @param dec decoder
+ * @param row first row of a chunk
+ */
+static void sgl_qoi_dec_chunk(sgl_qoi_dec_t *dec, int16_t row)
+{
+    uint8_t shift = dec->data[SGL_QOI_HEADER_SHIFT];
+
+    dec->p = dec->data + sgl_qoi_u32(dec->data + SGL_QOI_HEADER_SIZE + (row >> shift) * 4);
+    dec->row = row;
+    dec->run = 0;
+    dec->px.r = dec->px.g = dec->px.b = 0;
+    dec->px.a = 255;
+    memset(dec->index, 0, sizeof(dec->index));
+}
+
+
+/**
+ * @brief decode next op, the pixel is px and it is repeated run times
+ * @param dec decoder
+ */
+static inline void sgl_qoi_dec_op(sgl_qoi_dec_t *dec)
+{
+    const uint8_t *p = dec->p;
+    uint8_t b1 = *p++;
+
+    dec->run = 1;
+
+    if (b1 == SGL_QOI_OP_RGB) {
+        dec->px.r = p[0];
+        dec->px.g = p[1];
+        dec->px.b = p[2];
+        p += 3;
+    }
+    else if (b1 == SGL_QOI_OP_RGBA) {
+        dec->px.r = p[0];
+        dec->px.g = p[1];
+        dec->px.b = p[2];
+        dec->px.a = p[3];
+        p += 4;
+    }
+    else if ((b1 & SGL_QOI_MASK) == SGL_QOI_OP_INDEX) {
+        dec->px = dec->index[b1];
+    }
+    else if ((b1 & SGL_QOI_MASK) == SGL_QOI_OP_DIFF) {
+        dec->px.r += ((b1 >> 4) & 0x03) - 2;
+        dec->px.g += ((b1 >> 2) & 0x03) - 2;
+        dec->px.b += (b1 & 0x03) - 2;
+    }
+    else if ((b1 & SGL_QOI_MASK) == SGL_QOI_OP_LUMA) {
+        int vg = (b1 & 0x3f) - 32;
+        uint8_t b2 = *p++;
+        dec->px.r += vg - 8 + ((b2 >> 4) & 0x0f);
+        dec->px.g += vg;
+        dec->px.b += vg - 8 + (b2 & 0x0f);
+    }
+    else {
+        /* the pixel is in index already */
+        dec->run = (b1 & 0x3f) + 1;
+        dec->p = p;
+        return;
+    }
+
+    dec->index[SGL_QOI_HASH(dec->px)] = dec->px;
+    dec->p = p;
+}
+
+
+/**
+ * @brief decode a row of pixmap and blend the pixels between x1 and x2, a run of pixels
+ *        is blended as a span
+ * @param dec decoder, it is at the start of row
+ * @param width width of pixmap
+ * @param buf buffer of pixel x1 of row, NULL to skip the row
+ * @param x1 first pixel to blend
+ * @param x2 last pixel to blend
+ * @param alpha alpha of pixmap
+ */
+static void sgl_qoi_dec_row(sgl_qoi_dec_t *dec, int16_t width, sgl_color_t *buf, int16_t x1, int16_t x2, uint8_t alpha)
+{
+    int16_t x = 0, take, s, e;
+    sgl_color_t color;
+    uint8_t a;
+
+    if ((dec->row & ((1 << dec->data[SGL_QOI_HEADER_SHIFT]) - 1)) == 0) {
+        sgl_qoi_dec_chunk(dec, dec->row);
+    }
+
+    while (x < width) {
+        if (dec->run == 0) {
+            sgl_qoi_dec_op(dec);
+        }
+
+        take = sgl_min(dec->run, width - x);
+        s = sgl_max(x, x1);
+        e = sgl_min(x + take - 1, x2);
+
+        if (buf != NULL && s <= e && dec->px.a != 0) {
+            color = sgl_rgb2color(dec->px.r, dec->px.g, dec->px.b);
+            a = dec->px.a == 255 ? alpha : (uint8_t)(dec->px.a * alpha / 255);
+
+            if (s == e && a == SGL_ALPHA_MAX) {
+                buf[s - x1] = color;
+            }
+            else {
+                sgl_draw_blend_span(buf + (s - x1), e - s + 1, color, a);
+            }
+        }
+
+        dec->run -= take;
+        x += take;
+    }
+
+    dec->row++;
+}
+
+
+/**
+ * @brief fill the clip of surface with a QOI pixmap, the pixels out of pixmap are not drawn
+ * @param surf surface
+ * @param clip area of surface to fill
+ * @param ox x coordinate of pixmap
+ * @param oy y coordinate of pixmap
+ * @param pixmap pixmap of SGL_PIXMAP_FORMAT_QOI
+ * @param alpha alpha of pixmap
+ * @return none
+ */
+void sgl_draw_fill_rect_qoi(sgl_surf_t *surf, sgl_area_t *clip, int16_t ox, int16_t oy, const sgl_pixmap_t *pixmap, uint8_t alpha)
+{
+    const uint8_t *data = pixmap->bitmap;
+    int16_t y1 = sgl_max(clip->y1, oy), y2 = sgl_min(clip->y2, oy + (int16_t)pixmap->height - 1);
+    int16_t x1 = sgl_max(clip->x1, ox) - ox, x2 = sgl_min(clip->x2, ox + (int16_t)pixmap->width - 1) - ox;
+    sgl_qoi_dec_t *dec;
+    uint8_t shift;
+
+#if (CONFIG_SGL_EXTERNAL_PIXMAP)
+    if (pixmap->read != NULL) {
+        SGL_LOG_ERROR("QOI pixmap must be in memory");
+        return;
+    }
+#endif
+
+    if (sgl_qoi_u32(data) != SGL_QOI_MAGIC || (data[4] | (data[5] << 8)) != pixmap->width
+        || (data[6] | (data[7] << 8)) != pixmap->height) {
+        SGL_LOG_ERROR("bad QOI pixmap");
+        return;
+    }
+
+    if (y1 > y2 || x1 > x2) {
+        return;
+    }
+
+    shift = data[SGL_QOI_HEADER_SHIFT];
+
+#if (CONFIG_SGL_DRAW_THREADS == 1)
+    dec = &qoi_last.dec;
+    /* go on from last row if it is in the same chunk, otherwise seek the chunk */
+    if (qoi_last.pixmap != pixmap || dec->data != data || dec->row > y1 - oy
+        || ((y1 - oy) >> shift) != (dec->row >> shift)) {
+        qoi_last.pixmap = pixmap;
+        dec->data = data;
+        sgl_qoi_dec_chunk(dec, ((y1 - oy) >> shift) << shift);
+    }
+#else
+    sgl_qoi_dec_t local;
+    dec = &local;
+    dec->data = data;
+    sgl_qoi_dec_chunk(dec, ((y1 - oy) >> shift) << shift);
+#endif
+
+    while (dec->row < y1 - oy) {
+        sgl_qoi_dec_row(dec, pixmap->width, NULL, 0, -1, alpha);
+    }
+
+    for (int16_t y = y1; y <= y2; y++) {
+        sgl_color_t *buf = sgl_surf_get_buf(surf, ox + x1 - surf->x, y - surf->y);
+        sgl_qoi_dec_row(dec, pixmap->width, buf, x1, x2, alpha);
+    }
+}
+
+#endif // !CONFIG_SGL_PIXMAP_QOI
@@ -24,8 +24,10 @@
 
 
 #include <sgl_core.h>
+#include <sgl_log.h>
 #include <sgl_draw.h>
 #include <sgl_math.h>
+#include <string.h>
 
 
 /**
@@ -50,12 +52,18 @@ void sgl_draw_fill_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *rect, sg
         return;
     }
 
+    int16_t len = clip.x2 - clip.x1 + 1;
+
+    /* the whole rows of surface are continuous, fill them as one span */
+    if (len == surf->w && surf->pitch == surf->w && alpha == SGL_ALPHA_MAX) {
+        buf = sgl_surf_get_buf(surf, 0, clip.y1 - surf->y);
+        sgl_draw_fill_span(buf, (int32_t)len * (clip.y2 - clip.y1 + 1), color);
+        return;
+    }
+
     for (int y = clip.y1; y <= clip.y2; y++) {
         buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
-
-        for (int x = clip.x1; x <= clip.x2; x++, buf++) {
-            *buf = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *buf, alpha);
-        }
+        sgl_draw_blend_span(buf, len, color, alpha);
     }
 }
 
@@ -88,17 +96,23 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
         return;
     }
 
+    /* body columns of a row, the left and right border are outside of them */
+    int16_t body_x1 = sgl_max(b_x1 + 1, clip.x1);
+    int16_t body_x2 = sgl_min(b_x2 - 1, clip.x2);
+
     for (int y = clip.y1; y <= clip.y2; y++) {
         buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
 
-        for (int x = clip.x1; x <= clip.x2; x++, buf++) {
-            if (x > b_x1 && x < b_x2 && y > b_y1 && y < b_y2) {
-                *buf = alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *buf, alpha);
-            }
-            else {
-                *buf = alpha == SGL_ALPHA_MAX ? border_color : sgl_color_mixer(border_color, *buf, alpha);
-            }
+        /* top and bottom border or no body in this row */
+        if (y <= b_y1 || y >= b_y2 || body_x1 > body_x2) {
+            sgl_draw_blend_span(buf, clip.x2 - clip.x1 + 1, border_color, alpha);
+            continue;
         }
+
+        /* left border, body, right border */
+        sgl_draw_blend_span(buf, body_x1 - clip.x1, border_color, alpha);
+        sgl_draw_blend_span(buf + (body_x1 - clip.x1), body_x2 - body_x1 + 1, color, alpha);
+        sgl_draw_blend_span(buf + (body_x2 - clip.x1 + 1), clip.x2 - body_x2, border_color, alpha);
     }
 }
 
@@ -131,12 +145,24 @@ void sgl_draw_fill_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_rect_t *r
     int pick_cx = pixmap->width / 2;
     int pick_cy = pixmap->height / 2;
 
+#if (CONFIG_SGL_PIXMAP_QOI)
+    if (pixmap->format == SGL_PIXMAP_FORMAT_QOI) {
+        sgl_draw_fill_rect_qoi(surf, &clip, cx - pick_cx, cy - pick_cy, pixmap, alpha);
+        return;
+    }
+#endif
+
     for (int y = clip.y1; y <= clip.y2; y++) {
         buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
         pbuf = sgl_pixmap_get_buf(pixmap, pick_cx - (cx - clip.x1), pick_cy - (cy - y), clip.x2 - clip.x1 + 1);
 
+        if (alpha == SGL_ALPHA_MAX) {
+            memcpy(buf, pbuf, (clip.x2 - clip.x1 + 1) * sizeof(sgl_color_t));
+            continue;
+        }
+
         for (int x = clip.x1; x <= clip.x2; x++, buf++) {
-            *buf = (alpha == SGL_ALPHA_MAX ? *pbuf : sgl_color_mixer(*pbuf, *buf, alpha));
+            *buf = sgl_color_mixer(*pbuf, *buf, alpha);
             pbuf ++;
         }
     }
@@ -181,9 +207,7 @@ void sgl_draw_fill_round_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *re
         buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
 
         if (y > cy1 && y < cy2) {
-            for (int x = clip.x1; x <= clip.x2; x++, buf++) {
-                *buf = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *buf, alpha));
-            }
+            sgl_draw_blend_span(buf, clip.x2 - clip.x1 + 1, color, alpha);
         }
         else {
             cy_tmp = y > cy1 ? cy2 : cy1;
@@ -191,7 +215,11 @@ void sgl_draw_fill_round_rect(sgl_surf_t *surf, sgl_area_t *area, sgl_area_t *re
 
             for (int x = clip.x1; x <= clip.x2; x++, buf++) {
                 if (x > cx1 && x < cx2) {
-                    *buf = (alpha == SGL_ALPHA_MAX ? color : sgl_color_mixer(color, *buf, alpha));
+                    /* straight part between two corners */
+                    int16_t end = sgl_min(cx2 - 1, clip.x2);
+                    sgl_draw_blend_span(buf, end - x + 1, color, alpha);
+                    buf += end - x;
+                    x = end;
                 }
                 else {
                     cx_tmp = x > cx1 ? cx2 : cx1;
@@ -262,14 +290,18 @@ void sgl_draw_fill_round_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sg
         buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
 
         if (y > cy1 && y < cy2) {
-            for (int x = clip.x1; x <= clip.x2; x++, buf++) {
-                if (x < cx1i || x > cx2i) {
-                    *buf = sgl_color_mixer(border_color, *buf, alpha);
-                }
-                else {
-                    *buf = sgl_color_mixer(color, *buf, alpha);
-                }
+            /* left border, body, right border */
+            int16_t body_x1 = sgl_max(cx1i, clip.x1);
+            int16_t body_x2 = sgl_min(cx2i, clip.x2);
+
+            if (body_x1 > body_x2) {
+                sgl_draw_blend_span(buf, clip.x2 - clip.x1 + 1, border_color, alpha);
+                continue;
             }
+
+            sgl_draw_blend_span(buf, body_x1 - clip.x1, border_color, alpha);
+            sgl_draw_blend_span(buf + (body_x1 - clip.x1), body_x2 - body_x1 + 1, color, alpha);
+            sgl_draw_blend_span(buf + (body_x2 - clip.x1 + 1), clip.x2 - body_x2, border_color, alpha);
         }
         else {
             cy_tmp = y > cy1 ? cy2 : cy1;
@@ -340,6 +372,12 @@ void sgl_draw_fill_round_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_are
     int pick_cx = pixmap->width / 2;
     int pick_cy = pixmap->height / 2;
 
+    /* a compressed pixmap is only drawn by sgl_draw_fill_rect_pixmap() */
+    if (pixmap->format != SGL_PIXMAP_FORMAT_RAW) {
+        SGL_LOG_WARN("only raw pixmap can be drawn with radius");
+        return;
+    }
+
     if (!sgl_surf_clip(surf, area, &clip)) {
         return;
     }
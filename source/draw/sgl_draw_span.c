@@ -0,0 +1,313 @@
+/* source/draw/sgl_draw_span.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <sgl_core.h>
+#include <sgl_draw.h>
+#include <string.h>
+
+
+#if (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB565 || CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_ARGB8888)
+/* the machine word is used to store several pixels at once */
+#define  SGL_SPAN_WORD_PIXELS              (sizeof(uintptr_t) / sizeof(sgl_color_t))
+#if (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB565)
+#define  SGL_SPAN_WORD_REPEAT              (UINTPTR_MAX / 0xFFFFu)
+#else
+#define  SGL_SPAN_WORD_REPEAT              (UINTPTR_MAX / 0xFFFFFFFFu)
+#endif
+#endif
+
+
+/**
+ * @brief fill a span of pixels with a color
+ * @param dst start of span
+ * @param len number of pixels
+ * @param color color of span
+ * @return none
+ * @note the destination is aligned to machine word by single pixels first, then the span is
+ *       filled by word wide stores, each store writes several pixels
+ */
+void sgl_draw_fill_span(sgl_color_t *dst, int32_t len, sgl_color_t color)
+{
+#if (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB233)
+    if (len > 0) {
+        memset(dst, color.full, len);
+    }
+#elif (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB565 || CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_ARGB8888)
+    const uintptr_t pattern = (uintptr_t)color.full * SGL_SPAN_WORD_REPEAT;
+    uintptr_t *word;
+
+    while (((uintptr_t)dst & (sizeof(uintptr_t) - 1)) && len > 0) {
+        *dst++ = color;
+        len --;
+    }
+
+    word = (uintptr_t *)dst;
+    for (; len >= (int32_t)(4 * SGL_SPAN_WORD_PIXELS); len -= 4 * SGL_SPAN_WORD_PIXELS) {
+        word[0] = pattern;
+        word[1] = pattern;
+        word[2] = pattern;
+        word[3] = pattern;
+        word += 4;
+    }
+
+    for (; len >= (int32_t)SGL_SPAN_WORD_PIXELS; len -= SGL_SPAN_WORD_PIXELS) {
+        *word++ = pattern;
+    }
+
+    dst = (sgl_color_t *)word;
+    while (len-- > 0) {
+        *dst++ = color;
+    }
+#else
+    while (len-- > 0) {
+        *dst++ = color;
+    }
+#endif
+}
+
+
+/**
+ * @brief blend a span of pixels with a color
+ * @param dst start of span
+ * @param len number of pixels
+ * @param color color of span
+ * @param alpha alpha of color
+ * @return none
+ * @note the result is the same as sgl_color_mixer() for every pixel, but the alpha check and
+ *       the foreground part of mixer are done only once for the whole span
+ */
+void sgl_draw_blend_span(sgl_color_t *dst, int32_t len, sgl_color_t color, uint8_t alpha)
+{
+    if (alpha == SGL_ALPHA_MAX) {
+        sgl_draw_fill_span(dst, len, color);
+        return;
+    }
+
+    if (alpha == SGL_ALPHA_MIN) {
+        return;
+    }
+
+#if (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    const uint32_t fg_rb = color.full & 0xF81F;
+    const uint32_t fg_g = color.full & 0x07E0;
+    const uint32_t factor_rb = alpha >> 2;
+    uint32_t rxb, xgx;
+
+    for (; len > 0; len--, dst++) {
+        rxb = dst->full & 0xF81F;
+        rxb += (fg_rb - rxb) * factor_rb >> 6;
+        xgx = dst->full & 0x07E0;
+        xgx += (fg_g - xgx) * alpha >> 8;
+        dst->full = (rxb & 0xF81F) | (xgx & 0x07E0);
+    }
+#else
+    for (; len > 0; len--, dst++) {
+        *dst = sgl_color_mixer(color, *dst, alpha);
+    }
+#endif
+}
+
+
+/**
+ * @brief fold coverage of a pixel with global alpha
+ * @param cover coverage of pixel
+ * @param alpha global alpha
+ * @return factor of blending, 0 ~ 255, it is exactly cover when alpha is SGL_ALPHA_MAX
+ */
+static inline uint8_t span_fold_alpha(uint8_t cover, uint8_t alpha)
+{
+    return (uint8_t)((cover * alpha + 255) >> 8);
+}
+
+
+#if (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB565)
+
+/* green is moved to high half word, so that three channels can be multiplied at once */
+#define  SGL_SPAN_RGB565_EXPAND(c)        (((uint32_t)(c) | ((uint32_t)(c) << 16)) & 0x07E0F81F)
+
+#if (CONFIG_SGL_DRAW_SIMD) && (defined(__SSE2__) || defined(__AVX2__))
+#include <immintrin.h>
+#endif
+
+#if (CONFIG_SGL_DRAW_SIMD) && defined(__AVX2__)
+/**
+ * @brief blend 16 RGB565 pixels with coverage by AVX2, it gives the same result as the SWAR code
+ * @param dst 16 pixels
+ * @param mask 16 coverages
+ * @param fg_r red of foreground in 16 bits lanes
+ * @param fg_g green of foreground in 16 bits lanes
+ * @param fg_b blue of foreground in 16 bits lanes
+ * @param alpha global alpha in 16 bits lanes
+ * @return none
+ */
+static inline void span_blend_mask_x16(sgl_color_t *dst, const uint8_t *mask, __m256i fg_r, __m256i fg_g, __m256i fg_b, __m256i alpha)
+{
+    const __m256i c31 = _mm256_set1_epi16(0x1F);
+    const __m256i c63 = _mm256_set1_epi16(0x3F);
+    const __m256i c32 = _mm256_set1_epi16(32);
+    __m256i bg = _mm256_loadu_si256((const __m256i *)dst);
+    __m256i f = _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)mask));
+
+    f = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(f, alpha), _mm256_set1_epi16(255)), 8);
+    f = _mm256_srli_epi16(_mm256_add_epi16(f, _mm256_set1_epi16(4)), 3);
+    __m256i nf = _mm256_sub_epi16(c32, f);
+
+    __m256i r = _mm256_and_si256(_mm256_srli_epi16(bg, 11), c31);
+    __m256i g = _mm256_and_si256(_mm256_srli_epi16(bg, 5), c63);
+    __m256i b = _mm256_and_si256(bg, c31);
+
+    r = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fg_r, f), _mm256_mullo_epi16(r, nf)), 5);
+    g = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fg_g, f), _mm256_mullo_epi16(g, nf)), 5);
+    b = _mm256_srli_epi16(_mm256_add_epi16(_mm256_mullo_epi16(fg_b, f), _mm256_mullo_epi16(b, nf)), 5);
+
+    bg = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi16(r, 11), _mm256_slli_epi16(g, 5)), b);
+    _mm256_storeu_si256((__m256i *)dst, bg);
+}
+#elif (CONFIG_SGL_DRAW_SIMD) && defined(__SSE2__)
+/**
+ * @brief blend 8 RGB565 pixels with coverage by SSE2, it gives the same result as the SWAR code
+ * @param dst 8 pixels
+ * @param mask 8 coverages
+ * @param fg_r red of foreground in 16 bits lanes
+ * @param fg_g green of foreground in 16 bits lanes
+ * @param fg_b blue of foreground in 16 bits lanes
+ * @param alpha global alpha in 16 bits lanes
+ * @return none
+ */
+static inline void span_blend_mask_x8(sgl_color_t *dst, const uint8_t *mask, __m128i fg_r, __m128i fg_g, __m128i fg_b, __m128i alpha)
+{
+    const __m128i c31 = _mm_set1_epi16(0x1F);
+    const __m128i c63 = _mm_set1_epi16(0x3F);
+    const __m128i c32 = _mm_set1_epi16(32);
+    __m128i bg = _mm_loadu_si128((const __m128i *)dst);
+    __m128i f = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)mask), _mm_setzero_si128());
+
+    f = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(f, alpha), _mm_set1_epi16(255)), 8);
+    f = _mm_srli_epi16(_mm_add_epi16(f, _mm_set1_epi16(4)), 3);
+    __m128i nf = _mm_sub_epi16(c32, f);
+
+    __m128i r = _mm_and_si128(_mm_srli_epi16(bg, 11), c31);
+    __m128i g = _mm_and_si128(_mm_srli_epi16(bg, 5), c63);
+    __m128i b = _mm_and_si128(bg, c31);
+
+    r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(fg_r, f), _mm_mullo_epi16(r, nf)), 5);
+    g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(fg_g, f), _mm_mullo_epi16(g, nf)), 5);
+    b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(fg_b, f), _mm_mullo_epi16(b, nf)), 5);
+
+    bg = _mm_or_si128(_mm_or_si128(_mm_slli_epi16(r, 11), _mm_slli_epi16(g, 5)), b);
+    _mm_storeu_si128((__m128i *)dst, bg);
+}
+#endif
+
+#endif // !SGL_COLOR_RGB565
+
+
+/**
+ * @brief blend a span of pixels with a color and per-pixel coverage
+ * @param dst start of span
+ * @param len number of pixels
+ * @param color color of span
+ * @param mask coverage of every pixel, 0 is transparent and 255 is opaque
+ * @param alpha global alpha, it is folded with coverage so every pixel is blended only once
+ * @return none
+ * @note RGB565 pixels are expanded as 0x07E0F81F, so three channels are blended by one 32 bits
+ *       operation (SWAR) with 5 bits factor. When CONFIG_SGL_DRAW_SIMD is enabled on x86 host, 8
+ *       (SSE2) or 16 (AVX2) pixels are blended at once with exactly the same result.
+ *       ARGB8888 pixels are blended as two 0x00FF00FF halves with 8 bits factor.
+ */
+void sgl_draw_blend_span_mask(sgl_color_t *dst, int32_t len, sgl_color_t color, const uint8_t *mask, uint8_t alpha)
+{
+    if (alpha == SGL_ALPHA_MIN) {
+        return;
+    }
+
+#if (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_RGB565)
+    const uint32_t fg = SGL_SPAN_RGB565_EXPAND(color.full);
+    uint32_t bg, f, res;
+
+#if (CONFIG_SGL_DRAW_SIMD) && defined(__AVX2__)
+    const __m256i fg_r = _mm256_set1_epi16(color.ch.red), fg_g = _mm256_set1_epi16(color.ch.green);
+    const __m256i fg_b = _mm256_set1_epi16(color.ch.blue), alpha_x16 = _mm256_set1_epi16(alpha);
+    for (; len >= 16; len -= 16, dst += 16, mask += 16) {
+        span_blend_mask_x16(dst, mask, fg_r, fg_g, fg_b, alpha_x16);
+    }
+#elif (CONFIG_SGL_DRAW_SIMD) && defined(__SSE2__)
+    const __m128i fg_r = _mm_set1_epi16(color.ch.red), fg_g = _mm_set1_epi16(color.ch.green);
+    const __m128i fg_b = _mm_set1_epi16(color.ch.blue), alpha_x8 = _mm_set1_epi16(alpha);
+    for (; len >= 8; len -= 8, dst += 8, mask += 8) {
+        span_blend_mask_x8(dst, mask, fg_r, fg_g, fg_b, alpha_x8);
+    }
+#endif
+
+    for (; len > 0; len--, dst++, mask++) {
+        f = alpha == SGL_ALPHA_MAX ? *mask : span_fold_alpha(*mask, alpha);
+        f = (f + 4) >> 3;
+
+        if (f == 0) {
+            continue;
+        }
+        else if (f == 32) {
+            *dst = color;
+            continue;
+        }
+
+        bg = SGL_SPAN_RGB565_EXPAND(dst->full);
+        res = ((fg * f + bg * (32 - f)) >> 5) & 0x07E0F81F;
+        dst->full = (uint16_t)(res | (res >> 16));
+    }
+
+#elif (CONFIG_SGL_PANEL_PIXEL_DEPTH == SGL_COLOR_ARGB8888)
+    const uint32_t fg_rb = color.full & 0x00FF00FF;
+    const uint32_t fg_ag = (color.full >> 8) & 0x00FF00FF;
+    uint32_t f, nf;
+
+    for (; len > 0; len--, dst++, mask++) {
+        f = alpha == SGL_ALPHA_MAX ? *mask : span_fold_alpha(*mask, alpha);
+
+        if (f == SGL_ALPHA_MIN) {
+            continue;
+        }
+        else if (f == SGL_ALPHA_MAX) {
+            *dst = color;
+            continue;
+        }
+
+        /* map 0 ~ 255 to 0 ~ 256, so that the shift is exact division */
+        f += f >> 7;
+        nf = 256 - f;
+        dst->full = (((fg_rb * f + (dst->full & 0x00FF00FF) * nf) >> 8) & 0x00FF00FF) |
+                    ((fg_ag * f + ((dst->full >> 8) & 0x00FF00FF) * nf) & 0xFF00FF00);
+    }
+
+#else
+    uint8_t f;
+
+    for (; len > 0; len--, dst++, mask++) {
+        f = alpha == SGL_ALPHA_MAX ? *mask : span_fold_alpha(*mask, alpha);
+        if (f != SGL_ALPHA_MIN) {
+            *dst = sgl_color_mixer(color, *dst, f);
+        }
+    }
+#endif
+}
@@ -26,6 +26,8 @@
 #include <sgl_log.h>
 #include <sgl_draw.h>
 #include <sgl_math.h>
+#include <sgl_mm.h>
+#include <string.h>
 
 /**
     font bitmap example is:
@@ -57,6 +59,364 @@ static const uint8_t opa4_table[16] = {0,  17, 34,  51, 68, 85, 102, 119, 136, 1
 static const uint8_t opa2_table[4]  = {0, 85, 170, 255};
 
 
+/**
+ * @brief pixels of a character row that are decoded and blended at once
+ */
+#define  SGL_TEXT_MASK_CHUNK               (32)
+
+
+/**
+ * @brief number of fonts whose glyph extent is kept, the extent is found again if a font is evicted
+ */
+#define  SGL_TEXT_INK_CACHE_SIZE           (4)
+
+
+/**
+ * @brief extent of all glyphs of a font, it is relative to the pen position at the top of line box,
+ *        the glyph of a character whose advance is w is drawn within [left, w - 1 + right] x [top, bottom]
+ * @font: font of the extent, NULL if the entry is empty
+ * @left: the least ofs_x, it is not larger than 0
+ * @right: the largest ofs_x, it is not less than 0
+ * @top: the least top of glyphs, it is not larger than 0
+ * @bottom: the largest bottom of glyphs, it is not less than font_height - 1
+ */
+typedef struct sgl_text_ink {
+    const sgl_font_t   *font;
+    int16_t            left;
+    int16_t            right;
+    int16_t            top;
+    int16_t            bottom;
+} sgl_text_ink_t;
+
+
+/**
+ * @brief glyph extent of recently drawn fonts, every draw thread has its own copy
+ */
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+static __thread struct {
+#else
+static struct {
+#endif
+    sgl_text_ink_t     ink[SGL_TEXT_INK_CACHE_SIZE];
+    uint8_t            next;
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+    uint32_t           gen;
+#endif
+} text_ink_cache;
+
+
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+/**
+ * @brief generation of fonts, it is changed by sgl_font_invalidate() between frames, then every
+ *        draw thread drops its own copy of cache before it draws text again
+ */
+static uint32_t text_ink_gen;
+#endif
+
+
+/**
+ * @brief get glyph extent of font, the font table is scanned only when the font is not in cache
+ * @param font font
+ * @return glyph extent of font
+ */
+static const sgl_text_ink_t* text_font_ink(const sgl_font_t *font)
+{
+    sgl_text_ink_t *ink;
+    int16_t top;
+
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+    if (unlikely(text_ink_cache.gen != text_ink_gen)) {
+        for (int i = 0; i < SGL_TEXT_INK_CACHE_SIZE; i++) {
+            text_ink_cache.ink[i].font = NULL;
+        }
+        text_ink_cache.gen = text_ink_gen;
+    }
+#endif
+
+    for (int i = 0; i < SGL_TEXT_INK_CACHE_SIZE; i++) {
+        if (text_ink_cache.ink[i].font == font) {
+            return &text_ink_cache.ink[i];
+        }
+    }
+
+    ink = &text_ink_cache.ink[text_ink_cache.next];
+    text_ink_cache.next = (text_ink_cache.next + 1) % SGL_TEXT_INK_CACHE_SIZE;
+
+    ink->font = font;
+    ink->left = 0;
+    ink->right = 0;
+    ink->top = 0;
+    ink->bottom = font->font_height - 1;
+
+    for (uint32_t i = 0; i < font->font_table_size; i++) {
+        if (font->table[i].box_h == 0) {
+            continue;
+        }
+        top = font->font_height - font->table[i].ofs_y - font->table[i].box_h;
+        ink->left = sgl_min(ink->left, font->table[i].ofs_x);
+        ink->right = sgl_max(ink->right, font->table[i].ofs_x);
+        ink->top = sgl_min(ink->top, top);
+        ink->bottom = sgl_max(ink->bottom, top + font->table[i].box_h - 1);
+    }
+
+    return ink;
+}
+
+
+#if (CONFIG_SGL_TEXT_GLYPH_CACHE)
+/**
+ * @brief number of hash buckets of glyph cache, it must be power of 2
+ */
+#define  SGL_GLYPH_CACHE_HASH_SIZE         (64)
+
+
+/**
+ * @brief decoded glyph in cache
+ * @hash_next: next glyph in the same hash bucket
+ * @prev: previous glyph in LRU list, the head is the most recently used one
+ * @next: next glyph in LRU list
+ * @font: font of glyph
+ * @ch_index: index of glyph in font table
+ * @size: bytes of this glyph, include header
+ * @data: box_h pairs of [first, last] column that has coverage, then box_w * box_h coverage
+ */
+typedef struct sgl_glyph {
+    struct sgl_glyph   *hash_next;
+    struct sgl_glyph   *prev;
+    struct sgl_glyph   *next;
+    const sgl_font_t   *font;
+    uint32_t           ch_index;
+    uint32_t           size;
+    uint8_t            data[];
+} sgl_glyph_t;
+
+
+/**
+ * @brief LRU glyph cache, glyphs are allocated from sgl heap
+ * @hash: hash buckets
+ * @head: the most recently used glyph
+ * @tail: the least recently used glyph
+ * @used: bytes of all cached glyphs
+ */
+static struct {
+    sgl_glyph_t        *hash[SGL_GLYPH_CACHE_HASH_SIZE];
+    sgl_glyph_t        *head;
+    sgl_glyph_t        *tail;
+    uint32_t           used;
+} glyph_cache;
+
+
+static inline uint32_t glyph_cache_hash(const sgl_font_t *font, uint32_t ch_index)
+{
+    return (((uint32_t)(uintptr_t)font >> 4) ^ (ch_index * 2654435761u)) & (SGL_GLYPH_CACHE_HASH_SIZE - 1);
+}
+
+
+static inline void glyph_cache_lru_remove(sgl_glyph_t *glyph)
+{
+    if (glyph->prev) {
+        glyph->prev->next = glyph->next;
+    }
+    else {
+        glyph_cache.head = glyph->next;
+    }
+
+    if (glyph->next) {
+        glyph->next->prev = glyph->prev;
+    }
+    else {
+        glyph_cache.tail = glyph->prev;
+    }
+}
+
+
+static inline void glyph_cache_lru_push(sgl_glyph_t *glyph)
+{
+    glyph->prev = NULL;
+    glyph->next = glyph_cache.head;
+
+    if (glyph_cache.head) {
+        glyph_cache.head->prev = glyph;
+    }
+    else {
+        glyph_cache.tail = glyph;
+    }
+
+    glyph_cache.head = glyph;
+}
+
+
+/**
+ * @brief remove a glyph from hash bucket and LRU list, then free it
+ * @param glyph glyph in cache
+ * @return none
+ */
+static void glyph_cache_free(sgl_glyph_t *glyph)
+{
+    sgl_glyph_t **pp = &glyph_cache.hash[glyph_cache_hash(glyph->font, glyph->ch_index)];
+
+    while (*pp != glyph) {
+        pp = &(*pp)->hash_next;
+    }
+    *pp = glyph->hash_next;
+
+    glyph_cache_lru_remove(glyph);
+    glyph_cache.used -= glyph->size;
+    sgl_free(glyph);
+}
+
+
+/**
+ * @brief free the least recently used glyph
+ * @param none
+ * @return false if cache is empty
+ */
+static bool glyph_cache_evict(void)
+{
+    if (glyph_cache.tail == NULL) {
+        return false;
+    }
+
+    glyph_cache_free(glyph_cache.tail);
+    return true;
+}
+
+
+/**
+ * @brief decode 4 bpp or 2 bpp bitmap of glyph into 8 bits coverage and column bounds of rows
+ * @param glyph glyph that has been allocated
+ * @return none
+ */
+static void glyph_cache_decode(sgl_glyph_t *glyph)
+{
+    const sgl_font_t *font = glyph->font;
+    const sgl_font_table_t *table = &font->table[glyph->ch_index];
+    const uint8_t *dot = &font->bitmap[table->bitmap_index];
+    uint8_t *bound = glyph->data;
+    uint8_t *cover = glyph->data + table->box_h * 2;
+    uint32_t pixel_index = 0;
+
+    for (int y = 0; y < table->box_h; y++, bound += 2) {
+        /* first > last means that row is empty */
+        bound[0] = table->box_w;
+        bound[1] = 0;
+
+        for (int x = 0; x < table->box_w; x++, pixel_index++, cover++) {
+            if (font->bpp == 4) {
+                *cover = opa4_table[(pixel_index & 1) ? (dot[pixel_index >> 1] & 0x0F) : (dot[pixel_index >> 1] >> 4)];
+            }
+            else {
+                *cover = opa2_table[(dot[pixel_index >> 2] >> ((3 - (pixel_index & 0x3)) * 2)) & 0x03];
+            }
+
+            if (*cover) {
+                bound[0] = sgl_min(bound[0], x);
+                bound[1] = x;
+            }
+        }
+    }
+}
+
+
+/**
+ * @brief get decoded glyph from cache, decode it if it is not cached
+ * @param font font of glyph
+ * @param ch_index index of glyph in font table
+ * @return glyph, NULL if glyph can not be cached
+ */
+static sgl_glyph_t* glyph_cache_get(const sgl_font_t *font, uint32_t ch_index)
+{
+    const sgl_font_table_t *table = &font->table[ch_index];
+    uint32_t hash = glyph_cache_hash(font, ch_index);
+    uint32_t size = sizeof(sgl_glyph_t) + table->box_h * 2 + table->box_w * table->box_h;
+    sgl_glyph_t *glyph;
+
+    for (glyph = glyph_cache.hash[hash]; glyph != NULL; glyph = glyph->hash_next) {
+        if (glyph->font == font && glyph->ch_index == ch_index) {
+            if (glyph != glyph_cache.head) {
+                glyph_cache_lru_remove(glyph);
+                glyph_cache_lru_push(glyph);
+            }
+            return glyph;
+        }
+    }
+
+    if (size > CONFIG_SGL_TEXT_GLYPH_CACHE) {
+        return NULL;
+    }
+
+    while (glyph_cache.used + size > CONFIG_SGL_TEXT_GLYPH_CACHE) {
+        glyph_cache_evict();
+    }
+
+    /* heap may be used by others, free more glyphs until it fits */
+    while ((glyph = sgl_malloc_tag(size, SGL_MM_TAG_FONT)) == NULL) {
+        if (!glyph_cache_evict()) {
+            return NULL;
+        }
+    }
+
+    glyph->font = font;
+    glyph->ch_index = ch_index;
+    glyph->size = size;
+    glyph_cache_decode(glyph);
+
+    glyph->hash_next = glyph_cache.hash[hash];
+    glyph_cache.hash[hash] = glyph;
+    glyph_cache_lru_push(glyph);
+    glyph_cache.used += size;
+
+    return glyph;
+}
+
+
+/**
+ * @brief free all glyphs in cache
+ * @param none
+ * @return none
+ */
+void sgl_glyph_cache_clear(void)
+{
+    while (glyph_cache_evict()) {
+        /* free until empty */
+    }
+}
+#endif // !CONFIG_SGL_TEXT_GLYPH_CACHE
+
+
+/**
+ * @brief drop the cached data of a font, such as decoded glyphs and glyph extent
+ * @param font font whose data is dropped, NULL to drop the data of all fonts
+ * @return none
+ */
+void sgl_font_invalidate(const sgl_font_t *font)
+{
+#if (CONFIG_SGL_TEXT_GLYPH_CACHE)
+    sgl_glyph_t *glyph = glyph_cache.head, *next;
+
+    while (glyph != NULL) {
+        next = glyph->next;
+        if (font == NULL || glyph->font == font) {
+            glyph_cache_free(glyph);
+        }
+        glyph = next;
+    }
+#endif
+
+#if (CONFIG_SGL_DRAW_THREADS > 1)
+    /* the cache of every draw thread is dropped when it draws text again */
+    SGL_UNUSED(font);
+    text_ink_gen ++;
+#else
+    for (int i = 0; i < SGL_TEXT_INK_CACHE_SIZE; i++) {
+        if (font == NULL || text_ink_cache.ink[i].font == font) {
+            text_ink_cache.ink[i].font = NULL;
+        }
+    }
+#endif
+}
+
+
 /**
  * @brief Draw a character on the surface with alpha blending
  * @param surf Pointer to the surface where the character will be drawn
@@ -68,7 +428,7 @@ static const uint8_t opa2_table[4]  = {0, 85, 170, 255};
  * @param alpha Alpha value for blending
  * @param font Pointer to the font structure containing character data
  * @return none
- * @note this function is only support bpp:4
+ * @note this function supports bpp 4 and bpp 2
  */
 void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, uint32_t ch_index, sgl_color_t color, uint8_t alpha, const sgl_font_t *font)
 {
@@ -77,10 +437,10 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
     const uint8_t font_w = font->table[ch_index].box_w;
     const uint8_t font_h = font->table[ch_index].box_h;
 
-    uint8_t shift = 0;
-    uint32_t pixel_index, rel_x, rel_y;
-    uint16_t byte_index, alpha_dot;
-    sgl_color_t color_mix, *buf = NULL;
+    uint8_t mask[SGL_TEXT_MASK_CHUNK];
+    uint32_t pixel_index;
+    int16_t len;
+    sgl_color_t *buf = NULL;
     sgl_area_t clip;
 
     sgl_area_t text_rect = {
@@ -97,42 +457,56 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
         return;
     }
 
-    if (font->bpp == 4) {
-        for (int y = clip.y1; y <= clip.y2; y++) {
-            buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
-            rel_y = y - text_rect.y1;
+    if (font->bpp != 4 && font->bpp != 2) {
+        return;
+    }
 
-            for (int x = clip.x1; x <= clip.x2; x++) {
-                rel_x = x - text_rect.x1;
+#if (CONFIG_SGL_TEXT_GLYPH_CACHE)
+    sgl_glyph_t *glyph = glyph_cache_get(font, ch_index);
 
-                pixel_index = rel_y * font_w + rel_x;
+    if (glyph != NULL) {
+        const uint8_t *bound = glyph->data;
+        const uint8_t *cover = glyph->data + font_h * 2;
+        int16_t first, last, row;
 
-                byte_index = pixel_index >> 1;
-                alpha_dot =  opa4_table[(pixel_index & 1) ? (dot[byte_index] & 0x0F) : (dot[byte_index] >> 4)];
+        for (int y = clip.y1; y <= clip.y2; y++) {
+            row = y - text_rect.y1;
 
-                color_mix = sgl_color_mixer(color, *buf, alpha_dot);
-                *buf = sgl_color_mixer(color_mix, *buf, alpha);
-                buf++;
+            /* only blend the columns that have coverage */
+            first = sgl_max(bound[row * 2], clip.x1 - text_rect.x1);
+            last = sgl_min(bound[row * 2 + 1], clip.x2 - text_rect.x1);
+            if (first > last) {
+                continue;
             }
+
+            buf = sgl_surf_get_buf(surf, text_rect.x1 + first - surf->x, y - surf->y);
+            sgl_draw_blend_span_mask(buf, last - first + 1, color, &cover[row * font_w + first], alpha);
         }
+        return;
     }
-    else if (font->bpp == 2) {
-        for (int y = clip.y1; y <= clip.y2; y++) {
-            buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
-            rel_y = y - text_rect.y1;
+#endif
 
-            for (int x = clip.x1; x <= clip.x2; x++) {
-                rel_x = x - text_rect.x1;
-                pixel_index = rel_y * font_w + rel_x;
+    for (int y = clip.y1; y <= clip.y2; y++) {
+        buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
+        pixel_index = (y - text_rect.y1) * font_w + (clip.x1 - text_rect.x1);
 
-                byte_index = pixel_index >> 2;
-                shift = (3 - (pixel_index & 0x3)) * 2;
-                alpha_dot = opa2_table[(dot[byte_index] >> shift) & 0x03];
+        /* decode coverage of a chunk of pixels and blend them as one span */
+        for (int x = clip.x1; x <= clip.x2; x += len) {
+            len = sgl_min(clip.x2 - x + 1, SGL_TEXT_MASK_CHUNK);
 
-                color_mix = sgl_color_mixer(color, *buf, alpha_dot);
-                *buf = sgl_color_mixer(color_mix, *buf, alpha);
-                buf++;
+            if (font->bpp == 4) {
+                for (int i = 0; i < len; i++, pixel_index++) {
+                    mask[i] = opa4_table[(pixel_index & 1) ? (dot[pixel_index >> 1] & 0x0F) : (dot[pixel_index >> 1] >> 4)];
+                }
             }
+            else {
+                for (int i = 0; i < len; i++, pixel_index++) {
+                    mask[i] = opa2_table[(dot[pixel_index >> 2] >> ((3 - (pixel_index & 0x3)) * 2)) & 0x03];
+                }
+            }
+
+            sgl_draw_blend_span_mask(buf, len, color, mask, alpha);
+            buf += len;
         }
     }
 }
@@ -152,12 +526,30 @@ void sgl_draw_character(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y
  */
 void sgl_draw_string(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const char *str, sgl_color_t color, uint8_t alpha, const sgl_font_t *font)
 {
+    const sgl_text_ink_t *ink;
+    sgl_area_t clip;
     uint32_t ch_index;
+    int16_t ch_width;
     #if CONFIG_SGL_TEXT_UTF8
     uint32_t unicode = 0;
     #endif
 
+    if (!sgl_surf_clip(surf, area, &clip)) {
+        return;
+    }
+
+    /* the string is called for every slice it is in, skip it if the line misses the slice */
+    ink = text_font_ink(font);
+    if (y + ink->bottom < clip.y1 || y + ink->top > clip.y2) {
+        return;
+    }
+
     while (*str) {
+        /* the rest glyphs are on the right of clip */
+        if (x + ink->left > clip.x2) {
+            break;
+        }
+
         #if CONFIG_SGL_TEXT_UTF8
         str += sgl_utf8_to_unicode(str, &unicode);
         ch_index = sgl_search_unicode_ch_index(font, unicode);
@@ -165,8 +557,14 @@ void sgl_draw_string(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, c
         ch_index = ((uint32_t)*str) - SGL_TEXT_ASCII_OFFSET;
         str++;
         #endif
-        sgl_draw_character(surf, area, x, y, ch_index, color, alpha, font);
-        x += font->table[ch_index].box_w;
+
+        ch_width = font->table[ch_index].box_w;
+
+        /* only advance the glyphs on the left of clip */
+        if (x + ch_width - 1 + ink->right >= clip.x1) {
+            sgl_draw_character(surf, area, x, y, ch_index, color, alpha, font);
+        }
+        x += ch_width;
     }
 }
 
@@ -221,3 +619,186 @@ void sgl_draw_string_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, in
         x_off += ch_width;
     }
 }
+
+
+/**
+ * @brief walk one line of text and draw it if surf is not NULL, the wrap rule is the same as
+ *        sgl_draw_string_mult_line()
+ * @param surf Pointer to the surface, NULL to only find the end of line
+ * @param area Pointer to the area where the string will be drawn
+ * @param x X coordinate of the left of the text
+ * @param y Y coordinate of the top of the line
+ * @param str start of the line
+ * @param wrap input, SGL_TEXT_LINES_MARK_WRAP if the line is started by wrap; output, the same of next line
+ * @param color Foreground color of the string
+ * @param alpha Alpha value for blending
+ * @param font Pointer to the font structure containing character data
+ * @param width a character is wrapped if its right side plus edge margin is larger than width
+ * @param edge_margin Margin between characters and the edges
+ * @return start of next line, NULL if it is the last line
+ */
+static const char* text_line_walk(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const char *str, uint32_t *wrap,
+                                  sgl_color_t color, uint8_t alpha, const sgl_font_t *font, int16_t width, uint8_t edge_margin)
+{
+    int16_t ch_index, ch_width;
+    int16_t x_off = edge_margin;
+    const char *next;
+    const sgl_text_ink_t *ink = NULL;
+    sgl_area_t clip;
+    /* the first character of a wrapped line is not wrapped again */
+    bool test = (*wrap == 0);
+    #if CONFIG_SGL_TEXT_UTF8
+    uint32_t unicode = 0;
+    #endif
+
+    if (surf != NULL) {
+        ink = text_font_ink(font);
+        if (!sgl_surf_clip(surf, area, &clip)) {
+            surf = NULL;
+        }
+    }
+
+    while (*str) {
+        if (*str == '\n') {
+            *wrap = 0;
+            return str + 1;
+        }
+
+        #if CONFIG_SGL_TEXT_UTF8
+        next = str + sgl_utf8_to_unicode(str, &unicode);
+        ch_index = sgl_search_unicode_ch_index(font, unicode);
+        #else
+        ch_index = ((uint32_t)*str) - SGL_TEXT_ASCII_OFFSET;
+        next = str + 1;
+        #endif
+
+        ch_width = font->table[ch_index].box_w;
+
+        if (test && (x_off + ch_width + edge_margin) > width) {
+            *wrap = SGL_TEXT_LINES_MARK_WRAP;
+            return str;
+        }
+
+        /* glyphs out of clip are only advanced, the line is walked to its end to find next line */
+        if (surf != NULL && (x + x_off + ink->left) <= clip.x2 && (x + x_off + ch_width - 1 + ink->right) >= clip.x1) {
+            sgl_draw_character(surf, area, x + x_off, y, ch_index, color, alpha, font);
+        }
+
+        test = true;
+        x_off += ch_width;
+        str = next;
+    }
+
+    return NULL;
+}
+
+
+/**
+ * @brief update line break index of a multiple lines text, it is rebuilt only if any parameter is changed
+ * @param lines line break index
+ * @param str text
+ * @param font font of text
+ * @param width a character is wrapped if its right side plus edge margin is larger than width
+ * @param edge_margin margin between characters and the edges
+ * @return number of lines of text
+ */
+uint32_t sgl_text_lines_update(sgl_text_lines_t *lines, const char *str, const sgl_font_t *font, int16_t width, uint8_t edge_margin)
+{
+    const char *line = str;
+    uint32_t wrap = 0, count = 0;
+    uint32_t length;
+
+    SGL_ASSERT(lines != NULL && str != NULL && font != NULL);
+
+    /* the text may be edited in place, the length keeps the marks inside of it */
+    length = strlen(str);
+    if (lines->text == str && lines->length == length && lines->font == font
+        && lines->width == width && lines->edge_margin == edge_margin) {
+        return lines->count;
+    }
+
+    lines->shift = 0;
+    while (line != NULL) {
+        if ((count & ((1u << lines->shift) - 1)) == 0) {
+            /* no free mark, keep every other mark */
+            if ((count >> lines->shift) == SGL_TEXT_LINES_MARK_NUM) {
+                for (int i = 0; i < SGL_TEXT_LINES_MARK_NUM / 2; i++) {
+                    lines->mark[i] = lines->mark[i * 2];
+                }
+                lines->shift ++;
+            }
+            lines->mark[count >> lines->shift] = (uint32_t)(line - str) | wrap;
+        }
+
+        line = text_line_walk(NULL, NULL, 0, 0, line, &wrap, SGL_COLOR_BLACK, 0, font, width, edge_margin);
+        count ++;
+    }
+
+    lines->text = str;
+    lines->length = length;
+    lines->font = font;
+    lines->width = width;
+    lines->edge_margin = edge_margin;
+    lines->count = count;
+
+    return count;
+}
+
+
+/**
+ * @brief Draw the visible lines of a multiple lines text which has line break index
+ * @param surf Pointer to the surface where the string will be drawn
+ * @param area Pointer to the area where the string will be drawn
+ * @param x X coordinate of the top-left corner of the text
+ * @param y Y coordinate of the top-left corner of the text
+ * @param lines line break index, it should be updated by sgl_text_lines_update()
+ * @param color Foreground color of the string
+ * @param alpha Alpha value for blending
+ * @param line_margin Margin between lines
+ * @return none
+ */
+void sgl_draw_text_lines(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const sgl_text_lines_t *lines, sgl_color_t color, uint8_t alpha, uint8_t line_margin)
+{
+    const sgl_font_t *font = lines->font;
+    const sgl_text_ink_t *ink;
+    int32_t line_h, top, bottom, line_y;
+    uint32_t first, n, wrap;
+    const char *str;
+
+    if (lines->text == NULL) {
+        return;
+    }
+
+    /* a line is visible if its glyphs intersect both of the surface and the area */
+    ink = text_font_ink(font);
+    line_h = font->font_height + line_margin;
+    top = sgl_max(surf->y, area->y1) - ink->bottom;
+    bottom = sgl_min(surf->y + surf->h - 1, area->y2) - ink->top;
+    if (bottom < top) {
+        return;
+    }
+
+    first = (top > y) ? (uint32_t)((top - y) / line_h) : 0;
+    if (first >= lines->count) {
+        return;
+    }
+
+    /* start from the nearest mark, and skip the lines above the surface */
+    n = (first >> lines->shift) << lines->shift;
+    str = lines->text + (lines->mark[first >> lines->shift] & ~SGL_TEXT_LINES_MARK_WRAP);
+    wrap = lines->mark[first >> lines->shift] & SGL_TEXT_LINES_MARK_WRAP;
+
+    /* the text is edited in place and the index is not built again, walk from its start */
+    if (unlikely(strlen(lines->text) != lines->length)) {
+        n = 0;
+        str = lines->text;
+        wrap = 0;
+    }
+    for (; n < first && str != NULL; n++) {
+        str = text_line_walk(NULL, area, x, y, str, &wrap, color, alpha, font, lines->width, lines->edge_margin);
+    }
+
+    for (line_y = y + (int32_t)n * line_h; str != NULL && line_y <= bottom; line_y += line_h) {
+        str = text_line_walk(surf, area, x, line_y, str, &wrap, color, alpha, font, lines->width, lines->edge_margin);
+    }
+}
@@ -1686,6 +1686,16 @@ static const uint16_t unicode_list_1[] = {
 };
 #endif //!CONFIG_SGL_TEXT_UTF8
 
+#if (CONFIG_SGL_TEXT_UTF8)
+static const sgl_font_unicode_index_t unicode_index_1 = {
+    .range_start = 0x0020,
+    .range_len = 96,
+    .range_index = 0,
+    .page_map = NULL,
+    .pages = NULL,
+};
+#endif // !CONFIG_SGL_TEXT_UTF8
+
 const sgl_font_t consolas23 = {
     .bitmap = sgl_ascii_consolas23_bitmap,
     .table = sgl_ascii_consolas23_tab,
@@ -1695,6 +1705,7 @@ const sgl_font_t consolas23 = {
 #if (CONFIG_SGL_TEXT_UTF8)
     .unicode_list = unicode_list_1,
     .unicode_list_len = SGL_ARRAY_SIZE(unicode_list_1),
+    .unicode_index = &unicode_index_1,
 #endif        
 };
 
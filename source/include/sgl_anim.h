@@ -48,10 +48,20 @@ typedef void (*sgl_anim_path_cb_t)(struct sgl_anim *anim, int32_t value);
 typedef int32_t (*sgl_anim_path_algo_t)(uint32_t elaps, uint32_t duration, int16_t start, int16_t end);
 
 
+/**
+ * @brief animation object
+ * @next, prev: link of the list that animation is in, a running animation is in
+ *              running list, a delayed animation is in a slot of timing wheel
+ * @act_time: time of current cycle that is kept when animation is stopped, ms
+ * @act_start: time when the delay of current cycle is over, it is the deadline of delayed animation
+ * @state: SGL_ANIM_STATE_IDLE, SGL_ANIM_STATE_DELAYED or SGL_ANIM_STATE_RUNNING
+ */
 typedef struct sgl_anim {
     void                  *data;
     struct sgl_anim       *next;
+    struct sgl_anim       *prev;
     uint32_t              act_time;
+    uint32_t              act_start;
     uint32_t              act_delay;
     uint32_t              act_duration;
     uint16_t              start_value;
@@ -62,29 +72,57 @@ typedef struct sgl_anim {
     uint32_t              repeat_cnt : 30;
     uint32_t              finished : 1;
     uint32_t              auto_free : 1;
+    uint8_t               state;
 } sgl_anim_t;
 
 
+/* delayed animations are kept in a timing wheel, a slot holds the deadlines of 8 ms,
+ * so a round of wheel is 512 ms, a longer delay stays in its slot for more rounds
+ */
+#define  SGL_ANIM_WHEEL_SHIFT                          (3)
+#define  SGL_ANIM_WHEEL_SIZE                           (64)
+
+
 /**
  * @brief animation context, it will be used to store status of animation
- * @anim_list_head: animation list head
- * @anim_list_tail: animation list tail
+ * @anim_list_head: running animation list head
+ * @anim_list_tail: running animation list tail
+ * @anim_iter:      next running animation of sgl_anim_task(), it is moved on if that one is removed
+ * @wheel:          timing wheel of delayed animations
  * @anim_cnt:       animation count
- * @tick_ms:        animation tick, ms
+ * @delay_cnt:      delayed animation count
+ * @tick_ms:        animation time, ms
+ * @wheel_unit:     the 8 ms unit of last sgl_anim_task()
+ * @next_due:       the earliest deadline of delayed animations, it is valid if next_due_valid is true
  */
 typedef struct sgl_anim_ctx {
     sgl_anim_t *anim_list_head;
     sgl_anim_t *anim_list_tail;
+    sgl_anim_t *anim_iter;
+    sgl_anim_t *wheel[SGL_ANIM_WHEEL_SIZE];
     uint32_t    anim_cnt;
+    uint32_t    delay_cnt;
+    uint32_t    tick_ms;
+    uint32_t    wheel_unit;
+    uint32_t    next_due;
+    bool        next_due_valid;
 } sgl_anim_ctx_t;
 
 
+/* walk running animations */
 #define  sgl_anim_for_each(anim, head)                 for ((anim) = (head)->anim_list_head; (anim) != NULL; (anim) = (anim)->next)
 #define  sgl_anim_for_each_safe(anim, n, head)         for (anim = (head)->anim_list_head, n = (anim) ? (anim)->next : NULL; anim != NULL; anim = n, n = (anim) ? (anim)->next : NULL)
 
 #define  SGL_ANIM_REPEAT_LOOP                          (0x3FFFFFFF)
 #define  SGL_ANIM_REPEAT_ONCE                          (1)
 
+#define  SGL_ANIM_STATE_IDLE                           (0)
+#define  SGL_ANIM_STATE_DELAYED                        (1)
+#define  SGL_ANIM_STATE_RUNNING                        (2)
+
+/* no animation is running or delayed, so no animation will be due */
+#define  SGL_ANIM_NEVER                                (UINT32_MAX)
+
 
 /* Animation context it will be used internally */
 extern sgl_anim_ctx_t anim_ctx;
@@ -107,7 +145,8 @@ sgl_anim_t* sgl_anim_create(void);
 
 
 /**
- * @brief add animation object to animation list
+ * @brief add animation object to running list, or to timing wheel if it is in delay,
+ *        an animation that is already added is not changed
  * @param  anim animation object
  * @return none
 */
@@ -115,7 +154,8 @@ void sgl_anim_add(sgl_anim_t *anim);
 
 
 /**
- * @brief remove animation object from animation list
+ * @brief remove animation object from running list or timing wheel,
+ *        the time of current cycle is kept for next sgl_anim_add()
  * @param  anim animation object
  * @return none
 */
@@ -152,7 +192,8 @@ static inline void sgl_anim_stop(sgl_anim_t *anim)
 static inline void sgl_anim_free(sgl_anim_t *anim)
 {
     SGL_ASSERT(anim != NULL);
-    sgl_free(anim);
+    sgl_anim_remove(anim);
+    sgl_slab_free(anim);
 }
 
 
@@ -287,12 +328,24 @@ static inline void sgl_anim_set_auto_free(sgl_anim_t *anim)
 
 
 /**
- * @brief animation task, it will foreach all animation
+ * @brief animation task, it wakes up delayed animations that are due and steps running animations,
+ *        animations in delay are not visited
  * @param  none
- * @return none
+ * @return time until the next animation is due, ms, 0 if any animation is running,
+ *         SGL_ANIM_NEVER if there is no animation
  * @note   this function should be called in sgl_task()
  */
-void sgl_anim_task(void);
+uint32_t sgl_anim_task(void);
+
+
+/**
+ * @brief get time until the next animation is due, the ticks that are counted
+ *        but not handled by sgl_task_handle() yet are taken into account
+ * @param  none
+ * @return time until the next animation is due, ms, 0 if any animation is running,
+ *         SGL_ANIM_NEVER if there is no animation
+ */
+uint32_t sgl_anim_next_due(void);
 
 
 /**
@@ -0,0 +1,216 @@
+/* source/include/sgl_asset.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SGL_ASSET_H__
+#define __SGL_ASSET_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <sgl_cfgfix.h>
+#include <sgl_core.h>
+
+
+#if (CONFIG_SGL_ASSET_PACK)
+
+/* 'S' 'G' 'L' 'A' in little endian */
+#define  SGL_ASSET_MAGIC                   (0x414C4753)
+#define  SGL_ASSET_VERSION                 (1)
+/* max length of asset name, include the terminating zero */
+#define  SGL_ASSET_NAME_MAX                (24)
+
+
+/**
+ * @brief type of asset in pack
+ */
+typedef enum sgl_asset_type {
+    SGL_ASSET_PIXMAP = 1,
+    SGL_ASSET_ICON,
+    SGL_ASSET_FONT,
+} sgl_asset_type_t;
+
+
+/**
+ * @brief header of asset pack, all fields of pack are little endian, it is followed by
+ *        count entries of index and then the data of assets, every data is 4 bytes aligned
+ *
+ * @magic: SGL_ASSET_MAGIC
+ * @version: SGL_ASSET_VERSION
+ * @count: number of assets
+ * @size: bytes of whole pack
+ * @reserved: must be 0
+ */
+typedef struct sgl_asset_header {
+    uint32_t       magic;
+    uint16_t       version;
+    uint16_t       count;
+    uint32_t       size;
+    uint32_t       reserved;
+} sgl_asset_header_t;
+
+
+/**
+ * @brief index entry of an asset in pack
+ *
+ * @name: name of asset, padded with zero
+ * @type: sgl_asset_type_t
+ * @format: pixmap format, icon bpp or font bpp
+ * @width: pixmap or icon width, number of glyphs of font
+ * @height: pixmap or icon height, font height
+ * @offset: offset of data from start of pack
+ * @size: bytes of data
+ * @bitmap: font only, offset of bitmap from start of data, the glyph table is at start of data
+ *          and the unicode list follows it
+ * @unicode_len: font only, length of unicode list, 0 if the font has no unicode list
+ */
+typedef struct sgl_asset_entry {
+    char           name[SGL_ASSET_NAME_MAX];
+    uint8_t        type;
+    uint8_t        format;
+    uint16_t       reserved;
+    uint16_t       width;
+    uint16_t       height;
+    uint32_t       offset;
+    uint32_t       size;
+    uint32_t       bitmap;
+    uint32_t       unicode_len;
+} sgl_asset_entry_t;
+
+
+/**
+ * @brief an opened asset pack
+ *
+ * @base: start of pack in memory, NULL if the pack is read by read function
+ * @entry: index of pack, it points into base or it is loaded into heap
+ * @count: number of assets
+ * @size: bytes of whole pack
+ * @read: read function of pack, pos is the offset from start of pack
+ * @loaded: data of assets that are loaded into heap, only for read function
+ * @mapped: the pack is mapped by sgl_asset_open_file() and unmapped by sgl_asset_close()
+ */
+typedef struct sgl_asset_pack {
+    const uint8_t            *base;
+    const sgl_asset_entry_t  *entry;
+    uint16_t                 count;
+    uint32_t                 size;
+    void                     (*read)(void *buff, uint32_t pos, size_t size);
+    uint8_t                  **loaded;
+    bool                     mapped;
+} sgl_asset_pack_t;
+
+
+/**
+ * @brief open an asset pack that is in memory, such as memory mapped flash or a mapped file,
+ *        the descriptors that are got from it point into the memory without copy
+ * @param pack: asset pack
+ * @param base: start of pack, it must be 4 bytes aligned and it must be kept until the pack is closed
+ * @param size: bytes of memory
+ * @return int: 0 on success, -1 on invalid pack
+ */
+int sgl_asset_open(sgl_asset_pack_t *pack, const void *base, size_t size);
+
+
+/**
+ * @brief open an asset pack that is read by a function, for the targets that can not map
+ *        the storage into memory, the index is loaded into heap
+ * @param pack: asset pack
+ * @param read: read function, pos is the offset from start of pack
+ * @return int: 0 on success, -1 on invalid pack or out of memory
+ * @note pixmaps are read by the function when they are drawn if CONFIG_SGL_EXTERNAL_PIXMAP is
+ *       enabled, icons, fonts and the other pixmaps are loaded into heap when they are got
+ */
+int sgl_asset_open_read(sgl_asset_pack_t *pack, void (*read)(void *buff, uint32_t pos, size_t size));
+
+
+#if defined(__unix__) || defined(__APPLE__)
+/**
+ * @brief map an asset pack file into memory and open it, the pages of the file are
+ *        shared by all processes that map it
+ * @param pack: asset pack
+ * @param path: path of pack file
+ * @return int: 0 on success, -1 on error
+ */
+int sgl_asset_open_file(sgl_asset_pack_t *pack, const char *path);
+#endif
+
+
+/**
+ * @brief close an asset pack, the descriptors that are got from it can not be used anymore
+ * @param pack: asset pack
+ * @return none
+ * @note the cached glyphs and extents of all fonts are dropped, see sgl_font_invalidate()
+ */
+void sgl_asset_close(sgl_asset_pack_t *pack);
+
+
+/**
+ * @brief find an asset in pack by name
+ * @param pack: asset pack
+ * @param name: name of asset
+ * @param type: type of asset
+ * @return const sgl_asset_entry_t*: entry of asset, NULL if not found
+ */
+const sgl_asset_entry_t* sgl_asset_find(sgl_asset_pack_t *pack, const char *name, sgl_asset_type_t type);
+
+
+/**
+ * @brief get a pixmap from pack
+ * @param pack: asset pack
+ * @param name: name of pixmap
+ * @param pixmap: pixmap that is filled
+ * @return int: 0 on success, -1 if not found or out of memory
+ */
+int sgl_asset_get_pixmap(sgl_asset_pack_t *pack, const char *name, sgl_pixmap_t *pixmap);
+
+
+/**
+ * @brief get an icon from pack
+ * @param pack: asset pack
+ * @param name: name of icon
+ * @param icon: icon that is filled
+ * @return int: 0 on success, -1 if not found or out of memory
+ */
+int sgl_asset_get_icon(sgl_asset_pack_t *pack, const char *name, sgl_icon_pixmap_t *icon);
+
+
+/**
+ * @brief get a font from pack
+ * @param pack: asset pack
+ * @param name: name of font
+ * @param font: font that is filled
+ * @return int: 0 on success, -1 if not found or out of memory
+ * @note the cached data of the font that the struct held is dropped, so the struct can be reused
+ */
+int sgl_asset_get_font(sgl_asset_pack_t *pack, const char *name, sgl_font_t *font);
+
+#endif // !CONFIG_SGL_ASSET_PACK
+
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // !__SGL_ASSET_H__
@@ -53,6 +53,19 @@ extern "C" {
  * CONFIG_SGL_EVENT_QUEUE_SIZE:
  *      the size of event queue, default: 32
  * 
+ * CONFIG_SGL_EVENT_HIT_GRID:
+ *      Pixels of a cell of the grid that finds the object at a touch position, every cell keeps
+ *      the objects that overlap it, 0 means that all objects are walked, default: 0
+ * 
+ * CONFIG_SGL_DIRTY_AREA_THRESHOLD:
+ *      The fixed cost of drawing a dirty area separately is counted as THRESHOLD * THRESHOLD / 4
+ *      pixels, two dirty areas are merged when the merged area costs less, default: 64,
+ *      0 means that all dirty areas are merged into one area
+ * 
+ * CONFIG_SGL_DIRTY_AREA_NUM_MAX:
+ *      The maximum number of dirty areas in a frame, the whole screen is redrawn if there are
+ *      more dirty areas, default: 16
+ * 
  * CONFIG_SGL_OBJ_SLOT_DYNAMIC
  *      If the object slot is dynamic, the object slot size will be dynamic allocated, otherwise, the object 
  *      slot size will be static allocated that you should define CONFIG_SGL_OBJ_NUM_MAX macro
@@ -69,9 +82,32 @@ extern "C" {
  * CONFIG_SGL_TEXT_UTF8:
  *      If you want to use text utf8, please define this macro to 1
  * 
+ * CONFIG_SGL_TEXT_GLYPH_CACHE:
+ *      Bytes of heap that LRU glyph cache can use to keep decoded 8 bits coverage of glyphs,
+ *      0 means that glyphs are decoded on every draw, default: 0
+ * 
  * CONFIG_SGL_EXTERNAL_PIXMAP:
  *      If you want to use external pixmap, please define this macro to 1
  * 
+ * CONFIG_SGL_PIXMAP_CACHE:
+ *      Bytes of LRU block cache of external pixmaps, the blocks that are not cached are read
+ *      from external storage at once, 0 means that every row is read when it is drawn, default: 0
+ * 
+ * CONFIG_SGL_PIXMAP_CACHE_BLOCK:
+ *      Bytes of a block of pixmap cache, it must be a multiple of 4, default: 128
+ * 
+ * CONFIG_SGL_PIXMAP_READ_AHEAD:
+ *      Rows of panel that are read ahead in the same read when whole rows of a pixmap are
+ *      drawn one after another, default: 2
+ * 
+ * CONFIG_SGL_PIXMAP_QOI:
+ *      If you want to draw pixmaps that are compressed by tools/sgl_qoi_encode.py, with alpha
+ *      channel, please define this macro to 1, default: 0
+ * 
+ * CONFIG_SGL_ASSET_PACK:
+ *      If you want to load pixmaps, icons and fonts from a binary asset pack that is made by
+ *      tools/sgl_asset_pack.py, please define this macro to 1, default: 0
+ * 
  * CONFIG_SGL_USE_OBJ_ID:
  *      If you want to use obj id, please define this macro to 1, at mostly, the CONFIG_SGL_USE_OBJ_ID should be 0
  * 
@@ -81,6 +117,15 @@ extern "C" {
  * CONFIG_SGL_HEAP_MEMORY_SIZE:
  *      The heap memory size, default: 10240
  * 
+ * CONFIG_SGL_SLAB_SIZE:
+ *      The memory size of slab pools, objects and animations of the same size are allocated from
+ *      1 KB pages of their own size class, 0 means that they are allocated from heap, default: 0
+ * 
+ * CONFIG_SGL_MM_TAG:
+ *      If you want to know how much heap memory is used by widgets, glyph cache, image buffers,
+ *      animations and so on, please define this macro to 1, every heap block takes 8 more bytes
+ *      to keep its owner tag, default: 0
+ * 
  * CONFIG_SGL_FONT_SONG23:
  *      If you want to use font song23, please define this macro to 1
  * 
@@ -90,6 +135,33 @@ extern "C" {
  * CONFIG_SGL_FONT_KAI33:
  *      If you want to use font kai33, please define this macro to 1
  * 
+ * CONFIG_SGL_DRAW_SIMD:
+ *      If you build sgl for x86 host with SSE2 or AVX2 enabled, please define this macro to 1 to use
+ *      SIMD blending of RGB565, it gives the same result as the portable code
+ * 
+ * CONFIG_SGL_FLUSH_ASYNC:
+ *      If flush_area starts a DMA transfer and returns before it is finished, please define
+ *      this macro to 1, the driver must call sgl_flush_ready() when the transfer is finished,
+ *      and sgl draws the next slice into the other buffer in the meantime, default: 0
+ * 
+ * CONFIG_SGL_DRAW_THREADS:
+ *      The number of threads that draw slices of a dirty area, it needs pthread and is used on
+ *      Linux targets, flush_area is called from draw threads one by one in order of slices,
+ *      it does not support CONFIG_SGL_USE_FULL_FB, CONFIG_SGL_PROFILER,
+ *      CONFIG_SGL_EXTERNAL_PIXMAP and CONFIG_SGL_TEXT_GLYPH_CACHE. DRAW_MAIN of a widget
+ *      must not write the object, because the slices of it are drawn by several threads
+ *      at the same time, compute such state in DRAW_INIT, default: 1
+ * 
+ * CONFIG_SGL_PROFILER:
+ *      If you want to record the time of every widget in a frame, please define this macro to 1,
+ *      it should be 0 in release image, all profiler code is compiled out
+ * 
+ * CONFIG_SGL_PROFILER_OBJ_MAX:
+ *      The max number of objects that profiler records in a frame, default: 32
+ * 
+ * CONFIG_SGL_PROFILER_DIRTY_MAX:
+ *      The max number of dirty areas that profiler records in a frame, default: 16
+ * 
  */
 
 #ifndef CONFIG_SGL_PANEL_PIXEL_DEPTH
@@ -112,10 +184,18 @@ extern "C" {
 #define CONFIG_SGL_EVENT_QUEUE_SIZE                                (32)
 #endif
 
+#ifndef CONFIG_SGL_EVENT_HIT_GRID
+#define CONFIG_SGL_EVENT_HIT_GRID                                  (0)
+#endif
+
 #ifndef CONFIG_SGL_DIRTY_AREA_THRESHOLD
 #define CONFIG_SGL_DIRTY_AREA_THRESHOLD                            (64)
 #endif
 
+#ifndef CONFIG_SGL_DIRTY_AREA_NUM_MAX
+#define CONFIG_SGL_DIRTY_AREA_NUM_MAX                              (16)
+#endif
+
 #ifndef CONFIG_SGL_ANIMATION
 #define CONFIG_SGL_ANIMATION                                       (0)
 #endif
@@ -135,10 +215,38 @@ extern "C" {
 #define CONFIG_SGL_TEXT_UTF8                                       (0)
 #endif
 
+#ifndef CONFIG_SGL_TEXT_GLYPH_CACHE
+#define CONFIG_SGL_TEXT_GLYPH_CACHE                                (0)
+#endif
+
 #ifndef CONFIG_SGL_EXTERNAL_PIXMAP
 #define CONFIG_SGL_EXTERNAL_PIXMAP                                 (0)
 #endif
 
+#ifndef CONFIG_SGL_PIXMAP_CACHE
+#define CONFIG_SGL_PIXMAP_CACHE                                    (0)
+#endif
+
+#if (CONFIG_SGL_PIXMAP_CACHE)
+#   ifndef CONFIG_SGL_PIXMAP_CACHE_BLOCK
+#       define CONFIG_SGL_PIXMAP_CACHE_BLOCK                       (128)
+#   endif
+#   ifndef CONFIG_SGL_PIXMAP_READ_AHEAD
+#       define CONFIG_SGL_PIXMAP_READ_AHEAD                        (2)
+#   endif
+#   if (CONFIG_SGL_PIXMAP_CACHE_BLOCK % 4) || (CONFIG_SGL_PIXMAP_CACHE < 2 * CONFIG_SGL_PIXMAP_CACHE_BLOCK)
+#       error "CONFIG_SGL_PIXMAP_CACHE_BLOCK must be a multiple of 4, CONFIG_SGL_PIXMAP_CACHE must keep 2 blocks at least"
+#   endif
+#endif
+
+#ifndef CONFIG_SGL_PIXMAP_QOI
+#define CONFIG_SGL_PIXMAP_QOI                                      (0)
+#endif
+
+#ifndef CONFIG_SGL_ASSET_PACK
+#define CONFIG_SGL_ASSET_PACK                                      (0)
+#endif
+
 #ifndef CONFIG_SGL_OBJ_USE_NAME
 #define CONFIG_SGL_OBJ_USE_NAME                                    (0)
 #endif
@@ -154,6 +262,14 @@ extern "C" {
 #   endif
 #endif
 
+#ifndef CONFIG_SGL_SLAB_SIZE
+#define CONFIG_SGL_SLAB_SIZE                                       (0)
+#endif
+
+#ifndef CONFIG_SGL_MM_TAG
+#define CONFIG_SGL_MM_TAG                                          (0)
+#endif
+
 #ifndef CONFIG_SGL_FONT_SONG23
 #define CONFIG_SGL_FONT_SONG23                                     (0)
 #endif
@@ -166,6 +282,35 @@ extern "C" {
 #define CONFIG_SGL_FONT_KAI33                                      (0)
 #endif
 
+#ifndef CONFIG_SGL_DRAW_SIMD
+#define CONFIG_SGL_DRAW_SIMD                                       (0)
+#endif
+
+#ifndef CONFIG_SGL_FLUSH_ASYNC
+#   define CONFIG_SGL_FLUSH_ASYNC                                  (0)
+#endif
+
+#ifndef CONFIG_SGL_PROFILER
+#   define CONFIG_SGL_PROFILER                                     (0)
+#endif
+
+#ifndef CONFIG_SGL_DRAW_THREADS
+#   define CONFIG_SGL_DRAW_THREADS                                 (1)
+#endif
+
+#if (CONFIG_SGL_DRAW_THREADS > 1) && (CONFIG_SGL_USE_FULL_FB || CONFIG_SGL_PROFILER || CONFIG_SGL_EXTERNAL_PIXMAP || CONFIG_SGL_TEXT_GLYPH_CACHE)
+#   error "CONFIG_SGL_DRAW_THREADS does not support CONFIG_SGL_USE_FULL_FB, CONFIG_SGL_PROFILER, CONFIG_SGL_EXTERNAL_PIXMAP and CONFIG_SGL_TEXT_GLYPH_CACHE"
+#endif
+
+#if (CONFIG_SGL_PROFILER)
+#   ifndef CONFIG_SGL_PROFILER_OBJ_MAX
+#       define CONFIG_SGL_PROFILER_OBJ_MAX                         (32)
+#   endif
+#   ifndef CONFIG_SGL_PROFILER_DIRTY_MAX
+#       define CONFIG_SGL_PROFILER_DIRTY_MAX                       (16)
+#   endif
+#endif
+
 #if !(defined(CONFIG_SGL_THEME_DARK) || defined(CONFIG_SGL_THEME_LIGHT))
 #   ifndef CONFIG_SGL_THEME_DEFAULT
 #   define CONFIG_SGL_THEME_DEFAULT                                (1)
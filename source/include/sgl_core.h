@@ -47,6 +47,10 @@ extern "C" {
 
 #if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
 #define  SGL_DIRTY_AREA_THRESHOLD          CONFIG_SGL_DIRTY_AREA_THRESHOLD
+/* the fixed cost of drawing a dirty area separately, in pixels */
+#define  SGL_DIRTY_AREA_MERGE_COST         (SGL_DIRTY_AREA_THRESHOLD * SGL_DIRTY_AREA_THRESHOLD / 4)
+/* the maximum number of dirty areas in a frame */
+#define  SGL_DIRTY_AREA_NUM_MAX            CONFIG_SGL_DIRTY_AREA_NUM_MAX
 #endif
 
 /* the ASCII offset of fonts */
@@ -227,8 +231,8 @@ typedef union {
  * @y:      y coordinate
  * @w:      width
  * @h:      height
- * @pitch:  bytes per line
- * @h_max:  maximum height
+ * @pitch:  pixels per line of buffer, it is larger than w if the surface is a part of framebuffer
+ * @size:   pixels of buffer
  */
 typedef struct sgl_surf {
     sgl_color_t *buffer;
@@ -236,6 +240,7 @@ typedef struct sgl_surf {
     int16_t      y;
     int16_t      w;
     int16_t      h;
+    int16_t      pitch;
     size_t       size;
 } sgl_surf_t;
 
@@ -244,12 +249,17 @@ typedef struct sgl_surf {
 * @brief This structure defines an image, with a bitmap pointing to the
 *        bitmap of the image, while specifying the width and height of the image
 *
-* @bitmap: point to image bitmap
+* @bitmap: point to image bitmap, if read is set, it is the position of the pixmap in the
+*          storage of read, NULL for position 0
 * @width: pixmap width
 * @height: pixmap height
-* @format: bitmap format 0: no compression, 1:
+* @format: bitmap format, SGL_PIXMAP_FORMAT_RAW: pixels of panel format, SGL_PIXMAP_FORMAT_QOI: QOI
+*          compressed RGBA, it needs CONFIG_SGL_PIXMAP_QOI
 * @read: read pixel map from external storage
 */
+#define  SGL_PIXMAP_FORMAT_RAW             (0)
+#define  SGL_PIXMAP_FORMAT_QOI             (1)
+
 typedef struct sgl_pixmap {
     const uint8_t *bitmap;
     uint32_t       width : 12;
@@ -262,6 +272,12 @@ typedef struct sgl_pixmap {
 } sgl_pixmap_t;
 
 
+#if (CONFIG_SGL_EXTERNAL_PIXMAP)
+/* position of an external pixmap in the storage of its read function */
+#define  SGL_PIXMAP_READ_BASE(pixmap)      ((uint32_t)(uintptr_t)(pixmap)->bitmap)
+#endif
+
+
 /**
  * @brief This structure defines an icon, with a bitmap pointing to the
  * @bitmap: point to icon bitmap
@@ -297,6 +313,39 @@ typedef struct sgl_font_table {
 } sgl_font_table_t;
 
 
+#if (CONFIG_SGL_TEXT_UTF8)
+/**
+* @brief A page of unicode index, it covers the 256 unicodes that have the same high byte
+*
+* @bits: bit map of the unicodes in the page, bit n of bits[w] is unicode (w * 32 + n)
+* @base: index in the font table of the first unicode at or after bits[w]
+*/
+typedef struct sgl_font_unicode_page {
+    const uint32_t bits[8];
+    const uint16_t base[8];
+} sgl_font_unicode_page_t;
+
+
+/**
+* @brief The unicode index of font, it is generated by tools/sgl_font_index.py from unicode list,
+*        so that the index of a character is found without searching the unicode list
+*
+* @range_start: first unicode of the longest contiguous run of unicode list
+* @range_len: number of unicodes in the run
+* @range_index: index in the font table of range_start
+* @page_map: page number of each high byte, 0xFF if no unicode in it, NULL if no pages
+* @pages: pages of the unicodes that are out of the run
+*/
+typedef struct sgl_font_unicode_index {
+    uint16_t range_start;
+    uint16_t range_len;
+    uint16_t range_index;
+    const uint8_t *page_map;
+    const sgl_font_unicode_page_t *pages;
+} sgl_font_unicode_index_t;
+#endif // !CONFIG_SGL_TEXT_UTF8
+
+
 /**
 * @brief A structure used to describe information about a font, Defining a font set requires
 *        the use of this structure to describe relevant information
@@ -306,6 +355,9 @@ typedef struct sgl_font_table {
 * @font_table_size: size of struct sgl_font_table
 * @font_height: height of font
 * @bpp: The anti aliasing level of the font
+* @unicode_list: sorted unicodes of the characters in the font table
+* @unicode_list_len: length of unicode list
+* @unicode_index: optional unicode index, NULL to search the unicode list
 */
 typedef struct sgl_font {
     const uint8_t  *bitmap;
@@ -316,6 +368,7 @@ typedef struct sgl_font {
 #if (CONFIG_SGL_TEXT_UTF8)
     const uint16_t *unicode_list;
     uint32_t unicode_list_len;
+    const sgl_font_unicode_index_t *unicode_index;
 #endif
 } sgl_font_t;
 
@@ -352,7 +405,10 @@ typedef struct sgl_font {
  * @v_layout: Flag indicating vertical layout should be applied to children (1 = enabled).
  * @clickable: Flag indicating the object can receive and process click/touch events (1 = clickable).
  * @movable: Flag indicating the object can be moved by user interaction (1 = movable).
+ * @opaque: Flag indicating the object fully covers its area, except the round corners of @radius (1 = opaque).
+ * @dirty_child: Flag indicating a descendant of the object is dirty, destroyed or needs init (1 = descend into children).
  * @margin: Signed margin value around the object, used in layout spacing calculations.
+ * @hit_seq: [Optional] Paint order of the object, the hit grid is sorted by it. Only included if CONFIG_SGL_EVENT_HIT_GRID is enabled.
  * @id: [Optional] Unique identifier for the object. Only included if CONFIG_SGL_USE_OBJ_ID is enabled.
  */
 typedef struct sgl_obj {
@@ -375,8 +431,12 @@ typedef struct sgl_obj {
     uint16_t           flexible : 1;
     uint16_t           invalid : 1;
     uint16_t           pressed : 1;
-    uint16_t           reserved : 1;
-    uint16_t           radius : 12;
+    uint16_t           opaque : 1;
+    uint16_t           dirty_child : 1;
+    uint16_t           radius : 11;
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+    uint16_t           hit_seq;
+#endif
 #if CONFIG_SGL_OBJ_USE_NAME
     const char         *name;
 #endif
@@ -418,6 +478,9 @@ typedef struct sgl_page {
  * @xres_virtual: x virtual resolution
  * @yres_virtual: y virtual resolution
  * @flush_area: flush area callback function pointer
+ * @copy_area: optional, move the pixels of area (x, y, w, h) on panel by (dx, dy), the source and
+ *             destination may overlap, it must be finished before the next flush_area starts.
+ *             It is used to scroll without redrawing, NULL if the panel can not copy pixels
  */
 typedef struct sgl_device_fb {
     void      *buffer[SGL_DRAW_BUFFER_MAX];
@@ -427,6 +490,7 @@ typedef struct sgl_device_fb {
     int16_t    xres_virtual;
     int16_t    yres_virtual;
     void       (*flush_area)(int16_t x, int16_t y, int16_t w, int16_t h, sgl_color_t *src);
+    void       (*copy_area)(int16_t x, int16_t y, int16_t w, int16_t h, int16_t dx, int16_t dy);
 } sgl_device_fb_t;
 
 
@@ -439,13 +503,32 @@ typedef struct sgl_device_log {
 } sgl_device_log_t;
 
 
+/**
+ * @brief node of draw list, the draw list keeps all objects of active page in drawing order
+ * @obj: object of node
+ * @area: copy of object area, it is read by drawing without touching the object
+ * @next: index of the first node after the children of object
+ */
+typedef struct sgl_draw_node {
+    sgl_obj_t            *obj;
+    sgl_area_t           area;
+    uint16_t             next;
+} sgl_draw_node_t;
+
+
 /* current context, page pointer, and dirty area */
 typedef struct sgl_context {
     sgl_page_t           *page;
     sgl_device_fb_t      fb_dev;
     sgl_device_log_t     log_dev;
     uint8_t              fb_swap;
-    uint8_t              tick_ms;
+    /* monotonic time and the time of last frame, ms, they wrap after 49 days */
+    volatile uint32_t    tick_ms;
+    uint32_t             frame_ms;
+#if (CONFIG_SGL_FLUSH_ASYNC)
+    /* set by sgl_flush_start(), cleared by driver, accessed with acquire and release */
+    uint8_t              flush_busy;
+#endif
 #if (CONFIG_SGL_DIRTY_AREA_THRESHOLD)
     uint16_t             dirty_num;
     sgl_area_t           *dirty;
@@ -455,6 +538,16 @@ typedef struct sgl_context {
 #if (CONFIG_SGL_EXTERNAL_PIXMAP)
     sgl_color_t          *pixmap_buff;
 #endif
+    /* pending scroll of one object, the pixels of view are moved before the frame is drawn */
+    sgl_obj_t            *scroll_obj;
+    sgl_area_t           scroll_view;
+    int16_t              scroll_dx;
+    int16_t              scroll_dy;
+    /* draw list of active page, it is rebuilt after objects are added, removed or reordered */
+    sgl_draw_node_t      *draw_list;
+    uint16_t             draw_num;
+    uint16_t             draw_cap;
+    bool                 draw_list_valid;
 } sgl_context_t;
 
 
@@ -470,6 +563,56 @@ extern sgl_context_t sgl_ctx;
 int sgl_device_fb_register(sgl_device_fb_t *fb_dev);
 
 
+/**
+ * @brief tell sgl that the transfer of last flush_area is finished
+ * @param none
+ * @return none
+ * @note when CONFIG_SGL_FLUSH_ASYNC is enabled, flush_area may return before the transfer is
+ *       finished, and the driver must call this function in DMA complete interrupt or in the
+ *       thread that does transfer, otherwise it does nothing
+ */
+static inline void sgl_flush_ready(void)
+{
+#if (CONFIG_SGL_FLUSH_ASYNC)
+    /* release, the reads of draw buffer by transfer are done before sgl sees it free */
+    __atomic_store_n(&sgl_ctx.flush_busy, 0, __ATOMIC_RELEASE);
+#endif
+}
+
+
+/**
+ * @brief mark the transfer of flush_area as in flight
+ * @param none
+ * @return none
+ * @note it is called by sgl_panel_flush_area() before flush_area, drivers do not call it
+ */
+static inline void sgl_flush_start(void)
+{
+#if (CONFIG_SGL_FLUSH_ASYNC)
+    /* release, the pixels of draw buffer are written before the transfer sees it busy */
+    __atomic_store_n(&sgl_ctx.flush_busy, 1, __ATOMIC_RELEASE);
+#endif
+}
+
+
+/**
+ * @brief wait until the transfer of last flush_area is finished
+ * @param none
+ * @return none
+ * @note call it before the content of draw buffer or panel is used by others
+ */
+static inline void sgl_flush_wait(void)
+{
+#if (CONFIG_SGL_FLUSH_ASYNC)
+    /* acquire, pairs with the release in sgl_flush_ready() */
+    while (__atomic_load_n(&sgl_ctx.flush_busy, __ATOMIC_ACQUIRE)) {
+        /* transfer is in flight */
+        sgl_cpu_relax();
+    }
+#endif
+}
+
+
 /**
  * @brief panel flush function
  * @param x [in] x coordinate
@@ -478,6 +621,7 @@ int sgl_device_fb_register(sgl_device_fb_t *fb_dev);
  * @param h [in] height
  * @param src [in] source color
  * @return none
+ * @note only one transfer is in flight, so it waits for the last transfer before starting
  */
 static inline void sgl_panel_flush_area(int16_t x, int16_t y, int16_t w, int16_t h, sgl_color_t *src)
 {
@@ -487,6 +631,11 @@ static inline void sgl_panel_flush_area(int16_t x, int16_t y, int16_t w, int16_t
         *dst = ((*dst << 8) & 0xFF00FF00) | ((*dst >> 8) & 0x00FF00FF);
         dst++;
     }
+#endif
+#if (CONFIG_SGL_FLUSH_ASYNC)
+    sgl_flush_wait();
+    /* set busy before calling, a synchronous driver may call sgl_flush_ready() in flush_area */
+    sgl_flush_start();
 #endif
     sgl_ctx.fb_dev.flush_area(x, y, w, h, src);
 }
@@ -564,11 +713,22 @@ static inline void sgl_log_stdout(const char *str)
 
 
 /**
- * @brief get tick milliseconds
+ * @brief get milliseconds since last frame
  * @param none
  * @return tick milliseconds
  */
-static inline uint8_t sgl_tick_get(void)
+static inline uint32_t sgl_tick_get(void)
+{
+    return sgl_ctx.tick_ms - sgl_ctx.frame_ms;
+}
+
+
+/**
+ * @brief get monotonic time of sgl
+ * @param none
+ * @return time in milliseconds, it wraps after 49 days
+ */
+static inline uint32_t sgl_tick_now(void)
 {
     return sgl_ctx.tick_ms;
 }
@@ -580,20 +740,32 @@ static inline uint8_t sgl_tick_get(void)
  * @return none
  * @note in general, you should call this function in the 1ms tick interrupt handler
  */
-static inline void sgl_tick_inc(uint8_t ms)
+static inline void sgl_tick_inc(uint32_t ms)
 {
     sgl_ctx.tick_ms += ms;
 }
 
 
 /**
- * @brief reset tick milliseconds
+ * @brief set monotonic time of sgl, it is used instead of sgl_tick_inc() if the host
+ *        has a clock, such as clock_gettime(CLOCK_MONOTONIC) on Linux
+ * @param ms time in milliseconds, it should never go back except wrapping
+ * @return none
+ */
+static inline void sgl_tick_set(uint32_t ms)
+{
+    sgl_ctx.tick_ms = ms;
+}
+
+
+/**
+ * @brief start a new frame, the milliseconds since last frame are 0 again
  * @param none
  * @return none
  */
 static inline void sgl_tick_reset(void)
 {
-    sgl_ctx.tick_ms = 0;
+    sgl_ctx.frame_ms = sgl_ctx.tick_ms;
 }
 
 
@@ -747,6 +919,22 @@ static inline size_t sgl_obj_get_child_count(sgl_obj_t *obj)
 }
 
 
+/**
+ * @brief mark all ancestors of object that they have a descendant to update
+ * @param obj point to object
+ * @return none
+ * @note the dirty area calculation only descends into objects that are marked
+ */
+static inline void sgl_obj_dirty_propagate(sgl_obj_t *obj)
+{
+    /* the parent of page is itself */
+    while (obj->parent != NULL && obj->parent != obj) {
+        obj = obj->parent;
+        obj->dirty_child = 1;
+    }
+}
+
+
 /**
  * @brief  Set the object to be destroyed
  * @param  obj: the object to set
@@ -758,6 +946,7 @@ static inline void sgl_obj_set_destroyed(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->destroyed = 1;
+    sgl_obj_dirty_propagate(obj);
 }
 
 
@@ -783,6 +972,7 @@ static inline void sgl_obj_set_dirty(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->dirty = 1;
+    sgl_obj_dirty_propagate(obj);
 }
 
 
@@ -819,6 +1009,7 @@ static inline void sgl_obj_needinit(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->needinit = 1;
+    sgl_obj_dirty_propagate(obj);
 }
 
 
@@ -867,6 +1058,8 @@ static inline void sgl_obj_set_visible(sgl_obj_t *obj)
 {
     SGL_ASSERT(obj != NULL);
     obj->hide = 0;
+    /* the changes of object and its children are skipped while it is hidden */
+    sgl_obj_dirty_propagate(obj);
 }
 
 
@@ -994,6 +1187,34 @@ static inline bool sgl_obj_is_flexible(sgl_obj_t *obj)
 }
 
 
+/**
+ * @brief set object opaque flag
+ * @param obj point to object
+ * @param opaque true if the object draws every pixel of its area with full alpha, the round
+ *        corners given by obj->radius are allowed
+ * @return none
+ * @note the objects under an opaque object are not drawn where it covers the whole slice, so
+ *       a widget must clear this flag when its style becomes transparent
+ */
+static inline void sgl_obj_set_opaque(sgl_obj_t *obj, bool opaque)
+{
+    SGL_ASSERT(obj != NULL);
+    obj->opaque = opaque ? 1 : 0;
+}
+
+
+/**
+ * @brief check object opaque flag
+ * @param obj point to object
+ * @return true or false
+ */
+static inline bool sgl_obj_is_opaque(sgl_obj_t *obj)
+{
+    SGL_ASSERT(obj != NULL);
+    return obj->opaque == 1 ? true : false;
+}
+
+
 /**
  * @brief set object clickable
  * @param obj point to object
@@ -1038,6 +1259,22 @@ static inline bool sgl_obj_is_movable(sgl_obj_t *obj)
 void sgl_obj_dirty_merge(sgl_obj_t *obj);
 
 
+/**
+ * @brief scroll the content of object by moving its pixels on panel
+ * @param obj point to object
+ * @param view area of object that is moved, its content must depend on the scroll offset only
+ *        and be drawn opaquely, for example the inner area of a textbox without border
+ * @param dx horizontal distance of content, positive means moving to right
+ * @param dy vertical distance of content, positive means moving down
+ * @return true if the scroll is accepted, then the caller should not set object dirty, the rest
+ *         of object area is redrawn by sgl. false if the caller should set object dirty itself
+ * @note only one object can scroll in a frame, the distances of same object and view are added.
+ *       The pixels are moved by CPU in full framebuffer mode or by copy_area of panel, if
+ *       something else is drawn over the view in the frame, the whole object is redrawn
+ */
+bool sgl_obj_scroll(sgl_obj_t *obj, sgl_area_t *view, int16_t dx, int16_t dy);
+
+
 /**
  * @brief update object area
  * @param obj point to object
@@ -1212,6 +1449,8 @@ void sgl_obj_set_pos_align_ref(sgl_obj_t *ref, sgl_obj_t *obj, sgl_align_type_t
  * @param width: width that you want to set
  * @param height: height that you want to set
  * @return none
+ * @note the object gets DRAW_INIT again, so that the state that depends on its size is
+ *       updated before it is drawn
  */
 static inline void sgl_obj_set_size(sgl_obj_t *obj, int16_t width, int16_t height)
 {
@@ -1221,6 +1460,7 @@ static inline void sgl_obj_set_size(sgl_obj_t *obj, int16_t width, int16_t heigh
 
     obj->coords.x2 = obj->coords.x1 + width - 1;
     obj->coords.y2 = obj->coords.y1 + height - 1;
+    sgl_obj_needinit(obj);
 }
 
 
@@ -1245,11 +1485,13 @@ static inline sgl_size_t sgl_obj_get_size(sgl_obj_t *obj)
  * @param obj point to object
  * @param width: width that you want to set
  * @return none
+ * @note the object gets DRAW_INIT again, such as the line breaks of text depend on the width
  */
 static inline void sgl_obj_set_width(sgl_obj_t *obj, int16_t width)
 {
     SGL_ASSERT(obj != NULL);
     obj->coords.x2 = obj->coords.x1 + width - 1;
+    sgl_obj_needinit(obj);
 }
 
 
@@ -1460,6 +1702,74 @@ static inline void sgl_area_init(sgl_area_t *area)
 }
 
 
+#if (CONFIG_SGL_EXTERNAL_PIXMAP && CONFIG_SGL_PIXMAP_CACHE)
+/**
+ * @brief counters of block cache of external pixmaps
+ * @hit: blocks that are found in cache
+ * @miss: blocks that are not found in cache, they are read with the following blocks
+ * @prefetch: blocks that are read ahead of a missed block
+ * @read_num: calls of read function of pixmaps
+ * @read_bytes: bytes that are read from external storage
+ */
+typedef struct sgl_pixmap_cache_stat {
+    uint32_t hit;
+    uint32_t miss;
+    uint32_t prefetch;
+    uint32_t read_num;
+    uint32_t read_bytes;
+} sgl_pixmap_cache_stat_t;
+
+
+/**
+ * @brief initialize block cache of external pixmaps
+ * @param none
+ * @return 0 on success, -1 on failure
+ */
+int sgl_pixmap_cache_init(void);
+
+
+/**
+ * @brief read bytes of external pixmap through block cache
+ * @param pixmap pixmap that has read function
+ * @param pos offset of bytes in pixmap
+ * @param size number of bytes, it is not larger than a row of panel
+ * @param buff buffer that bytes are copied into if they are in more than one block
+ * @return address of bytes, it is valid until next read
+ */
+const uint8_t* sgl_pixmap_cache_read(const sgl_pixmap_t *pixmap, uint32_t pos, size_t size, uint8_t *buff);
+
+
+/**
+ * @brief drop cached blocks of pixmap
+ * @param pixmap pixmap whose blocks are dropped, NULL to drop all blocks
+ * @return none
+ * @note call it if the content of external pixmap is changed or the pixmap is freed
+ */
+void sgl_pixmap_cache_clear(const sgl_pixmap_t *pixmap);
+
+
+/**
+ * @brief get counters of block cache of external pixmaps
+ * @param stat [out] counters of cache
+ * @return none
+ */
+void sgl_pixmap_cache_get_stat(sgl_pixmap_cache_stat_t *stat);
+#endif // !CONFIG_SGL_EXTERNAL_PIXMAP && CONFIG_SGL_PIXMAP_CACHE
+
+
+/**
+ * @brief check if a pixmap draws every pixel of its object with full alpha
+ * @param pixmap: pointer to pixmap, NULL means the object is filled with color
+ * @return true if the pixmap is opaque, false if it may have transparent pixels
+ * @note a compressed pixmap has alpha channel and is drawn only inside its own size, so the
+ *       object that holds it is not opaque
+ */
+static inline bool sgl_pixmap_is_opaque(const sgl_pixmap_t *pixmap)
+{
+    return pixmap == NULL || pixmap->format == SGL_PIXMAP_FORMAT_RAW;
+}
+
+
 /**
  * @brief get pixel of pixmap
  * @pixmap: pointe to pixmap
@@ -1476,8 +1786,13 @@ static inline sgl_color_t sgl_pixmap_get_pixel(const sgl_pixmap_t *pixmap, int16
 
 #if (CONFIG_SGL_EXTERNAL_PIXMAP)
     if (pixmap->read) {
-        pixmap->read(sgl_ctx.pixmap_buff, pos, 1);
+#if (CONFIG_SGL_PIXMAP_CACHE)
+        return *(const sgl_color_t*)sgl_pixmap_cache_read(pixmap, pos * sizeof(sgl_color_t), sizeof(sgl_color_t),
+                                                          (uint8_t*)sgl_ctx.pixmap_buff);
+#else
+        pixmap->read(sgl_ctx.pixmap_buff, SGL_PIXMAP_READ_BASE(pixmap) + pos * sizeof(sgl_color_t), sizeof(sgl_color_t));
         return *sgl_ctx.pixmap_buff;
+#endif
     }
 #endif
 
@@ -1503,8 +1818,13 @@ static inline sgl_color_t* sgl_pixmap_get_buf(const sgl_pixmap_t *pixmap, int16_
 #if (CONFIG_SGL_EXTERNAL_PIXMAP)
     SGL_ASSERT(size <= sgl_panel_resolution_width());
     if (pixmap->read) {
-        pixmap->read(sgl_ctx.pixmap_buff, pos * sizeof(sgl_color_t), size * sizeof(sgl_color_t));
+#if (CONFIG_SGL_PIXMAP_CACHE)
+        return (sgl_color_t*)sgl_pixmap_cache_read(pixmap, pos * sizeof(sgl_color_t), size * sizeof(sgl_color_t),
+                                                   (uint8_t*)sgl_ctx.pixmap_buff);
+#else
+        pixmap->read(sgl_ctx.pixmap_buff, SGL_PIXMAP_READ_BASE(pixmap) + pos * sizeof(sgl_color_t), size * sizeof(sgl_color_t));
         return sgl_ctx.pixmap_buff;
+#endif
     }
 #else
     SGL_UNUSED(size);
@@ -1535,6 +1855,21 @@ static inline bool sgl_surf_area_is_overlap(sgl_surf_t *surf, sgl_area_t *area)
 }
 
 
+/**
+ * @brief check two area is equal
+ * @param area_a area a
+ * @param area_b area b
+ * @return true or false, true means equal, false means not equal
+ * @note: this function is unsafe, you should check the area_a and area_b is not NULL by yourself
+ */
+static inline bool sgl_area_is_equal(sgl_area_t *area_a, sgl_area_t *area_b)
+{
+    SGL_ASSERT(area_a != NULL && area_b != NULL);
+    return area_a->x1 == area_b->x1 && area_a->y1 == area_b->y1
+        && area_a->x2 == area_b->x2 && area_a->y2 == area_b->y2;
+}
+
+
 /**
  * @brief check two area is overlap
  * @param area_a area a
@@ -1733,13 +2068,31 @@ sgl_pos_t sgl_get_text_pos(sgl_area_t *area, const sgl_font_t *font, const char
 sgl_pos_t sgl_get_icon_pos(sgl_area_t *area, const sgl_icon_pixmap_t *icon, int16_t offset, sgl_align_type_t type);
 
 
+/* nothing is pending, the host can sleep until an event is sent */
+#define  SGL_TASK_NEVER                    (UINT32_MAX)
+
+
 /**
- * @brief sgl task handle function
+ * @brief sgl task handle function, a frame is handled if SGL_SYSTEM_TICK_MS
+ *        milliseconds are passed since last frame
  * @param none
- * @return none
+ * @return milliseconds that the host can sleep before next call, see sgl_task_next_due()
  * @note this function should be called in main loop or timer or thread
  */
-void sgl_task_handle(void);
+uint32_t sgl_task_handle(void);
+
+
+/**
+ * @brief get milliseconds until sgl_task_handle() has something to do, it is the
+ *        time to next frame if an event is pending or something is to be drawn,
+ *        otherwise the time until the next animation is due
+ * @param none
+ * @return milliseconds that the host can sleep, 0 if the work is due now,
+ *         SGL_TASK_NEVER if nothing is pending
+ * @note an event that is sent while the host sleeps calls the hook that is registered
+ *       by sgl_event_wakeup_register(), so the host can stop sleeping
+ */
+uint32_t sgl_task_next_due(void);
 
 
 /**
@@ -144,11 +144,40 @@ typedef struct sgl_draw_icon {
  * @note if you want to check the area is overlap with surface, you can use this macro
  *       it will direct return if the area is not overlap with surface, otherwise, continue
  */
-#if (CONFIG_SGL_USE_FULL_FB)
-#define sgl_surf_clip_area_return(surf, rect, clip)         do {} while(0)
-#else
 #define sgl_surf_clip_area_return(surf, rect, clip)         if (!sgl_surf_clip(surf, rect, clip)) return
-#endif
+
+
+/**
+ * @brief fill a span of pixels with a color, it uses word wide stores
+ * @param dst: start of span
+ * @param len: number of pixels
+ * @param color: color of span
+ * @return none
+ */
+void sgl_draw_fill_span(sgl_color_t *dst, int32_t len, sgl_color_t color);
+
+
+/**
+ * @brief blend a span of pixels with a color
+ * @param dst: start of span
+ * @param len: number of pixels
+ * @param color: color of span
+ * @param alpha: alpha of color, the span is filled directly if it is SGL_ALPHA_MAX
+ * @return none
+ */
+void sgl_draw_blend_span(sgl_color_t *dst, int32_t len, sgl_color_t color, uint8_t alpha);
+
+
+/**
+ * @brief blend a span of pixels with a color and per-pixel coverage
+ * @param dst: start of span
+ * @param len: number of pixels
+ * @param color: color of span
+ * @param mask: coverage of every pixel, 0 is transparent and 255 is opaque
+ * @param alpha: global alpha, it is folded with coverage so every pixel is blended only once
+ * @return none
+ */
+void sgl_draw_blend_span_mask(sgl_color_t *dst, int32_t len, sgl_color_t color, const uint8_t *mask, uint8_t alpha);
 
 
 /**
@@ -161,7 +190,7 @@ typedef struct sgl_draw_icon {
  */
 static inline void sgl_surf_set_pixel(sgl_surf_t *surf, int16_t x, int16_t y, sgl_color_t color) 
 {
-    surf->buffer[y * surf->w + x] = color;
+    surf->buffer[y * surf->pitch + x] = color;
 }
 
 
@@ -175,7 +204,7 @@ static inline void sgl_surf_set_pixel(sgl_surf_t *surf, int16_t x, int16_t y, sg
  */
 static inline sgl_color_t* sgl_surf_get_buf(sgl_surf_t *surf, int16_t x, int16_t y)
 {
-    return &surf->buffer[y * surf->w + x];
+    return &surf->buffer[y * surf->pitch + x];
 }
 
 
@@ -189,7 +218,7 @@ static inline sgl_color_t* sgl_surf_get_buf(sgl_surf_t *surf, int16_t x, int16_t
  */
 static inline sgl_color_t sgl_surf_get_pixel(sgl_surf_t *surf, int16_t x, int16_t y) 
 {
-    return surf->buffer[y * surf->w + x];
+    return surf->buffer[y * surf->pitch + x];
 }
 
 
@@ -204,11 +233,7 @@ static inline sgl_color_t sgl_surf_get_pixel(sgl_surf_t *surf, int16_t x, int16_
  */
 static inline void sgl_surf_hline(sgl_surf_t *surf, int16_t y, int16_t x1, int16_t x2, sgl_color_t color) 
 {
-    sgl_color_t *dst = surf->buffer + y * surf->w + x1;
-    for (int16_t i = x1; i <= x2; i++) {
-        *dst = color;
-        dst++;
-    }
+    sgl_draw_fill_span(surf->buffer + y * surf->pitch + x1, x2 - x1 + 1, color);
 }
 
 
@@ -223,10 +248,10 @@ static inline void sgl_surf_hline(sgl_surf_t *surf, int16_t y, int16_t x1, int16
  */
 static inline void sgl_surf_vline(sgl_surf_t *surf, int16_t x, int16_t y1, int16_t y2, sgl_color_t color) 
 {
-    sgl_color_t *dst = surf->buffer + y1 * surf->w + x;
+    sgl_color_t *dst = surf->buffer + y1 * surf->pitch + x;
     for (int16_t i = y1; i <= y2; i++) {
         *dst = color;
-        dst += surf->w;
+        dst += surf->pitch;
     }
 }
 
@@ -269,6 +294,39 @@ void sgl_draw_fill_rect_with_border(sgl_surf_t *surf, sgl_area_t *area, sgl_area
 void sgl_draw_fill_rect_pixmap(sgl_surf_t *surf, sgl_area_t *area, sgl_rect_t *rect, const sgl_pixmap_t *pixmap, uint8_t alpha);
 
 
+#if (CONFIG_SGL_PIXMAP_QOI)
+/**
+ * @brief layout of the bitmap of a pixmap of SGL_PIXMAP_FORMAT_QOI, all fields are little endian
+ *
+ *   0: magic SGL_QOI_MAGIC
+ *   4: width, uint16_t
+ *   6: height, uint16_t
+ *   8: chunk shift, the codec state is reset at every (1 << shift) rows
+ *   9: 3 bytes reserved
+ *  12: uint32_t offset of every chunk from start of bitmap
+ *   n: QOI ops of chunks, a run does not cross a chunk
+ *
+ * it is made by tools/sgl_qoi_encode.py
+ */
+#define  SGL_QOI_MAGIC                                      (0x696F7173)
+#define  SGL_QOI_HEADER_SHIFT                               (8)
+#define  SGL_QOI_HEADER_SIZE                                (12)
+
+
+/**
+ * @brief fill the clip of surface with a QOI pixmap, the pixels out of pixmap are not drawn
+ * @param surf surface
+ * @param clip area of surface to fill
+ * @param ox x coordinate of pixmap
+ * @param oy y coordinate of pixmap
+ * @param pixmap pixmap of SGL_PIXMAP_FORMAT_QOI
+ * @param alpha alpha of pixmap
+ * @return none
+ */
+void sgl_draw_fill_rect_qoi(sgl_surf_t *surf, sgl_area_t *clip, int16_t ox, int16_t oy, const sgl_pixmap_t *pixmap, uint8_t alpha);
+#endif
+
+
 /**
  * @brief fill a round rectangle with alpha
  * @param surf point to surface
@@ -407,6 +465,28 @@ void sgl_draw_icon( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, sg
 void sgl_draw_character( sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, uint32_t ch_index, sgl_color_t color, uint8_t alpha, const sgl_font_t *font);
 
 
+#if (CONFIG_SGL_TEXT_GLYPH_CACHE)
+/**
+ * @brief free all decoded glyphs of glyph cache
+ * @param none
+ * @return none
+ * @note glyphs are decoded again when they are drawn, call it if the heap is needed by others
+ */
+void sgl_glyph_cache_clear(void);
+#endif
+
+
+/**
+ * @brief drop the cached data of a font, such as decoded glyphs and glyph extent
+ * @param font font whose data is dropped, NULL to drop the data of all fonts
+ * @return none
+ * @note the caches are keyed by the address of font, call it before a font struct is filled
+ *       with another font or after the data of font is freed, it must not be called while
+ *       a frame is drawn
+ */
+void sgl_font_invalidate(const sgl_font_t *font);
+
+
 /**
  * @brief Draw a string on the surface with alpha blending
  * @param surf Pointer to the surface where the string will be drawn
@@ -439,6 +519,79 @@ void sgl_draw_string(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, c
 void sgl_draw_string_mult_line(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const char *str, sgl_color_t color, uint8_t alpha, const sgl_font_t *font, uint8_t edge_margin, uint8_t line_margin);
 
 
+/**
+ * @brief number of line marks in text lines index, a mark is kept for every (1 << shift) lines
+ */
+#define  SGL_TEXT_LINES_MARK_NUM                   (32)
+#define  SGL_TEXT_LINES_MARK_WRAP                  (0x80000000u)
+
+
+/**
+ * @brief line break index of a multiple lines text, it is rebuilt only when the text, font,
+ *        width or edge margin is changed, so that drawing starts from the first visible line
+ * @text: text of the index, NULL if the index is invalid
+ * @length: bytes of text when the index is built, the index is not used if it is changed
+ * @font: font of the index
+ * @width: a character is wrapped if its right side plus edge margin is larger than width
+ * @edge_margin: margin between characters and the edges
+ * @shift: mark[i] is the start of line (i << shift)
+ * @count: number of lines
+ * @mark: byte offset of the start of line, SGL_TEXT_LINES_MARK_WRAP is set if the line is started by wrap
+ */
+typedef struct sgl_text_lines {
+    const char       *text;
+    uint32_t         length;
+    const sgl_font_t *font;
+    int16_t          width;
+    uint8_t          edge_margin;
+    uint8_t          shift;
+    uint32_t         count;
+    uint32_t         mark[SGL_TEXT_LINES_MARK_NUM];
+} sgl_text_lines_t;
+
+
+/**
+ * @brief invalidate line break index, it is rebuilt by next sgl_text_lines_update()
+ * @param lines line break index
+ * @return none
+ * @note call it if the content of text is changed without changing the text pointer
+ */
+static inline void sgl_text_lines_invalidate(sgl_text_lines_t *lines)
+{
+    lines->text = NULL;
+}
+
+
+/**
+ * @brief update line break index of a multiple lines text, it is rebuilt only if any parameter
+ *        or the length of text is changed
+ * @param lines line break index
+ * @param str text
+ * @param font font of text
+ * @param width a character is wrapped if its right side plus edge margin is larger than width
+ * @param edge_margin margin between characters and the edges
+ * @return number of lines of text
+ */
+uint32_t sgl_text_lines_update(sgl_text_lines_t *lines, const char *str, const sgl_font_t *font, int16_t width, uint8_t edge_margin);
+
+
+/**
+ * @brief Draw the visible lines of a multiple lines text which has line break index
+ * @param surf Pointer to the surface where the string will be drawn
+ * @param area Pointer to the area where the string will be drawn
+ * @param x X coordinate of the top-left corner of the text
+ * @param y Y coordinate of the top-left corner of the text
+ * @param lines line break index, it should be updated by sgl_text_lines_update()
+ * @param color Foreground color of the string
+ * @param alpha Alpha value for blending
+ * @param line_margin Margin between lines
+ * @return none
+ * @note if the length of text is changed in place after the index is built, the marks may point
+ *       past the end of text, so the lines are walked from the start of text instead
+ */
+void sgl_draw_text_lines(sgl_surf_t *surf, sgl_area_t *area, int16_t x, int16_t y, const sgl_text_lines_t *lines, sgl_color_t color, uint8_t alpha, uint8_t line_margin);
+
+
 /**
  * @brief draw a ring on surface with alpha
  * @param surf: pointer of surface
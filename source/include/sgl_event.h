@@ -39,6 +39,7 @@ extern "C" {
 /* Forward declaration of sgl_obj and sgl_page*/
 struct sgl_obj;
 struct sgl_page;
+struct sgl_area;
 
 
 /**
@@ -89,6 +90,19 @@ typedef struct sgl_event {
 } sgl_event_t;
 
 
+/**
+ * @brief counters of event queue
+ * @pushed: events that are pushed into queue
+ * @coalesced: motion events that are merged into the last motion event of queue
+ * @dropped: events that are dropped because the queue is full
+ */
+typedef struct sgl_event_stat {
+    uint32_t         pushed;
+    uint32_t         coalesced;
+    uint32_t         dropped;
+} sgl_event_stat_t;
+
+
 /**
  * @brief Initialize the event queue
  * @param none
@@ -99,13 +113,43 @@ int sgl_event_queue_init(void);
 
 
 /**
- * @brief Push an event into the event queue
+ * @brief Push an event into the event queue, it is safe to be called from interrupts
+ *        and threads while sgl_event_task() pops
  * @param event The event to be pushed
- * @return 0 on success, -1 on failure
+ * @return none
+ * @note a motion event is coalesced into the last one if it is a motion event too, motion
+ *       events are dropped if the queue is almost full, so the last slots are kept for press
+ *       and release events, they are only dropped if the whole queue is full of them
  */
 void sgl_event_queue_push(sgl_event_t event);
 
 
+/**
+ * @brief Check whether any event is waiting to be handled
+ * @param none
+ * @return true if the event queue is not empty
+ */
+bool sgl_event_is_pending(void);
+
+
+/**
+ * @brief Register the hook that is called after an event is pushed
+ * @param wakeup hook function, NULL to remove it
+ * @return none
+ * @note the hook is called in the context of the sender, such as an interrupt handler,
+ *       so it should only wake up the thread that calls sgl_task_handle()
+ */
+void sgl_event_wakeup_register(void (*wakeup)(void));
+
+
+/**
+ * @brief Get counters of event queue
+ * @param stat [out] counters of event queue
+ * @return none
+ */
+void sgl_event_get_stat(sgl_event_stat_t *stat);
+
+
 /**
  * @brief Handle the position event
  * @param pos The position to be handled
@@ -145,6 +189,49 @@ static inline void sgl_event_send_obj(struct sgl_obj *obj, sgl_event_type_t type
 }
 
 
+#if (CONFIG_SGL_EVENT_HIT_GRID)
+/**
+ * @brief alloc the cells of hit grid, it is called by sgl_init()
+ * @param none
+ * @return 0 on success, -1 on failure
+ */
+int sgl_event_hit_init(void);
+
+
+/**
+ * @brief rebuild hit grid with the drawn objects of a page, it is called when the page is loaded
+ * @param page page object
+ * @return none
+ */
+void sgl_event_hit_reset(struct sgl_obj *page);
+
+
+/**
+ * @brief update the cells of an object when its area is calculated again
+ * @param obj object, its area and invalid flag are not updated yet
+ * @param area new area of object, NULL if the object is out of its parent
+ * @return none
+ */
+void sgl_event_hit_update(struct sgl_obj *obj, struct sgl_area *area);
+
+
+/**
+ * @brief remove an object from hit grid, it is called before the object is freed
+ * @param obj object
+ * @return none
+ */
+void sgl_event_hit_remove(struct sgl_obj *obj);
+
+
+/**
+ * @brief sort the objects of every cell in paint order, it is called when the order is changed
+ * @param none
+ * @return none
+ */
+void sgl_event_hit_sort(void);
+#endif // !CONFIG_SGL_EVENT_HIT_GRID
+
+
 /**
  * @brief All event task in SGL, this function will traverse all elements in the event queue, 
  *        respond to each element with an event, so that all events will trigger and point to the 
@@ -61,6 +61,24 @@ extern "C" {
 int32_t sgl_sin(int16_t angle);
 
 
+/**
+ * @brief Count the number of set bits in a 32 bits value
+ * @param value: 32 bits value
+ * @return number of set bits
+ */
+static inline uint32_t sgl_popcount(uint32_t value)
+{
+#if defined(__GNUC__)
+    return (uint32_t)__builtin_popcount(value);
+#else
+    value = value - ((value >> 1) & 0x55555555u);
+    value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+    value = (value + (value >> 4)) & 0x0F0F0F0Fu;
+    return (value * 0x01010101u) >> 24;
+#endif
+}
+
+
 /**
  * @brief Calculate the cos of an angle
  * @param angle: Angle in degrees such 0-359
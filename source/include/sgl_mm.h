@@ -33,23 +33,75 @@ extern "C" {
 #endif
 
 /**
- * @brief  memory monitor info
+ * @brief  number of buckets of allocation latency, bucket n counts the allocations
+ *         that take [2^(n-1), 2^n) ticks of the memory clock, the last one counts all longer ones
+ */
+#define SGL_MM_LATENCY_NUM          (16)
+
+
+/**
+ * @brief  owner of heap memory, it is given when memory is allocated and
+ *         bytes in use are counted for every tag if CONFIG_SGL_MM_TAG is 1
+ */
+typedef enum sgl_mm_tag {
+    SGL_MM_TAG_OTHER = 0,       /* memory of user and allocations without tag */
+    SGL_MM_TAG_OBJ,             /* objects, pages and widgets */
+    SGL_MM_TAG_ANIM,            /* animations */
+    SGL_MM_TAG_FONT,            /* glyph cache */
+    SGL_MM_TAG_IMAGE,           /* pixmap and image buffers */
+    SGL_MM_TAG_DRAW,            /* draw buffers, dirty areas and draw list */
+    SGL_MM_TAG_EVENT,           /* hit grid of touch events */
+    SGL_MM_TAG_NUM,
+} sgl_mm_tag_t;
+
+
+/**
+ * @brief  memory monitor info, sizes are the usable bytes of blocks, without the
+ *         head of allocator, so a block may be a bit larger than requested size
  * @total_size: total size of memory
  * @free_size: free size of memory
  * @used_size: used size of memory
  * @used_rate: used rate of memory:
  *             |  8 bit  |  8 bit |          
  *             |   int   |   dec  |
+ * @peak_size: the most bytes that are used at the same time
+ * @max_free_block: size of the largest free block, a larger request fails even if free_size is enough
+ * @free_block_num: number of free blocks, many small free blocks mean a fragmented heap,
+ *                  max_free_block and free_block_num are 0 if the heap algorithm can not walk the heap
+ * @alloc_num: number of allocations that succeed, realloc included
+ * @fail_num: number of allocations that fail
+ * @latency: histogram of allocation latency, see SGL_MM_LATENCY_NUM,
+ *           all allocations are in bucket 0 if no clock is registered
  */
 typedef struct sgl_mm_monitor {
     size_t  total_size;
     size_t  free_size;
     size_t  used_size;
     size_t  used_rate;
+    size_t  peak_size;
+    size_t  max_free_block;
+    size_t  free_block_num;
+    size_t  alloc_num;
+    size_t  fail_num;
+    uint32_t latency[SGL_MM_LATENCY_NUM];
 
 } sgl_mm_monitor_t;
 
 
+/**
+ * @brief  memory of a tag
+ * @used_size: bytes of blocks that the tag uses
+ * @peak_size: the most bytes that the tag uses at the same time
+ * @block_num: number of blocks that the tag uses
+ */
+typedef struct sgl_mm_tag_monitor {
+    size_t  used_size;
+    size_t  peak_size;
+    size_t  block_num;
+
+} sgl_mm_tag_monitor_t;
+
+
 /**
  * @brief  initialize memory pool
  * @param  mem_start  start address of memory pool
@@ -67,29 +119,31 @@ void sgl_mm_add_pool(void *mem_start, size_t len);
 
 
 /**
- * @brief  memory alloc, the function is unsafe, you should ensure that 
+ * @brief  memory alloc with owner tag, the function is unsafe, you should ensure that 
  *         the requested size is smaller than the free size of memory
  * 
  * @param  size   request size of memory
+ * @param  tag    owner of memory
  * 
  * @return point to request memory address
 */
-void* sgl_malloc(size_t size);
+void* sgl_malloc_tag(size_t size, sgl_mm_tag_t tag);
 
 
 /**
- * @brief  memory realloc, the function is unsafe, you should ensure that 
+ * @brief  memory realloc with owner tag, the function is unsafe, you should ensure that 
  *         the requested size is smaller than the free size of memory
  * @param  p      the pointer of request size of memory
  * @param  size   request size of memory
+ * @param  tag    owner of memory
  */
-void* sgl_realloc(void *p, size_t size);
+void* sgl_realloc_tag(void *p, size_t size, sgl_mm_tag_t tag);
 
 
 /**
  * @brief  memory free
  * 
- * @param  p  the pointer of request size of memory
+ * @param  p the pointer of request size of memory
  * 
  * @return none
 */
@@ -97,7 +151,42 @@ void sgl_free(void *p);
 
 
 /**
- * @brief  get memory monitor info
+ * @brief  get owner tag of memory
+ * @param  p  the pointer of memory, it can be NULL
+ * @return owner tag, SGL_MM_TAG_OTHER if p is NULL or CONFIG_SGL_MM_TAG is 0
+ */
+sgl_mm_tag_t sgl_mm_get_tag(void *p);
+
+
+/**
+ * @brief  memory alloc, the function is unsafe, you should ensure that 
+ *         the requested size is smaller than the free size of memory
+ * 
+ * @param  size   request size of memory
+ * 
+ * @return point to request memory address
+*/
+static inline void* sgl_malloc(size_t size)
+{
+    return sgl_malloc_tag(size, SGL_MM_TAG_OTHER);
+}
+
+
+/**
+ * @brief  memory realloc, the memory keeps its owner tag, the function is unsafe,
+ *         you should ensure that the requested size is smaller than the free size of memory
+ * @param  p      the pointer of request size of memory
+ * @param  size   request size of memory
+ */
+static inline void* sgl_realloc(void *p, size_t size)
+{
+    return sgl_realloc_tag(p, size, sgl_mm_get_tag(p));
+}
+
+
+/**
+ * @brief  get memory monitor info, it walks the free blocks of heap, so it
+ *         takes time in proportion to the number of free blocks
  * 
  * @param  none
  * @return memory monitor info
@@ -105,6 +194,86 @@ void sgl_free(void *p);
 sgl_mm_monitor_t sgl_mm_get_monitor(void);
 
 
+/**
+ * @brief  get memory of a tag
+ * @param  tag  owner tag
+ * @param  mon  memory of tag
+ * @return 0 if success, -1 if tag is invalid or CONFIG_SGL_MM_TAG is 0
+ */
+int sgl_mm_get_tag_monitor(sgl_mm_tag_t tag, sgl_mm_tag_monitor_t *mon);
+
+
+/**
+ * @brief register the clock of allocation latency
+ * @param clock function that returns a free running counter, such as a cycle counter
+ *              or a microsecond timer, the latency is measured in its ticks
+ * @return none
+ * @note the clock is read twice for every allocation, so it should be cheap
+ */
+void sgl_mm_clock_register(uint32_t (*clock)(void));
+
+
+#if (CONFIG_SGL_SLAB_SIZE)
+/**
+ * @brief  occupancy of one slab class, all chunks of a class have the same size
+ * @size: size of chunk
+ * @page_num: number of pages that are given to the class, a page is never given back
+ * @total: number of chunks in the pages of class
+ * @used: number of chunks in use
+ * @peak: the most chunks that are in use at the same time
+ * @fallback: number of allocations that are taken from heap, because there is no free page
+ */
+typedef struct sgl_slab_monitor {
+    size_t  size;
+    size_t  page_num;
+    size_t  total;
+    size_t  used;
+    size_t  peak;
+    size_t  fallback;
+} sgl_slab_monitor_t;
+
+
+/**
+ * @brief  alloc a fixed size chunk for object or animation from the slab class of its size,
+ *         the chunk is taken from heap if the size is too large or the slab memory is used up
+ * @param  size  request size of memory
+ * @param  tag   owner tag of memory if it is taken from heap
+ * @return point to request memory address, NULL if out of memory
+ */
+void* sgl_slab_alloc(size_t size, sgl_mm_tag_t tag);
+
+
+/**
+ * @brief  free memory that is allocated by sgl_slab_alloc() or sgl_malloc()
+ * @param  p  the pointer of memory
+ * @return none
+ */
+void sgl_slab_free(void *p);
+
+
+/**
+ * @brief  get occupancy of a slab class
+ * @param  index  index of class, classes are created in order of first allocation
+ * @param  mon    the occupancy of class
+ * @return 0 if success, -1 if there is no such class
+ */
+int sgl_slab_get_monitor(int index, sgl_slab_monitor_t *mon);
+
+#else
+
+static inline void* sgl_slab_alloc(size_t size, sgl_mm_tag_t tag)
+{
+    return sgl_malloc_tag(size, tag);
+}
+
+static inline void sgl_slab_free(void *p)
+{
+    sgl_free(p);
+}
+
+#endif // !CONFIG_SGL_SLAB_SIZE
+
+
 #ifdef __cplusplus
 }
 #endif
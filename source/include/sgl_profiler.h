@@ -0,0 +1,151 @@
+/* source/include/sgl_profiler.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL  
+ * Document reference link: docs directory
+ * 
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SGL_PROFILER_H__
+#define __SGL_PROFILER_H__
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+
+#include <sgl_cfgfix.h>
+#include <sgl_core.h>
+
+
+#if (CONFIG_SGL_PROFILER)
+
+/**
+ * @brief the statistics of one object in a frame
+ * @obj: object pointer, it is only used as a key, the object may be freed already
+ * @name: object name, only available when CONFIG_SGL_OBJ_USE_NAME is enabled
+ * @draw_cnt: times that construct_fn of object is called for drawing, one per slice
+ * @time_us: total time that construct_fn of object takes
+ */
+typedef struct sgl_profiler_obj {
+    const sgl_obj_t      *obj;
+#if (CONFIG_SGL_OBJ_USE_NAME)
+    const char           *name;
+#endif
+    uint32_t             draw_cnt;
+    uint32_t             time_us;
+} sgl_profiler_obj_t;
+
+
+/**
+ * @brief the statistics of one frame
+ * @frame: frame sequence number, it only counts the frames that draw something
+ * @total_us: time of sgl_task_handle()
+ * @calc_us: time of calculating dirty area, include the DRAW_INIT of objects
+ * @draw_us: time of all construct_fn
+ * @flush_us: time of all flush_area calls
+ * @flush_bytes: bytes handed to flush_area
+ * @slice_cnt: number of slices that are drawn and flushed
+ * @dirty_cnt: number of dirty areas, only CONFIG_SGL_PROFILER_DIRTY_MAX of them are recorded
+ * @dirty: recorded dirty areas
+ * @obj_cnt: number of recorded objects, the objects beyond CONFIG_SGL_PROFILER_OBJ_MAX only count into draw_us
+ * @obj: recorded objects
+ */
+typedef struct sgl_profiler_frame {
+    uint32_t             frame;
+    uint32_t             total_us;
+    uint32_t             calc_us;
+    uint32_t             draw_us;
+    uint32_t             flush_us;
+    uint32_t             flush_bytes;
+    uint16_t             slice_cnt;
+    uint16_t             dirty_cnt;
+    sgl_area_t           dirty[CONFIG_SGL_PROFILER_DIRTY_MAX];
+    uint16_t             obj_cnt;
+    sgl_profiler_obj_t   obj[CONFIG_SGL_PROFILER_OBJ_MAX];
+} sgl_profiler_frame_t;
+
+
+/**
+ * @brief register the microsecond clock of profiler
+ * @param clock_us function that returns a free running microsecond counter
+ * @return none
+ * @note the profiler records counts only if no clock is registered, all times are 0
+ */
+void sgl_profiler_clock_register(uint32_t (*clock_us)(void));
+
+
+/**
+ * @brief get the statistics of last drawn frame
+ * @param none
+ * @return pointer of frame statistics, it is valid until next frame is drawn
+ */
+const sgl_profiler_frame_t* sgl_profiler_get_frame(void);
+
+
+/**
+ * @brief dump the statistics of last drawn frame by log device
+ * @param none
+ * @return none
+ */
+void sgl_profiler_dump(void);
+
+
+/* the following functions are used internally by sgl library */
+void sgl_profiler_frame_begin(void);
+void sgl_profiler_frame_end(bool drawn);
+void sgl_profiler_calc_begin(void);
+void sgl_profiler_calc_end(void);
+void sgl_profiler_dirty(const sgl_area_t *dirty);
+uint32_t sgl_profiler_obj_begin(void);
+void sgl_profiler_obj_end(const sgl_obj_t *obj, uint32_t start);
+uint32_t sgl_profiler_flush_begin(void);
+void sgl_profiler_flush_end(uint32_t start, int16_t w, int16_t h);
+
+
+#define SGL_PROFILER_FRAME_BEGIN()                  sgl_profiler_frame_begin()
+#define SGL_PROFILER_FRAME_END(drawn)               sgl_profiler_frame_end(drawn)
+#define SGL_PROFILER_CALC_BEGIN()                   sgl_profiler_calc_begin()
+#define SGL_PROFILER_CALC_END()                     sgl_profiler_calc_end()
+#define SGL_PROFILER_DIRTY(dirty)                   sgl_profiler_dirty(dirty)
+#define SGL_PROFILER_OBJ_BEGIN(t)                   uint32_t t = sgl_profiler_obj_begin()
+#define SGL_PROFILER_OBJ_END(obj, t)                sgl_profiler_obj_end(obj, t)
+#define SGL_PROFILER_FLUSH_BEGIN(t)                 uint32_t t = sgl_profiler_flush_begin()
+#define SGL_PROFILER_FLUSH_END(t, w, h)             sgl_profiler_flush_end(t, w, h)
+
+#else
+
+#define SGL_PROFILER_FRAME_BEGIN()                  do {} while(0)
+#define SGL_PROFILER_FRAME_END(drawn)               do {} while(0)
+#define SGL_PROFILER_CALC_BEGIN()                   do {} while(0)
+#define SGL_PROFILER_CALC_END()                     do {} while(0)
+#define SGL_PROFILER_DIRTY(dirty)                   do {} while(0)
+#define SGL_PROFILER_OBJ_BEGIN(t)                   do {} while(0)
+#define SGL_PROFILER_OBJ_END(obj, t)                do {} while(0)
+#define SGL_PROFILER_FLUSH_BEGIN(t)                 do {} while(0)
+#define SGL_PROFILER_FLUSH_END(t, w, h)             do {} while(0)
+
+#endif // !CONFIG_SGL_PROFILER
+
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif // !__SGL_PROFILER_H__
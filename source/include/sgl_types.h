@@ -72,7 +72,7 @@ extern "C" {
 #define SGL_POS_INVALID                         (0xefff)
 #define SGL_POS_MAX                             (8192)
 #define SGL_POS_MIN                             (-8192)
-#define SGL_RADIUS_INVALID                      (0xFFF)
+#define SGL_RADIUS_INVALID                      (0x7FF)
 
 #define SGL_AREA_MAX                            {.x1 = SGL_POS_MIN, .y1 = SGL_POS_MIN, .x2 = SGL_POS_MAX, .y2 = SGL_POS_MAX}
 #define SGL_AREA_INVALID                        {.x1 = SGL_POS_MAX, .y1 = SGL_POS_MAX, .x2 = SGL_POS_MIN, .y2 = SGL_POS_MIN}
@@ -143,6 +143,20 @@ extern "C" {
 #endif
 
 
+/* hint to cpu in a busy wait loop, it also stops the compiler from caching the polled value */
+#ifndef sgl_cpu_relax
+#if defined(__GNUC__) && (defined(__i386__) || defined(__x86_64__))
+#  define sgl_cpu_relax()                       __builtin_ia32_pause()
+#elif defined(__GNUC__) && (defined(__arm__) || defined(__aarch64__))
+#  define sgl_cpu_relax()                       __asm__ volatile("yield" ::: "memory")
+#elif defined(__GNUC__)
+#  define sgl_cpu_relax()                       __asm__ volatile("" ::: "memory")
+#else
+#  define sgl_cpu_relax()                       do {} while (0)
+#endif
+#endif
+
+
 #define  sgl_check_ptr_break(ptr)               if (unlikely((ptr) == NULL)) { SGL_LOG_ERROR("Function: %s, Line: %d, "#ptr" is NULL", __func__, __LINE__); return;}
 #define  sgl_check_ptr_return(ptr, r)           if (unlikely((ptr) == NULL)) { SGL_LOG_ERROR("Function: %s, Line: %d, "#ptr" is NULL", __func__, __LINE__); return (r);}
 
@@ -1138,6 +1138,33 @@ lwmem_get_size_ex(lwmem_t* lwobj, void* ptr) {
     return len;
 }
 
+/**
+ * \brief           Get size of largest free block and number of free blocks
+ * \param[in]       lwobj: LwMEM instance. Set to `NULL` to use default instance
+ * \param[out]      largest: Size of largest free block for user in units of bytes
+ * \param[out]      num: Number of free blocks
+ */
+void
+lwmem_get_free_ex(lwmem_t* lwobj, size_t* largest, size_t* num) {
+    lwmem_block_t* curr;
+    size_t max = 0, cnt = 0;
+
+    lwobj = LWMEM_GET_LWOBJ(lwobj);
+    LWMEM_PROTECT(lwobj);
+    /* End blocks of regions have zero size and are skipped */
+    for (curr = lwobj->start_block.next; curr != NULL; curr = curr->next) {
+        if (curr->size > LWMEM_BLOCK_META_SIZE) {
+            ++cnt;
+            if (curr->size - LWMEM_BLOCK_META_SIZE > max) {
+                max = curr->size - LWMEM_BLOCK_META_SIZE;
+            }
+        }
+    }
+    LWMEM_UNPROTECT(lwobj);
+    *largest = max;
+    *num = cnt;
+}
+
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
 #if LWMEM_CFG_ENABLE_STATS || __DOXYGEN__
@@ -1282,6 +1309,17 @@ lwmem_get_size(void* ptr) {
     return lwmem_get_size_ex(NULL, ptr);
 }
 
+/**
+ * \note            This is a wrapper for \ref lwmem_get_free_ex function.
+ *                      It operates in default LwMEM instance
+ * \param[out]      largest: Size of largest free block for user in units of bytes
+ * \param[out]      num: Number of free blocks
+ */
+void
+lwmem_get_free(size_t* largest, size_t* num) {
+    lwmem_get_free_ex(NULL, largest, num);
+}
+
 #endif /* LWMEM_CFG_FULL || __DOXYGEN__ */
 
 /* Part of library used ONLY for LWMEM_DEV purposes */
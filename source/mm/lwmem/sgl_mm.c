@@ -27,13 +27,7 @@
 #include "lwmem.h"
 #include <sgl_log.h>
 #include <sgl_cfgfix.h>
-
-
-static sgl_mm_monitor_t mem = {
-    .total_size = 0,
-    .free_size = 0,
-    .used_size = 0,
-};
+#include "../sgl_mm_stat.h"
 
 
 /**
@@ -49,7 +43,7 @@ void sgl_mm_init(void *mem_start, size_t len)
     };
 
     lwmem_assignmem(lwmem);
-    mem.total_size += len;
+    sgl_mm_stat_pool(len);
 }
 
 
@@ -66,49 +60,60 @@ void sgl_mm_add_pool(void *mem_start, size_t len)
     };
 
     lwmem_assignmem(lwmem);
-    mem.total_size += len;
+    sgl_mm_stat_pool(len);
 }
 
 
 /**
- * @brief  memory alloc, the function is unsafe, you should ensure that 
+ * @brief  memory alloc with owner tag, the function is unsafe, you should ensure that 
  *         the requested size is smaller than the free size of memory
  * 
  * @param  size   request size of memory
+ * @param  tag    owner of memory
  * 
  * @return point to request memory address
 */
-void* sgl_malloc(size_t size)
+void* sgl_malloc_tag(size_t size, sgl_mm_tag_t tag)
 {
-    void *ret = lwmem_malloc(size);
-    if(ret == NULL) {
+    uint32_t start = sgl_mm_stat_start();
+    void *block = lwmem_malloc(size + SGL_MM_HEAD_SIZE);
+    if(block == NULL) {
         SGL_LOG_ERROR("out of memory");
+        sgl_mm_stat_fail();
         return NULL;
     }
 
-    mem.used_size += lwmem_get_size(ret);
-
-    return ret;
+    return sgl_mm_stat_add(block, lwmem_get_size(block), tag, start);
 }
 
 
 /**
- * @brief  memory realloc, the function is unsafe, you should ensure that 
+ * @brief  memory realloc with owner tag, the function is unsafe, you should ensure that 
  *         the requested size is smaller than the free size of memory
  * @param  p      the pointer of request size of memory
  * @param  size   request size of memory
+ * @param  tag    owner of memory
  */
-void* sgl_realloc(void *p, size_t size)
+void* sgl_realloc_tag(void *p, size_t size, sgl_mm_tag_t tag)
 {
-    void *ret = lwmem_realloc(p, size);
+    uint32_t start = sgl_mm_stat_start();
+    void *block = p != NULL ? sgl_mm_stat_block(p) : NULL;
+    size_t old_size = p != NULL ? lwmem_get_size(block) : 0;
+    sgl_mm_tag_t old_tag = p != NULL ? sgl_mm_stat_tag(block) : SGL_MM_TAG_OTHER;
+
+    void *ret = lwmem_realloc(block, size + SGL_MM_HEAD_SIZE);
     if(ret == NULL) {
         SGL_LOG_ERROR("out of memory");
+        sgl_mm_stat_fail();
         return NULL;
     }
 
-    mem.used_size += size;
+    /* the old block is kept if realloc fails, so it is uncounted here */
+    if (p != NULL) {
+        sgl_mm_stat_sub(old_size, old_tag);
+    }
 
-    return ret;
+    return sgl_mm_stat_add(ret, lwmem_get_size(ret), tag, start);
 }
 
 
@@ -121,17 +126,19 @@ void* sgl_realloc(void *p, size_t size)
 */
 void sgl_free(void *p)
 {
-    mem.used_size -= lwmem_get_size(p);
-    lwmem_free(p);
+    void *block;
+
+    if (p == NULL) {
+        return;
+    }
+
+    block = sgl_mm_stat_block(p);
+    sgl_mm_stat_sub(lwmem_get_size(block), sgl_mm_stat_tag(block));
+    lwmem_free(block);
 }
 
 
-sgl_mm_monitor_t sgl_mm_get_monitor(void)
+void sgl_mm_free_blocks(size_t *largest, size_t *num)
 {
-    int integer = (mem.used_size * 100) / mem.total_size;
-    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
-    mem.used_rate = integer << 8 | decimal;
-    mem.free_size = mem.total_size - mem.used_size;
-    
-    return mem;
+    lwmem_get_free(largest, num);
 }
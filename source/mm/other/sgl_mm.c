@@ -28,12 +28,22 @@
 #include <sgl_cfgfix.h>
 #include <stdlib.h>
 #include <string.h>
+#include "../sgl_mm_stat.h"
 
-static sgl_mm_monitor_t mem = {
-    .total_size = 0,
-    .free_size = 0,
-    .used_size = 0,
-};
+
+/* the strictest alignment that libc gives to a block */
+#if defined(__STDC_VERSION__) && (__STDC_VERSION__ >= 201112L)
+#include <stddef.h>
+#define  SGL_MM_ALIGN                  (_Alignof(max_align_t))
+#else
+#define  SGL_MM_ALIGN                  (2 * sizeof(size_t))
+#endif
+
+/* libc does not give the size of block, so it is kept in front of block, it is padded so that
+ * the size, the owner tag and the user memory behind them keep the alignment of libc
+ */
+#define  SGL_MM_SIZE_HEAD              ((sizeof(size_t) + SGL_MM_HEAD_SIZE + SGL_MM_ALIGN - 1) / SGL_MM_ALIGN \
+                                        * SGL_MM_ALIGN - SGL_MM_HEAD_SIZE)
 
 
 /**
@@ -43,7 +53,7 @@ static sgl_mm_monitor_t mem = {
  */
 void sgl_mm_init(void *mem_start, size_t len)
 {
-    mem.total_size += len;
+    sgl_mm_stat_pool(len);
 }
 
 
@@ -54,36 +64,72 @@ void sgl_mm_init(void *mem_start, size_t len)
  */
 void sgl_mm_add_pool(void *mem_start, size_t len)
 {
-    
-    mem.total_size += len;
+    sgl_mm_stat_pool(len);
 }
 
 
 /**
- * @brief  memory alloc, the function is unsafe, you should ensure that 
+ * @brief  memory alloc with owner tag, the function is unsafe, you should ensure that 
  *         the requested size is smaller than the free size of memory
  * 
  * @param  size   request size of memory
+ * @param  tag    owner of memory
  * 
  * @return point to request memory address
 */
-void* sgl_malloc(size_t size)
+void* sgl_malloc_tag(size_t size, sgl_mm_tag_t tag)
 {
-    void *p = malloc(size);
+    uint32_t start = sgl_mm_stat_start();
+    size_t *head = malloc(SGL_MM_SIZE_HEAD + SGL_MM_HEAD_SIZE + size);
+    void *p;
+
+    if(head == NULL) {
+        SGL_LOG_ERROR("out of memory");
+        sgl_mm_stat_fail();
+        return NULL;
+    }
+
+    *head = SGL_MM_HEAD_SIZE + size;
+    p = sgl_mm_stat_add((uint8_t*)head + SGL_MM_SIZE_HEAD, *head, tag, start);
     memset(p, 0, size);
     return p;
 }
 
 
 /**
- * @brief  memory realloc, the function is unsafe, you should ensure that 
+ * @brief  memory realloc with owner tag, the function is unsafe, you should ensure that 
  *         the requested size is smaller than the free size of memory
  * @param  p      the pointer of request size of memory
  * @param  size   request size of memory
+ * @param  tag    owner of memory
  */
-void* sgl_realloc(void *p, size_t size)
+void* sgl_realloc_tag(void *p, size_t size, sgl_mm_tag_t tag)
 {
-    return realloc(p, size);
+    uint32_t start = sgl_mm_stat_start();
+    size_t *head = NULL;
+    size_t old_size = 0;
+    sgl_mm_tag_t old_tag = SGL_MM_TAG_OTHER;
+
+    if (p != NULL) {
+        head = (size_t*)((uint8_t*)sgl_mm_stat_block(p) - SGL_MM_SIZE_HEAD);
+        old_size = *head;
+        old_tag = sgl_mm_stat_tag(sgl_mm_stat_block(p));
+    }
+
+    head = realloc(head, SGL_MM_SIZE_HEAD + SGL_MM_HEAD_SIZE + size);
+    if(head == NULL) {
+        SGL_LOG_ERROR("out of memory");
+        sgl_mm_stat_fail();
+        return NULL;
+    }
+
+    /* the old block is kept if realloc fails, so it is uncounted here */
+    if (p != NULL) {
+        sgl_mm_stat_sub(old_size, old_tag);
+    }
+
+    *head = SGL_MM_HEAD_SIZE + size;
+    return sgl_mm_stat_add((uint8_t*)head + SGL_MM_SIZE_HEAD, *head, tag, start);
 }
 
 
@@ -96,17 +142,23 @@ void* sgl_realloc(void *p, size_t size)
 */
 void sgl_free(void *p)
 {
-    //mem.used_size -= ;
-    free(p);
+    void *block;
+    size_t *head;
+
+    if (p == NULL) {
+        return;
+    }
+
+    block = sgl_mm_stat_block(p);
+    head = (size_t*)((uint8_t*)block - SGL_MM_SIZE_HEAD);
+    sgl_mm_stat_sub(*head, sgl_mm_stat_tag(block));
+    free(head);
 }
 
 
-sgl_mm_monitor_t sgl_mm_get_monitor(void)
+void sgl_mm_free_blocks(size_t *largest, size_t *num)
 {
-    int integer = (mem.used_size * 100) / mem.total_size;
-    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
-    mem.used_rate = integer << 8 | decimal;
-    mem.free_size = mem.total_size - mem.used_size;
-
-    return mem;
+    /* libc can not be walked */
+    *largest = 0;
+    *num = 0;
 }
@@ -0,0 +1,177 @@
+/* source/mm/sgl_mm_stat.c
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include <sgl_mm.h>
+#include <sgl_cfgfix.h>
+#include "sgl_mm_stat.h"
+
+
+static uint32_t (*mem_clock)(void) = NULL;
+static sgl_mm_monitor_t mem = {
+    .total_size = 0,
+    .free_size = 0,
+    .used_size = 0,
+};
+
+#if (CONFIG_SGL_MM_TAG)
+static sgl_mm_tag_monitor_t mem_tag[SGL_MM_TAG_NUM];
+#endif
+
+
+void sgl_mm_stat_pool(size_t len)
+{
+    mem.total_size += len;
+}
+
+
+uint32_t sgl_mm_stat_start(void)
+{
+    return mem_clock != NULL ? mem_clock() : 0;
+}
+
+
+void* sgl_mm_stat_add(void *block, size_t size, sgl_mm_tag_t tag, uint32_t start)
+{
+    uint32_t ticks = mem_clock != NULL ? mem_clock() - start : 0;
+    int bucket = 0;
+
+    /* bucket is the bit length of ticks */
+    while (ticks != 0 && bucket < SGL_MM_LATENCY_NUM - 1) {
+        ticks >>= 1;
+        bucket ++;
+    }
+    mem.latency[bucket] ++;
+    mem.alloc_num ++;
+
+    mem.used_size += size;
+    if (mem.used_size > mem.peak_size) {
+        mem.peak_size = mem.used_size;
+    }
+
+#if (CONFIG_SGL_MM_TAG)
+    if ((unsigned)tag >= SGL_MM_TAG_NUM) {
+        tag = SGL_MM_TAG_OTHER;
+    }
+    mem_tag[tag].used_size += size;
+    mem_tag[tag].block_num ++;
+    if (mem_tag[tag].used_size > mem_tag[tag].peak_size) {
+        mem_tag[tag].peak_size = mem_tag[tag].used_size;
+    }
+    *(uint8_t*)block = (uint8_t)tag;
+#else
+    (void)tag;
+#endif
+
+    return (uint8_t*)block + SGL_MM_HEAD_SIZE;
+}
+
+
+void sgl_mm_stat_sub(size_t size, sgl_mm_tag_t tag)
+{
+    mem.used_size -= size;
+
+#if (CONFIG_SGL_MM_TAG)
+    mem_tag[tag].used_size -= size;
+    mem_tag[tag].block_num --;
+#else
+    (void)tag;
+#endif
+}
+
+
+void sgl_mm_stat_fail(void)
+{
+    mem.fail_num ++;
+}
+
+
+/**
+ * @brief  get owner tag of memory
+ * @param  p  the pointer of memory, it can be NULL
+ * @return owner tag, SGL_MM_TAG_OTHER if p is NULL or CONFIG_SGL_MM_TAG is 0
+ */
+sgl_mm_tag_t sgl_mm_get_tag(void *p)
+{
+    if (p == NULL) {
+        return SGL_MM_TAG_OTHER;
+    }
+
+    return sgl_mm_stat_tag(sgl_mm_stat_block(p));
+}
+
+
+/**
+ * @brief  get memory monitor info, it walks the free blocks of heap, so it
+ *         takes time in proportion to the number of free blocks
+ * 
+ * @param  none
+ * @return memory monitor info
+ */
+sgl_mm_monitor_t sgl_mm_get_monitor(void)
+{
+    int integer = (mem.used_size * 100) / mem.total_size;
+    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
+    mem.used_rate = integer << 8 | decimal;
+    mem.free_size = mem.total_size - mem.used_size;
+    sgl_mm_free_blocks(&mem.max_free_block, &mem.free_block_num);
+
+    return mem;
+}
+
+
+/**
+ * @brief  get memory of a tag
+ * @param  tag  owner tag
+ * @param  mon  memory of tag
+ * @return 0 if success, -1 if tag is invalid or CONFIG_SGL_MM_TAG is 0
+ */
+int sgl_mm_get_tag_monitor(sgl_mm_tag_t tag, sgl_mm_tag_monitor_t *mon)
+{
+#if (CONFIG_SGL_MM_TAG)
+    if ((unsigned)tag >= SGL_MM_TAG_NUM || mon == NULL) {
+        return -1;
+    }
+
+    *mon = mem_tag[tag];
+    return 0;
+#else
+    (void)tag;
+    (void)mon;
+    return -1;
+#endif
+}
+
+
+/**
+ * @brief register the clock of allocation latency
+ * @param clock function that returns a free running counter, such as a cycle counter
+ *              or a microsecond timer, the latency is measured in its ticks
+ * @return none
+ * @note the clock is read twice for every allocation, so it should be cheap
+ */
+void sgl_mm_clock_register(uint32_t (*clock)(void))
+{
+    mem_clock = clock;
+}
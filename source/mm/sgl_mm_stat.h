@@ -0,0 +1,116 @@
+/* source/mm/sgl_mm_stat.h
+ *
+ * MIT License
+ *
+ * Copyright(c) 2023-present All contributors of SGL
+ * Document reference link: docs directory
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef __SGL_MM_STAT_H__
+#define __SGL_MM_STAT_H__
+
+
+#include <stdint.h>
+#include <sgl_mm.h>
+#include <sgl_cfgfix.h>
+
+
+/* every block keeps its owner tag in front of user memory, 8 bytes keep the alignment of block */
+#if (CONFIG_SGL_MM_TAG)
+#define  SGL_MM_HEAD_SIZE              (8)
+#else
+#define  SGL_MM_HEAD_SIZE              (0)
+#endif
+
+
+/**
+ * @brief  get the block of user memory
+ * @param  p  the pointer of user memory
+ * @return the block that is given by heap algorithm
+ */
+static inline void* sgl_mm_stat_block(void *p)
+{
+    return (uint8_t*)p - SGL_MM_HEAD_SIZE;
+}
+
+
+/**
+ * @brief  get owner tag of block
+ * @param  block  the block that is given by heap algorithm
+ * @return owner tag
+ */
+static inline sgl_mm_tag_t sgl_mm_stat_tag(void *block)
+{
+#if (CONFIG_SGL_MM_TAG)
+    return (sgl_mm_tag_t)(*(uint8_t*)block);
+#else
+    (void)block;
+    return SGL_MM_TAG_OTHER;
+#endif
+}
+
+
+/**
+ * @brief  add memory pool to total size
+ * @param  len  length of memory pool
+ */
+void sgl_mm_stat_pool(size_t len);
+
+
+/**
+ * @brief  read clock before allocation
+ * @return ticks of memory clock, 0 if no clock is registered
+ */
+uint32_t sgl_mm_stat_start(void);
+
+
+/**
+ * @brief  count a new block and its allocation latency, the owner tag is written into block
+ * @param  block  the block that is given by heap algorithm
+ * @param  size   usable size of block
+ * @param  tag    owner tag
+ * @param  start  ticks that are returned by sgl_mm_stat_start()
+ * @return the pointer of user memory
+ */
+void* sgl_mm_stat_add(void *block, size_t size, sgl_mm_tag_t tag, uint32_t start);
+
+
+/**
+ * @brief  uncount a block that is freed or moved by realloc
+ * @param  size  usable size of block
+ * @param  tag   owner tag of block
+ */
+void sgl_mm_stat_sub(size_t size, sgl_mm_tag_t tag);
+
+
+/**
+ * @brief  count a failed allocation
+ */
+void sgl_mm_stat_fail(void);
+
+
+/**
+ * @brief  walk free blocks of heap, it is implemented by every heap algorithm
+ * @param  largest  size of the largest free block
+ * @param  num      number of free blocks
+ */
+void sgl_mm_free_blocks(size_t *largest, size_t *num);
+
+
+#endif // !__SGL_MM_STAT_H__
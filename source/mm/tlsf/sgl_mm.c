@@ -27,14 +27,16 @@
 #include <sgl_mm.h>
 #include <sgl_log.h>
 #include <sgl_cfgfix.h>
+#include "../sgl_mm_stat.h"
+
+
+/* pools that are walked for free blocks, more pools are still used for allocation */
+#define  SGL_MM_POOL_MAX               (4)
 
 
 static tlsf_t mem_tlsf;
-static sgl_mm_monitor_t mem = {
-    .total_size = 0,
-    .free_size = 0,
-    .used_size = 0,
-};
+static pool_t mem_pool[SGL_MM_POOL_MAX];
+static int mem_pool_num = 0;
 
 
 /**
@@ -45,7 +47,8 @@ static sgl_mm_monitor_t mem = {
 void sgl_mm_init(void *mem_start, size_t len)
 {
     mem_tlsf = tlsf_create_with_pool(mem_start, len);
-    mem.total_size += len;
+    mem_pool[mem_pool_num ++] = tlsf_get_pool(mem_tlsf);
+    sgl_mm_stat_pool(len);
 }
 
 
@@ -56,49 +59,65 @@ void sgl_mm_init(void *mem_start, size_t len)
  */
 void sgl_mm_add_pool(void *mem_start, size_t len)
 {
-    tlsf_add_pool(mem_tlsf, mem_start, len);
-    mem.total_size += len;
+    pool_t pool = tlsf_add_pool(mem_tlsf, mem_start, len);
+
+    if (pool != NULL && mem_pool_num < SGL_MM_POOL_MAX) {
+        mem_pool[mem_pool_num ++] = pool;
+    }
+    sgl_mm_stat_pool(len);
 }
 
 
 /**
- * @brief  memory alloc, the function is unsafe, you should ensure that 
+ * @brief  memory alloc with owner tag, the function is unsafe, you should ensure that 
  *         the requested size is smaller than the free size of memory
  * 
  * @param  size   request size of memory
+ * @param  tag    owner of memory
  * 
  * @return point to request memory address
 */
-void* sgl_malloc(size_t size)
+void* sgl_malloc_tag(size_t size, sgl_mm_tag_t tag)
 {
-    void *ret = tlsf_malloc(mem_tlsf, size);
-    if(ret == NULL) {
+    uint32_t start = sgl_mm_stat_start();
+    void *block = tlsf_malloc(mem_tlsf, size + SGL_MM_HEAD_SIZE);
+    if(block == NULL) {
         SGL_LOG_ERROR("out of memory");
+        sgl_mm_stat_fail();
         return NULL;
     }
 
-    mem.used_size += size;
-    return ret;
+    return sgl_mm_stat_add(block, tlsf_block_size(block), tag, start);
 }
 
 
 /**
- * @brief  memory realloc, the function is unsafe, you should ensure that 
+ * @brief  memory realloc with owner tag, the function is unsafe, you should ensure that 
  *         the requested size is smaller than the free size of memory
  * @param  p      the pointer of request size of memory
  * @param  size   request size of memory
+ * @param  tag    owner of memory
  */
-void* sgl_realloc(void *p, size_t size)
+void* sgl_realloc_tag(void *p, size_t size, sgl_mm_tag_t tag)
 {
-    void *ret = tlsf_realloc(mem_tlsf, p, size);
+    uint32_t start = sgl_mm_stat_start();
+    void *block = p != NULL ? sgl_mm_stat_block(p) : NULL;
+    size_t old_size = p != NULL ? tlsf_block_size(block) : 0;
+    sgl_mm_tag_t old_tag = p != NULL ? sgl_mm_stat_tag(block) : SGL_MM_TAG_OTHER;
+
+    void *ret = tlsf_realloc(mem_tlsf, block, size + SGL_MM_HEAD_SIZE);
     if(ret == NULL) {
         SGL_LOG_ERROR("out of memory");
+        sgl_mm_stat_fail();
         return NULL;
     }
 
-    mem.used_size += size;
+    /* the old block is kept if realloc fails, so it is uncounted here */
+    if (p != NULL) {
+        sgl_mm_stat_sub(old_size, old_tag);
+    }
 
-    return ret;
+    return sgl_mm_stat_add(ret, tlsf_block_size(ret), tag, start);
 }
 
 
@@ -111,18 +130,40 @@ void* sgl_realloc(void *p, size_t size)
 */
 void sgl_free(void *p)
 {
-    mem.used_size -= tlsf_block_size(p);
+    void *block;
+
+    if (p == NULL) {
+        return;
+    }
+
+    block = sgl_mm_stat_block(p);
+    sgl_mm_stat_sub(tlsf_block_size(block), sgl_mm_stat_tag(block));
+    tlsf_free(mem_tlsf, block);
+}
+
 
-    tlsf_free(mem_tlsf, p);
+static void sgl_mm_free_walker(void *ptr, size_t size, int used, void *user)
+{
+    size_t *info = (size_t*)user;
+
+    (void)ptr;
+    if (!used) {
+        if (size > info[0]) {
+            info[0] = size;
+        }
+        info[1] ++;
+    }
 }
 
 
-sgl_mm_monitor_t sgl_mm_get_monitor(void)
+void sgl_mm_free_blocks(size_t *largest, size_t *num)
 {
-    int integer = (mem.used_size * 100) / mem.total_size;
-    int decimal = (mem.used_size * 10000) / mem.total_size - (integer * 100);
-    mem.used_rate = integer << 8 | decimal;
-    mem.free_size = mem.total_size - mem.used_size;
+    size_t info[2] = {0, 0};
+
+    for (int i = 0; i < mem_pool_num; i++) {
+        tlsf_walk_pool(mem_pool[i], sgl_mm_free_walker, info);
+    }
 
-    return mem;
+    *largest = info[0];
+    *num = info[1];
 }
@@ -32,6 +32,8 @@
 #include <sgl_misc.h>
 #include <sgl_types.h>
 #include <sgl_font.h>
+#include <sgl_profiler.h>
+#include <sgl_asset.h>
 #include "widgets/line/sgl_line.h"
 #include "widgets/rectangle/sgl_rectangle.h"
 #include "widgets/circle/sgl_circle.h"
@@ -41,18 +41,19 @@ static void sgl_2dball_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
         sgl_area_t clip;
         sgl_color_t *buf = NULL;
 
-        ball->cx = (ball->obj.coords.x1 + ball->obj.coords.x2) / 2;
-        ball->cy = (ball->obj.coords.y1 + ball->obj.coords.y2) / 2;
+        /* the center is a local, slices of the object may be drawn in parallel */
+        int16_t cx = (ball->obj.coords.x1 + ball->obj.coords.x2) / 2;
+        int16_t cy = (ball->obj.coords.y1 + ball->obj.coords.y2) / 2;
 
         if (!sgl_surf_clip(surf, &obj->area, &clip)) {
             return;
         }
 
         sgl_area_t c_rect = {
-            .x1 = ball->cx - ball->radius,
-            .x2 = ball->cx + ball->radius,
-            .y1 = ball->cy - ball->radius,
-            .y2 = ball->cy + ball->radius
+            .x1 = cx - ball->radius,
+            .x2 = cx + ball->radius,
+            .y1 = cy - ball->radius,
+            .y2 = cy + ball->radius
         };
         if (!sgl_area_selfclip(&clip, &c_rect)) {
             return;
@@ -64,15 +65,15 @@ static void sgl_2dball_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
         int ds_alpha = SGL_ALPHA_MIN;
 
         for (int y = clip.y1; y <= clip.y2; y++) {
-            y2 = sgl_pow2(y - ball->cy);
+            y2 = sgl_pow2(y - cy);
             buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
 
             for (int x = clip.x1; x <= clip.x2; x++, buf++) {
-                real_r2 = sgl_pow2(x - ball->cx) + y2;
+                real_r2 = sgl_pow2(x - cx) + y2;
                 ds_alpha = real_r2 * SGL_ALPHA_NUM / r2;
 
                 if (real_r2 >= r2_edge) {
-                    if(x > ball->cx)
+                    if(x > cx)
                         break;
                     continue;
                 }
@@ -102,7 +103,7 @@ static void sgl_2dball_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_2dball_create(sgl_obj_t* parent)
 {
-    sgl_2dball_t *ball = sgl_malloc(sizeof(sgl_2dball_t));
+    sgl_2dball_t *ball = sgl_slab_alloc(sizeof(sgl_2dball_t), SGL_MM_TAG_OBJ);
     if(ball == NULL) {
         SGL_LOG_ERROR("sgl_2dball_create: malloc failed");
         return NULL;
@@ -37,22 +37,27 @@ static void sgl_arc_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
 {
     sgl_arc_t *arc = (sgl_arc_t*)obj;
     int16_t tb_angle = 0;
+    int16_t cx = (obj->coords.x2 + obj->coords.x1) / 2;
+    int16_t cy = (obj->coords.y2 + obj->coords.y1) / 2;
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        arc->desc.cx = (obj->coords.x2 + obj->coords.x1) / 2;
-        arc->desc.cy = (obj->coords.y2 + obj->coords.y1) / 2;
+        /* the center is set in a copy, slices of the object may be drawn in parallel */
+        sgl_draw_arc_t desc = arc->desc;
 
-        if(arc->desc.start_angle == 0 && arc->desc.end_angle == 360) {
-            sgl_draw_fill_ring(surf, &arc->obj.area, arc->desc.cx, arc->desc.cy, arc->desc.radius_in, arc->desc.radius_out, arc->desc.color, arc->desc.alpha);
+        desc.cx = cx;
+        desc.cy = cy;
+
+        if(desc.start_angle == 0 && desc.end_angle == 360) {
+            sgl_draw_fill_ring(surf, &arc->obj.area, desc.cx, desc.cy, desc.radius_in, desc.radius_out, desc.color, desc.alpha);
         }
         else {
-            sgl_draw_fill_arc(surf, &arc->obj.area, &arc->desc);
+            sgl_draw_fill_arc(surf, &arc->obj.area, &desc);
         }
     }
     else if(evt->type == SGL_EVENT_PRESSED ||
         evt->type == SGL_EVENT_MOVE_DOWN || evt->type == SGL_EVENT_MOVE_UP || evt->type == SGL_EVENT_MOVE_LEFT || evt->type == SGL_EVENT_MOVE_RIGHT
     ) {
-        tb_angle = sgl_atan2_angle(evt->pos.x - arc->desc.cx, evt->pos.y - arc->desc.cy);
+        tb_angle = sgl_atan2_angle(evt->pos.x - cx, evt->pos.y - cy);
         tb_angle = 360 - tb_angle;
         if ((tb_angle != arc->desc.end_angle) && tb_angle >= 0 && tb_angle <= 360) {
             arc->desc.end_angle = tb_angle;
@@ -86,7 +91,7 @@ static void sgl_arc_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
  */
 sgl_obj_t* sgl_arc_create(sgl_obj_t* parent)
 {
-    sgl_arc_t *arc = sgl_malloc(sizeof(sgl_arc_t));
+    sgl_arc_t *arc = sgl_slab_alloc(sizeof(sgl_arc_t), SGL_MM_TAG_OBJ);
     if(arc == NULL) {
         SGL_LOG_ERROR("sgl_arc_create: malloc failed");
         return NULL;
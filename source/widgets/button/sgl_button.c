@@ -97,7 +97,7 @@ static void sgl_button_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_button_create(sgl_obj_t* parent)
 {
-    sgl_button_t *button = sgl_malloc(sizeof(sgl_button_t));
+    sgl_button_t *button = sgl_slab_alloc(sizeof(sgl_button_t), SGL_MM_TAG_OBJ);
     if(button == NULL) {
         SGL_LOG_ERROR("sgl_button_create: malloc failed");
         return NULL;
@@ -119,6 +119,7 @@ sgl_obj_t* sgl_button_create(sgl_obj_t* parent)
     button->rect.border_color = SGL_THEME_BORDER_COLOR;
     button->rect.pixmap = NULL;
     button->rect.radius = 0;
+    sgl_obj_set_opaque(obj, button->rect.alpha == SGL_ALPHA_MAX);
 
     button->text = NULL;
     button->text_color = SGL_THEME_TEXT_COLOR;
@@ -83,6 +83,7 @@ static inline void sgl_button_set_alpha(sgl_obj_t *obj, uint8_t alpha)
 {
     sgl_button_t *button = (sgl_button_t*)obj;
     button->rect.alpha = alpha;
+    sgl_obj_set_opaque(obj, alpha == SGL_ALPHA_MAX && sgl_pixmap_is_opaque(button->rect.pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -122,6 +123,7 @@ static inline void sgl_button_set_pixmap(sgl_obj_t *obj, const sgl_pixmap_t *pix
 {
     sgl_button_t *button = (sgl_button_t*)obj;
     button->rect.pixmap = pixmap;
+    sgl_obj_set_opaque(obj, button->rect.alpha == SGL_ALPHA_MAX && sgl_pixmap_is_opaque(pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -119,23 +119,14 @@ static void sgl_checkbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
     SGL_ASSERT(checkbox->font != NULL);
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        if(checkbox->status) {
-            checkbox->icon = &checked_icon;
-        }
-        else {
-            checkbox->icon = &unchecked_icon;
-        }
-
-        if (checkbox->icon) {
-            text_x = checkbox->icon->width + 2;
-        }
+        /* the icon is a local, slices of the object may be drawn in parallel */
+        const sgl_icon_pixmap_t *icon = checkbox->status ? &checked_icon : &unchecked_icon;
 
+        text_x = icon->width + 2;
         align_pos = sgl_get_text_pos(&obj->coords, checkbox->font, checkbox->text, text_x, SGL_ALIGN_CENTER);
 
-        if (checkbox->icon) {
-            icon_y = ((obj->coords.y2 - obj->coords.y1) - (checkbox->icon->height)) / 2 + 1;
-            sgl_draw_icon(surf, &obj->area, align_pos.x, obj->coords.y1 + icon_y, checkbox->color, checkbox->alpha, checkbox->icon);
-        }
+        icon_y = ((obj->coords.y2 - obj->coords.y1) - (icon->height)) / 2 + 1;
+        sgl_draw_icon(surf, &obj->area, align_pos.x, obj->coords.y1 + icon_y, checkbox->color, checkbox->alpha, icon);
 
         sgl_draw_string(surf, &obj->area, align_pos.x + text_x, align_pos.y, checkbox->text, checkbox->color, checkbox->alpha, checkbox->font);
     }
@@ -167,7 +158,7 @@ static void sgl_checkbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
  */
 sgl_obj_t* sgl_checkbox_create(sgl_obj_t* parent)
 {
-    sgl_checkbox_t *checkbox = sgl_malloc(sizeof(sgl_checkbox_t));
+    sgl_checkbox_t *checkbox = sgl_slab_alloc(sizeof(sgl_checkbox_t), SGL_MM_TAG_OBJ);
     if(checkbox == NULL) {
         SGL_LOG_ERROR("sgl_checkbox_create: malloc failed");
         return NULL;
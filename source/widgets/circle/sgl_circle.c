@@ -45,10 +45,12 @@ static void sgl_circle_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
     sgl_circle_t *circle = (sgl_circle_t*)obj;
     
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        circle->desc.cx = (circle->obj.coords.x1 + circle->obj.coords.x2) / 2;
-        circle->desc.cy = (circle->obj.coords.y1 + circle->obj.coords.y2) / 2;
+        /* the center is set in a copy, slices of the object may be drawn in parallel */
+        sgl_draw_circle_t desc = circle->desc;
 
-        sgl_draw_circle(surf, &obj->area, &circle->desc);
+        desc.cx = (circle->obj.coords.x1 + circle->obj.coords.x2) / 2;
+        desc.cy = (circle->obj.coords.y1 + circle->obj.coords.y2) / 2;
+        sgl_draw_circle(surf, &obj->area, &desc);
     }
     else if(evt->type == SGL_EVENT_DRAW_INIT) {
         if(circle->desc.radius == -1) {
@@ -70,7 +72,7 @@ static void sgl_circle_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_circle_create(sgl_obj_t* parent)
 {
-    sgl_circle_t *circle = sgl_malloc(sizeof(sgl_circle_t));
+    sgl_circle_t *circle = sgl_slab_alloc(sizeof(sgl_circle_t), SGL_MM_TAG_OBJ);
     if(circle == NULL) {
         SGL_LOG_ERROR("sgl_circle_create: malloc failed");
         return NULL;
@@ -435,7 +435,7 @@ static void sgl_keyboard_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
     int16_t body_h = obj->coords.y2 - obj->coords.y1 + 1;
 
     int8_t index = 0, key_mode = KEYBOARD_KEY_MODE(keyboard->key_mode), icon_index = 0;
-    sgl_color_t btn_color = keyboard->btn_desc.color;
+    sgl_draw_rect_t btn_desc = keyboard->btn_desc;
     int16_t text_x = 0, text_y = 0;
     int16_t btn_width[KEYBOARD_BTN_COLUMNS] = {0};
     int16_t btn_height[KEYBOARD_BTN_LINES] = {0};
@@ -460,13 +460,14 @@ static void sgl_keyboard_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
                 btn.x1 += keyboard->key_margin;
                 btn.x2 = btn.x1 + btn_width[j] - 1;
 
+                /* the color of key is set in a copy, slices of the object may be drawn in parallel */
                 if(index == keyboard->key_index) {
-                    keyboard->btn_desc.color = sgl_color_mixer(btn_color, keyboard->text_color, 128);
+                    btn_desc.color = sgl_color_mixer(keyboard->btn_desc.color, keyboard->text_color, 128);
                 }
                 else {
-                    keyboard->btn_desc.color = btn_color;
+                    btn_desc.color = keyboard->btn_desc.color;
                 }
-                sgl_draw_rect(surf, &btn, &btn, &keyboard->btn_desc);
+                sgl_draw_rect(surf, &btn, &btn, &btn_desc);
 
                 icon_index = keyindex_is_icon(keyboard->key_mode, index);
                 if (icon_index != KEYBOARD_ICON_INVALID) {
@@ -486,8 +487,6 @@ static void sgl_keyboard_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
 
             btn.y1 += btn_height[i];
         }
-
-        keyboard->btn_desc.color = btn_color;
     }
     else if(evt->type == SGL_EVENT_PRESSED || evt->type == SGL_EVENT_OPTION_TAP) {
         if  (evt->type == SGL_EVENT_PRESSED) {
@@ -560,7 +559,7 @@ static void sgl_keyboard_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
  */
 sgl_obj_t* sgl_keyboard_create(sgl_obj_t* parent)
 {
-    sgl_keyboard_t *keyboard = sgl_malloc(sizeof(sgl_keyboard_t));
+    sgl_keyboard_t *keyboard = sgl_slab_alloc(sizeof(sgl_keyboard_t), SGL_MM_TAG_OBJ);
     if(keyboard == NULL) {
         SGL_LOG_ERROR("sgl_keyboard_create: malloc failed");
         return NULL;
@@ -582,6 +581,7 @@ sgl_obj_t* sgl_keyboard_create(sgl_obj_t* parent)
     keyboard->body_desc.border = 1;
     keyboard->body_desc.border_color = SGL_THEME_BORDER_COLOR;
     keyboard->body_desc.pixmap = NULL;
+    sgl_obj_set_opaque(obj, keyboard->body_desc.alpha == SGL_ALPHA_MAX && keyboard->body_desc.radius == 0);
     keyboard->text_color = SGL_THEME_TEXT_COLOR;
 
     keyboard->btn_desc.alpha = SGL_THEME_ALPHA;
@@ -85,6 +85,7 @@ static inline void sgl_keyboard_set_alpha(sgl_obj_t *obj, uint8_t alpha)
 {
     sgl_keyboard_t *keyboard = (sgl_keyboard_t*)obj;
     keyboard->body_desc.alpha = alpha;
+    sgl_obj_set_opaque(obj, alpha == SGL_ALPHA_MAX && sgl_pixmap_is_opaque(keyboard->body_desc.pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -98,6 +99,7 @@ static inline void sgl_keyboard_set_radius(sgl_obj_t *obj, uint8_t radius)
 {
     sgl_keyboard_t *keyboard = (sgl_keyboard_t*)obj;
     keyboard->body_desc.radius = sgl_obj_fix_radius(obj, radius);
+    sgl_obj_set_opaque(obj, keyboard->body_desc.alpha == SGL_ALPHA_MAX && sgl_pixmap_is_opaque(keyboard->body_desc.pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -111,6 +113,7 @@ static inline void sgl_keyboard_set_pixmap(sgl_obj_t *obj, const sgl_pixmap_t *p
 {
     sgl_keyboard_t *keyboard = (sgl_keyboard_t*)obj;
     keyboard->body_desc.pixmap = pixmap;
+    sgl_obj_set_opaque(obj, keyboard->body_desc.alpha == SGL_ALPHA_MAX && sgl_pixmap_is_opaque(pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -85,7 +85,7 @@ static void sgl_label_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
  */
 sgl_obj_t* sgl_label_create(sgl_obj_t* parent)
 {
-    sgl_label_t *label = sgl_malloc(sizeof(sgl_label_t));
+    sgl_label_t *label = sgl_slab_alloc(sizeof(sgl_label_t), SGL_MM_TAG_OBJ);
     if(label == NULL) {
         SGL_LOG_ERROR("sgl_label_create: malloc failed");
         return NULL;
@@ -42,18 +42,19 @@ static void sgl_led_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
         sgl_area_t clip;
         sgl_color_t *buf = NULL;
 
-        led->cx = (led->obj.coords.x1 + led->obj.coords.x2) / 2;
-        led->cy = (led->obj.coords.y1 + led->obj.coords.y2) / 2;
+        /* the center is a local, slices of the object may be drawn in parallel */
+        int16_t cx = (led->obj.coords.x1 + led->obj.coords.x2) / 2;
+        int16_t cy = (led->obj.coords.y1 + led->obj.coords.y2) / 2;
 
         if (!sgl_surf_clip(surf, &obj->area, &clip)) {
             return;
         }
 
         sgl_area_t c_rect = {
-            .x1 = led->cx - obj->radius,
-            .x2 = led->cx + obj->radius,
-            .y1 = led->cy - obj->radius,
-            .y2 = led->cy + obj->radius
+            .x1 = cx - obj->radius,
+            .x2 = cx + obj->radius,
+            .y1 = cy - obj->radius,
+            .y2 = cy + obj->radius
         };
         if (!sgl_area_selfclip(&clip, &c_rect)) {
             return;
@@ -65,13 +66,13 @@ static void sgl_led_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
         int ds_alpha = SGL_ALPHA_MIN;
 
         for (int y = clip.y1; y <= clip.y2; y++) {
-            y2 = sgl_pow2(y - led->cy);
+            y2 = sgl_pow2(y - cy);
             buf = sgl_surf_get_buf(surf, clip.x1 - surf->x, y - surf->y);
 
             for (int x = clip.x1; x <= clip.x2; x++, buf++) {
-                real_r2 = sgl_pow2(x - led->cx) + y2;
+                real_r2 = sgl_pow2(x - cx) + y2;
                 if (real_r2 >= r2_edge) {
-                    if(x > led->cx)
+                    if(x > cx)
                         break;
                     continue;
                 }
@@ -108,7 +109,7 @@ static void sgl_led_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *
  */
 sgl_obj_t* sgl_led_create(sgl_obj_t* parent)
 {
-    sgl_led_t *led = sgl_malloc(sizeof(sgl_led_t));
+    sgl_led_t *led = sgl_slab_alloc(sizeof(sgl_led_t), SGL_MM_TAG_OBJ);
     if(led == NULL) {
         SGL_LOG_ERROR("sgl_led_create: malloc failed");
         return NULL;
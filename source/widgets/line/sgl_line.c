@@ -50,7 +50,7 @@ static void sgl_line_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
  */
 sgl_obj_t* sgl_line_create(sgl_obj_t* parent)
 {
-    sgl_line_t *line = sgl_malloc(sizeof(sgl_line_t));
+    sgl_line_t *line = sgl_slab_alloc(sizeof(sgl_line_t), SGL_MM_TAG_OBJ);
     if(line == NULL) {
         SGL_LOG_ERROR("sgl_line_create: malloc failed");
         return NULL;
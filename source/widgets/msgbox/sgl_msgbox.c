@@ -61,7 +61,8 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
 
     SGL_ASSERT(msgbox->font != NULL);
 
-    sgl_color_t tmp_color;
+    sgl_color_t apply_color = msgbox->apply_color;
+    sgl_color_t close_color = msgbox->close_color;
     sgl_area_t  button_coords = {
         .x1 = obj->coords.x1,
         .x2 = obj->coords.x2,
@@ -98,10 +99,6 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
     };
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        if(msgbox->status & SGL_MSGBOX_STATUS_EXIT) {
-            sgl_obj_set_destroyed(&msgbox->obj);
-        }
-
         sgl_draw_rect(surf, &obj->area, &obj->coords, &msgbox->body_desc);
         
         msgbox_draw_text(surf, &obj->area, &title_coords, msgbox->title_icon, msgbox->title_text, font, msgbox->title_color, msgbox->body_desc.alpha, 0);
@@ -117,26 +114,18 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
 
         sgl_draw_string_mult_line(surf, &text_coords, text_coords.x1, text_coords.y1, msgbox->msg_text, msgbox->msg_color, msgbox->body_desc.alpha, font, 2, msgbox->msg_line_margin);
 
+        /* the colors of pressed button are locals, slices of the object may be drawn in parallel */
         if(msgbox->status & SGL_MSGBOX_STATUS_APPLY) {
-            tmp_color = msgbox->apply_color;
-            msgbox->apply_color = sgl_color_mixer(msgbox->btn_text_color, msgbox->body_desc.color, 128);
+            apply_color = sgl_color_mixer(msgbox->btn_text_color, msgbox->body_desc.color, 128);
         }
         else if(msgbox->status & SGL_MSGBOX_STATUS_CLOSE) {
-            tmp_color = msgbox->close_color;
-            msgbox->close_color = sgl_color_mixer(msgbox->btn_text_color, msgbox->body_desc.color, 128);
+            close_color = sgl_color_mixer(msgbox->btn_text_color, msgbox->body_desc.color, 128);
         }
 
-        sgl_draw_fill_round_rect(surf, &button_coords, &apply_coords, obj->radius, msgbox->apply_color, msgbox->body_desc.alpha);
-        sgl_draw_fill_round_rect(surf, &button_coords, &close_coords, obj->radius, msgbox->close_color, msgbox->body_desc.alpha);
+        sgl_draw_fill_round_rect(surf, &button_coords, &apply_coords, obj->radius, apply_color, msgbox->body_desc.alpha);
+        sgl_draw_fill_round_rect(surf, &button_coords, &close_coords, obj->radius, close_color, msgbox->body_desc.alpha);
         msgbox_draw_text(surf, &obj->area, &apply_coords, msgbox->apply_icon, msgbox->apply_text, font, msgbox->btn_text_color, msgbox->body_desc.alpha, font_height / 2);
         msgbox_draw_text(surf, &obj->area, &close_coords, msgbox->close_icon, msgbox->close_text, font, msgbox->btn_text_color, msgbox->body_desc.alpha, font_height / 2);
-    
-        if(msgbox->status & SGL_MSGBOX_STATUS_APPLY) {
-            msgbox->apply_color = tmp_color;
-        }
-        else if(msgbox->status & SGL_MSGBOX_STATUS_CLOSE) {
-            msgbox->close_color = tmp_color;
-        }
     }
     else if(evt->type == SGL_EVENT_PRESSED) {
         if(evt->pos.y > (obj->coords.y2 - font_height - 2) && evt->pos.x < ((obj->coords.x1 + obj->coords.x2) / 2)) {
@@ -165,6 +154,9 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
             sgl_obj_clear_dirty(obj);
             return;
         }
+
+        /* destroy it here instead of in DRAW_MAIN, slices of the object may be drawn in parallel */
+        sgl_obj_set_destroyed(obj);
     }
 
 }
@@ -177,7 +169,7 @@ static void sgl_msgbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_msgbox_create(sgl_obj_t* parent)
 {
-    sgl_msgbox_t *msgbox = sgl_malloc(sizeof(sgl_msgbox_t));
+    sgl_msgbox_t *msgbox = sgl_slab_alloc(sizeof(sgl_msgbox_t), SGL_MM_TAG_OBJ);
     if(msgbox == NULL) {
         SGL_LOG_ERROR("sgl_msgbox_create: malloc failed");
         return NULL;
@@ -119,7 +119,7 @@ static void sgl_numberkbd_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
     sgl_numberkbd_t *numberkbd = (sgl_numberkbd_t*)obj;
     int16_t body_w = obj->coords.x2 - obj->coords.x1 + 1;
     int16_t body_h = obj->coords.y2 - obj->coords.y1 + 1;
-    sgl_color_t btn_color = numberkbd->btn_desc.color;
+    sgl_draw_rect_t btn_desc = numberkbd->btn_desc;
 
     int16_t box_w = (body_w - (NUMBERKBD_BTN_COL + 1) * numberkbd->margin) / NUMBERKBD_BTN_COL;
     int16_t box_h = (body_h - (NUMBERKBD_BTN_ROW + 1) * numberkbd->margin) / NUMBERKBD_BTN_ROW;
@@ -142,37 +142,37 @@ static void sgl_numberkbd_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
             btn_col = 0;
 
             for(btn.x2 = (btn.x1 + box_w); btn.x1 < (obj->coords.x2 - numberkbd->margin) ; btn.x1 += (box_w + numberkbd->margin), btn.x2 = (btn.x1 + box_w)) {
+                /* the color of key is set in a copy, slices of the object may be drawn in parallel */
                 if(numberkbd->opcode != kbd_digits[btn_row][btn_col]) {
-                    numberkbd->btn_desc.color = btn_color;
+                    btn_desc.color = numberkbd->btn_desc.color;
                 }
                 else {
-                    numberkbd->btn_desc.color = sgl_color_mixer(btn_color, numberkbd->text_color, 128);
+                    btn_desc.color = sgl_color_mixer(numberkbd->btn_desc.color, numberkbd->text_color, 128);
                 }
 
                 if(btn_col == 3 && btn_row > 1) {
                     if(btn_row == 2) {
-                        sgl_draw_rect(surf, &btn, &btn, &numberkbd->btn_desc);
+                        sgl_draw_rect(surf, &btn, &btn, &btn_desc);
                         text_x = btn.x1 + ((box_w -  backspace_icon.width) / 2);
                         text_y = btn.y1 + ((box_h - backspace_icon.height + 1) / 2);
                         sgl_draw_icon(surf, &btn, text_x, text_y, numberkbd->text_color, numberkbd->btn_desc.alpha, &backspace_icon);
                     }
                     else if (btn_row == 3) {
                         btn.y2 += (numberkbd->margin + box_h);
-                        sgl_draw_rect(surf, &btn, &btn, &numberkbd->btn_desc);
+                        sgl_draw_rect(surf, &btn, &btn, &btn_desc);
                         text_x = btn.x1 + ((box_w -  enter_icon.width) / 2);
                         text_y = btn.y1 + ((2 * box_h - enter_icon.height) / 2);
                         sgl_draw_icon(surf, &btn, text_x, text_y, numberkbd->text_color, numberkbd->btn_desc.alpha, &enter_icon);
                     }
                 }
                 else {
-                    sgl_draw_rect(surf, &btn, &btn, &numberkbd->btn_desc);
+                    sgl_draw_rect(surf, &btn, &btn, &btn_desc);
                     text_x = btn.x1 + ((box_w -  sgl_font_get_string_width("0", numberkbd->font)) / 2);
                     sgl_draw_character(surf, &obj->area, text_x, text_y, kbd_digits[btn_row][btn_col] - 32, numberkbd->text_color, numberkbd->btn_desc.alpha, numberkbd->font);
                 }
                 btn_col ++;
             }
 
-            numberkbd->btn_desc.color = btn_color;
             btn_row ++;
         }
     }
@@ -242,7 +242,7 @@ static void sgl_numberkbd_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
  */
 sgl_obj_t* sgl_numberkbd_create(sgl_obj_t* parent)
 {
-    sgl_numberkbd_t *numberkbd = sgl_malloc(sizeof(sgl_numberkbd_t));
+    sgl_numberkbd_t *numberkbd = sgl_slab_alloc(sizeof(sgl_numberkbd_t), SGL_MM_TAG_OBJ);
     if(numberkbd == NULL) {
         SGL_LOG_ERROR("sgl_numberkbd_create: malloc failed");
         return NULL;
@@ -79,7 +79,7 @@ static void sgl_rectangle_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
  */
 sgl_obj_t* sgl_rect_create(sgl_obj_t* parent)
 {
-    sgl_rectangle_t *rect = sgl_malloc(sizeof(sgl_rectangle_t));
+    sgl_rectangle_t *rect = sgl_slab_alloc(sizeof(sgl_rectangle_t), SGL_MM_TAG_OBJ);
     if(rect == NULL) {
         SGL_LOG_ERROR("sgl_rect_create: malloc failed");
         return NULL;
@@ -100,5 +100,7 @@ sgl_obj_t* sgl_rect_create(sgl_obj_t* parent)
     rect->desc.border_color = SGL_THEME_BORDER_COLOR;
     rect->desc.pixmap = NULL;
 
+    sgl_obj_set_opaque(obj, rect->desc.alpha == SGL_ALPHA_MAX);
+
     return obj;
 }
@@ -76,6 +76,7 @@ static inline void sgl_rect_set_alpha(sgl_obj_t *obj, uint8_t alpha)
 {
     sgl_rectangle_t *rect = (sgl_rectangle_t *)obj;
     rect->desc.alpha = alpha;
+    sgl_obj_set_opaque(obj, rect->desc.alpha == SGL_ALPHA_MAX && rect->desc.radius == 0 && sgl_pixmap_is_opaque(rect->desc.pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -90,6 +91,7 @@ static inline void sgl_rect_set_radius(sgl_obj_t *obj, uint8_t radius)
 {
     sgl_rectangle_t *rect = (sgl_rectangle_t *)obj;
     rect->desc.radius = radius;
+    sgl_obj_set_opaque(obj, rect->desc.alpha == SGL_ALPHA_MAX && rect->desc.radius == 0 && sgl_pixmap_is_opaque(rect->desc.pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -129,6 +131,7 @@ static inline void sgl_rect_set_pixmap(sgl_obj_t *obj, const sgl_pixmap_t *pixma
 {
     sgl_rectangle_t *rect = (sgl_rectangle_t *)obj;
     rect->desc.pixmap = pixmap;
+    sgl_obj_set_opaque(obj, rect->desc.alpha == SGL_ALPHA_MAX && rect->desc.radius == 0 && sgl_pixmap_is_opaque(pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -38,9 +38,10 @@ static void sgl_ring_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
     sgl_ring_t *ring = (sgl_ring_t*)obj;
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        ring->cx = (obj->coords.x2 + obj->coords.x1) / 2;
-        ring->cy = (obj->coords.y2 + obj->coords.y1) / 2;
-        sgl_draw_fill_ring(surf, &obj->area, ring->cx, ring->cy, ring->radius_in, ring->radius_out, ring->color, ring->alpha);
+        int16_t cx = (obj->coords.x2 + obj->coords.x1) / 2;
+        int16_t cy = (obj->coords.y2 + obj->coords.y1) / 2;
+
+        sgl_draw_fill_ring(surf, &obj->area, cx, cy, ring->radius_in, ring->radius_out, ring->color, ring->alpha);
     }
     else if(evt->type == SGL_EVENT_DRAW_INIT) {
         if(ring->radius_out == -1) {
@@ -65,7 +66,7 @@ static void sgl_ring_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t
  */
 sgl_obj_t* sgl_ring_create(sgl_obj_t* parent)
 {
-    sgl_ring_t *ring = sgl_malloc(sizeof(sgl_ring_t));
+    sgl_ring_t *ring = sgl_slab_alloc(sizeof(sgl_ring_t), SGL_MM_TAG_OBJ);
     if(ring == NULL) {
         SGL_LOG_ERROR("sgl_ring_create: malloc failed");
         return NULL;
@@ -88,7 +88,7 @@ static void sgl_slider_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_slider_create(sgl_obj_t* parent)
 {
-    sgl_slider_t *slider = sgl_malloc(sizeof(sgl_slider_t));
+    sgl_slider_t *slider = sgl_slab_alloc(sizeof(sgl_slider_t), SGL_MM_TAG_OBJ);
     if(slider == NULL) {
         SGL_LOG_ERROR("sgl_slider_create: malloc failed");
         return NULL;
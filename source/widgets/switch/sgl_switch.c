@@ -36,27 +36,28 @@
 static void sgl_switch_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_switch_t *p_switch = (sgl_switch_t*)(obj);
-    sgl_draw_rect_t *bg_desc = &p_switch->bg_desc;
-    int16_t width = obj->coords.y2 - obj->coords.y1 - 2 * bg_desc->border;
+    /* the color is set in a copy, slices of the object may be drawn in parallel */
+    sgl_draw_rect_t bg_desc = p_switch->bg_desc;
+    int16_t width = obj->coords.y2 - obj->coords.y1 - 2 * bg_desc.border;
     sgl_rect_t knob_rect = { 
-        .y1 = obj->coords.y1 + bg_desc->border,
-        .y2 = obj->coords.y2 - bg_desc->border,
+        .y1 = obj->coords.y1 + bg_desc.border,
+        .y2 = obj->coords.y2 - bg_desc.border,
     };
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
         if(p_switch->status) {
-            bg_desc->color = p_switch->color;
-            knob_rect.x2 = obj->coords.x2 - bg_desc->border;
+            bg_desc.color = p_switch->color;
+            knob_rect.x2 = obj->coords.x2 - bg_desc.border;
             knob_rect.x1 = knob_rect.x2 - width;
         }
         else {
-            bg_desc->color = p_switch->bg_color;
-            knob_rect.x1 = obj->coords.x1 + bg_desc->border;
+            bg_desc.color = p_switch->bg_color;
+            knob_rect.x1 = obj->coords.x1 + bg_desc.border;
             knob_rect.x2 = knob_rect.x1 + width;
         }
 
-        sgl_draw_rect(surf, &obj->area, &obj->coords, &p_switch->bg_desc);
-        sgl_draw_fill_round_rect(surf, &obj->area, &knob_rect, obj->radius - 2 * bg_desc->border, p_switch->knob_color, p_switch->bg_desc.alpha);
+        sgl_draw_rect(surf, &obj->area, &obj->coords, &bg_desc);
+        sgl_draw_fill_round_rect(surf, &obj->area, &knob_rect, obj->radius - 2 * bg_desc.border, p_switch->knob_color, bg_desc.alpha);
     }
     else if(evt->type == SGL_EVENT_PRESSED) {
         p_switch->status = !p_switch->status;
@@ -78,7 +79,7 @@ static void sgl_switch_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_
  */
 sgl_obj_t* sgl_switch_create(sgl_obj_t* parent)
 {
-    sgl_switch_t *p_switch = sgl_malloc(sizeof(sgl_switch_t));
+    sgl_switch_t *p_switch = sgl_slab_alloc(sizeof(sgl_switch_t), SGL_MM_TAG_OBJ);
     if(p_switch == NULL) {
         SGL_LOG_ERROR("sgl_switch_create: malloc failed");
         return NULL;
@@ -35,6 +35,20 @@
 #define  SGL_TEXTBOX_SCROLL_WIDTH                  (4)
 
 
+/**
+ * @brief get the height of text, the line break index is rebuilt only if the text, font, width or margin is changed
+ * @note line_margin is the margin of characters and edge_margin is the margin of lines when the text is drawn
+ */
+static int32_t textbox_text_height(sgl_obj_t* obj)
+{
+    sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
+    uint32_t count = sgl_text_lines_update(&textbox->lines, textbox->text, textbox->font,
+                                           obj->coords.x2 - obj->coords.x1, textbox->line_margin);
+
+    return count * (textbox->font->font_height + textbox->edge_margin);
+}
+
+
 static int16_t textbox_scroll_get_pos(sgl_obj_t* obj, int16_t scroll_h)
 {
     sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
@@ -44,6 +58,32 @@ static int16_t textbox_scroll_get_pos(sgl_obj_t* obj, int16_t scroll_h)
 }
 
 
+/**
+ * @brief move the pixels of text instead of redrawing the whole textbox if it is possible
+ * @note the view excludes the border, the round corners and the scroll bar, the text is drawn
+ *       over an opaque background there, so its pixels only depend on y_offset
+ */
+static void textbox_scroll(sgl_obj_t* obj, int16_t dy)
+{
+    sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
+    int16_t inset = sgl_max(textbox->bg.border, textbox->bg.radius);
+    sgl_area_t view = {
+        .x1 = obj->coords.x1 + textbox->bg.border,
+        .y1 = obj->coords.y1 + inset,
+        .x2 = sgl_min(obj->coords.x2 - textbox->bg.border, obj->coords.x2 - SGL_TEXTBOX_SCROLL_WIDTH - 1),
+        .y2 = obj->coords.y2 - inset,
+    };
+
+    if (dy == 0 || textbox->bg.alpha != SGL_ALPHA_MAX || textbox->bg.pixmap != NULL) {
+        return;
+    }
+
+    if (sgl_obj_scroll(obj, &view, 0, dy)) {
+        sgl_obj_clear_dirty(obj);
+    }
+}
+
+
 static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
@@ -61,7 +101,7 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
         sgl_draw_rect(surf, &obj->area, &obj->coords, &textbox->bg);
-        sgl_draw_string_mult_line(surf, &obj->area, obj->coords.x1, obj->coords.y1 + textbox->y_offset, textbox->text, textbox->text_color, textbox->bg.alpha, textbox->font, textbox->line_margin, textbox->edge_margin);
+        sgl_draw_text_lines(surf, &obj->area, obj->coords.x1, obj->coords.y1 + textbox->y_offset, &textbox->lines, textbox->text_color, textbox->bg.alpha, textbox->edge_margin);
 
         if(textbox->scroll_enable) {
             sgl_draw_rect(surf, &obj->area, &scroll_coords, &textbox->scroll_bg);
@@ -72,18 +112,25 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
             sgl_draw_rect(surf, &obj->area, &scroll_coords, &textbox->scroll_fg);
         }
     }
+    else if(evt->type == SGL_EVENT_DRAW_INIT) {
+        /* rebuild line break index before the slices are drawn, they may be drawn in parallel,
+         * so DRAW_MAIN only reads it */
+        textbox->text_height = textbox_text_height(obj);
+    }
     else if(evt->type == SGL_EVENT_MOVE_UP) {
-        textbox->text_height = sgl_font_get_string_height(&obj->coords, textbox->text, textbox->font, textbox->line_margin, textbox->edge_margin);
+        textbox->text_height = textbox_text_height(obj);
         textbox->scroll_enable = 1;
         if((textbox->text_height + textbox->y_offset) > height ) {
            textbox->y_offset -= evt->distance;
+           textbox_scroll(obj, -evt->distance);
         }
     }
     else if(evt->type == SGL_EVENT_MOVE_DOWN) {
-        textbox->text_height = sgl_font_get_string_height(&obj->coords, textbox->text, textbox->font, textbox->line_margin, textbox->edge_margin);
+        textbox->text_height = textbox_text_height(obj);
         textbox->scroll_enable = 1;
         if(textbox->y_offset < 0) {
             textbox->y_offset += evt->distance;
+            textbox_scroll(obj, evt->distance);
         }
     }
     else if (evt->type == SGL_EVENT_PRESSED) {
@@ -106,7 +153,7 @@ static void sgl_textbox_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event
  */
 sgl_obj_t* sgl_textbox_create(sgl_obj_t* parent)
 {
-    sgl_textbox_t *textbox = sgl_malloc(sizeof(sgl_textbox_t));
+    sgl_textbox_t *textbox = sgl_slab_alloc(sizeof(sgl_textbox_t), SGL_MM_TAG_OBJ);
     if(textbox == NULL) {
         SGL_LOG_ERROR("sgl_textbox_create: malloc failed");
         return NULL;
@@ -118,6 +165,7 @@ sgl_obj_t* sgl_textbox_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &textbox->obj;
     sgl_obj_init(&textbox->obj, parent);
     obj->construct_fn = sgl_textbox_construct_cb;
+    obj->needinit = 1;
 
     sgl_obj_set_clickable(obj);
     sgl_obj_set_movable(obj);
@@ -127,6 +175,7 @@ sgl_obj_t* sgl_textbox_create(sgl_obj_t* parent)
     textbox->bg.radius = SGL_THEME_RADIUS;
     textbox->bg.border = SGL_THEME_BORDER_WIDTH;
     textbox->bg.border_color = SGL_THEME_BORDER_COLOR;
+    sgl_obj_set_opaque(obj, textbox->bg.alpha == SGL_ALPHA_MAX && textbox->bg.radius == 0);
 
     textbox->scroll_bg.alpha = SGL_THEME_ALPHA;
     textbox->scroll_bg.color = SGL_THEME_SCROLL_BG_COLOR;
@@ -51,6 +51,7 @@ typedef struct sgl_textbox {
     sgl_draw_rect_t  scroll_fg;
     int32_t          text_height: 31;
     int32_t          scroll_enable: 1;
+    sgl_text_lines_t lines;
 }sgl_textbox_t;
 
 
@@ -66,11 +67,16 @@ sgl_obj_t* sgl_textbox_create(sgl_obj_t* parent);
  * @brief set text of the textbox
  * @param obj textbox object
  * @param text text to be set
+ * @note call it again if the content of text is changed, such as a log that is appended, so the
+ *       line index and text height are built again. If only sgl_obj_set_dirty() is called, the
+ *       text is drawn without reading past its end, but the lines are not fitted to it
  */
 static inline void sgl_textbox_set_text(sgl_obj_t *obj, const char *text)
 {
     sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
     textbox->text = text;
+    sgl_text_lines_invalidate(&textbox->lines);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -97,6 +103,8 @@ static inline void sgl_textbox_set_font(sgl_obj_t *obj, const sgl_font_t *font)
 {
     sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
     textbox->font = font;
+    sgl_text_lines_invalidate(&textbox->lines);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -123,6 +131,7 @@ static inline void sgl_textbox_set_radius(sgl_obj_t *obj, uint8_t radius)
 {
     sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
     textbox->bg.radius = sgl_obj_fix_radius(obj, radius);
+    sgl_obj_set_opaque(obj, textbox->bg.alpha == SGL_ALPHA_MAX && sgl_pixmap_is_opaque(textbox->bg.pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -162,6 +171,7 @@ static inline void sgl_textbox_set_pixmap(sgl_obj_t *obj, const sgl_pixmap_t *pi
 {
     sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
     textbox->bg.pixmap = pixmap;
+    sgl_obj_set_opaque(obj, textbox->bg.alpha == SGL_ALPHA_MAX && textbox->bg.radius == 0 && sgl_pixmap_is_opaque(pixmap));
     sgl_obj_set_dirty(obj);
 }
 
@@ -175,6 +185,8 @@ static inline void sgl_textbox_set_line_margin(sgl_obj_t *obj, uint8_t margin)
 {
     sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
     textbox->line_margin = margin;
+    sgl_text_lines_invalidate(&textbox->lines);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -188,6 +200,8 @@ static inline void sgl_textbox_set_edge_margin(sgl_obj_t *obj, uint8_t margin)
 {
     sgl_textbox_t *textbox = (sgl_textbox_t*)obj;
     textbox->edge_margin = margin;
+    sgl_text_lines_invalidate(&textbox->lines);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -32,6 +32,27 @@
 #include "sgl_textline.h"
 
 
+/**
+ * @brief fit the height of textline to its text, the line break index is rebuilt only if the text,
+ *        font, width or edge margin is changed
+ * @note it is called in DRAW_INIT before the area of object is clipped, so the old area is merged
+ *       and the object is set dirty, then the new area is clipped by the dirty area calculation
+ */
+static void textline_update_height(sgl_obj_t* obj)
+{
+    sgl_textline_t *textline = (sgl_textline_t*)obj;
+    uint32_t count = sgl_text_lines_update(&textline->lines, textline->text, textline->font,
+                                           obj->coords.x2 - obj->coords.x1, textline->edge_margin);
+    int16_t height = count * (textline->font->font_height + textline->line_margin);
+
+    if (height != sgl_obj_get_height(obj)) {
+        sgl_obj_dirty_merge(obj);
+        sgl_obj_set_height(obj, height);
+        sgl_obj_set_dirty(obj);
+    }
+}
+
+
 static void sgl_textline_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_event_t *evt)
 {
     sgl_textline_t *textline = (sgl_textline_t*)obj;
@@ -39,14 +60,16 @@ static void sgl_textline_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
     SGL_ASSERT(textline->font != NULL);
 
     if(evt->type == SGL_EVENT_DRAW_MAIN) {
-        sgl_obj_set_height(obj, sgl_font_get_string_height(&obj->coords, textline->text, textline->font, textline->line_margin, textline->edge_margin));
-        sgl_area_clip(&obj->parent->area, &obj->coords, &obj->area);
-
         if (textline->bg_flag) {
             sgl_draw_fill_round_rect(surf, &obj->area, &obj->coords, obj->radius, textline->bg_color, textline->alpha);
         }
 
-        sgl_draw_string_mult_line(surf, &obj->area, obj->coords.x1, obj->coords.y1, textline->text, textline->color, textline->alpha, textline->font, textline->edge_margin, textline->line_margin);
+        sgl_draw_text_lines(surf, &obj->area, obj->coords.x1, obj->coords.y1, &textline->lines, textline->color, textline->alpha, textline->line_margin);
+    }
+    else if(evt->type == SGL_EVENT_DRAW_INIT) {
+        /* rebuild line break index before the slices are drawn, they may be drawn in parallel,
+         * so DRAW_MAIN only reads it */
+        textline_update_height(obj);
     }
 
     if(obj->event_fn) {
@@ -62,7 +85,7 @@ static void sgl_textline_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_even
  */
 sgl_obj_t* sgl_textline_create(sgl_obj_t* parent)
 {
-    sgl_textline_t *textline = sgl_malloc(sizeof(sgl_textline_t));
+    sgl_textline_t *textline = sgl_slab_alloc(sizeof(sgl_textline_t), SGL_MM_TAG_OBJ);
     if(textline == NULL) {
         SGL_LOG_ERROR("sgl_textline_create: malloc failed");
         return NULL;
@@ -74,6 +97,7 @@ sgl_obj_t* sgl_textline_create(sgl_obj_t* parent)
     sgl_obj_t *obj = &textline->obj;
     sgl_obj_init(&textline->obj, parent);
     obj->construct_fn = sgl_textline_construct_cb;
+    obj->needinit = 1;
 
     textline->alpha = SGL_THEME_ALPHA;
     textline->bg_flag = true;
@@ -48,6 +48,7 @@ typedef struct sgl_textline {
     uint8_t          edge_margin : 7;
     uint8_t          bg_flag : 1;
     uint8_t          alpha;
+    sgl_text_lines_t lines;
 } sgl_textline_t;
 
 
@@ -64,11 +65,16 @@ sgl_obj_t* sgl_textline_create(sgl_obj_t* parent);
  * @param obj textline object
  * @param text text
  * @return none
+ * @note call it again if the content of text is changed, so the line index and height are
+ *       built again. If only sgl_obj_set_dirty() is called, the text is drawn without reading
+ *       past its end, but the lines and height are not fitted to it
  */
 static inline void sgl_textline_set_text(sgl_obj_t *obj, const char *text)
 {
     sgl_textline_t *textline = (sgl_textline_t *)obj;
     textline->text = text;
+    sgl_text_lines_invalidate(&textline->lines);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -82,6 +88,8 @@ static inline void sgl_textline_set_font(sgl_obj_t *obj, const sgl_font_t *font)
 {
     sgl_textline_t *textline = (sgl_textline_t *)obj;
     textline->font = font;
+    sgl_text_lines_invalidate(&textline->lines);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -148,6 +156,8 @@ static inline void sgl_textline_set_edge_margin(sgl_obj_t *obj, uint8_t margin)
 {
     sgl_textline_t *textline = (sgl_textline_t *)obj;
     textline->edge_margin = margin;
+    sgl_text_lines_invalidate(&textline->lines);
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
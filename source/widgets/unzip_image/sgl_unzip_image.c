@@ -30,6 +30,7 @@
 #include <sgl_draw.h>
 #include <sgl_log.h>
 #include <sgl_mm.h>
+#include <sgl_math.h>
 #include <sgl_cfgfix.h>
 #include <string.h>
 #include "sgl_unzip_image.h"
@@ -39,8 +40,6 @@
  */
 typedef struct {
     uint32_t n;         /* Current decode position */
-    int16_t x;          /* Current X coordinate */
-    int16_t y;          /* Current Y coordinate */
     uint16_t rep_cnt;   /* Repeat count */
     sgl_color_t out;    /* Output color value */
     sgl_color_t unzip;  /* Unzip buffer */
@@ -58,14 +57,38 @@ static void sgl_unzip_img_dec_init(sgl_unzip_img_dec_t *dec, const sgl_unzip_img
     SGL_ASSERT(unzip_img != NULL);
     
     dec->n = 0;
-    dec->x = 0;
-    dec->y = 0;
     dec->rep_cnt = 0;
     dec->out.full = 0;
     dec->unzip.full = 0;
     dec->p = unzip_img->map;
 }
 
+/**
+ * @brief Save decoder state into a row mark
+ * @param mark Row mark
+ * @param dec Decoder pointer
+ */
+static inline void sgl_unzip_img_dec_save(sgl_unzip_img_mark_t *mark, const sgl_unzip_img_dec_t *dec)
+{
+    mark->n = dec->n;
+    mark->rep_cnt = dec->rep_cnt;
+    mark->out = dec->out;
+    mark->unzip = dec->unzip;
+}
+
+/**
+ * @brief Restore decoder state from a row mark
+ * @param dec Decoder pointer
+ * @param mark Row mark
+ */
+static inline void sgl_unzip_img_dec_restore(sgl_unzip_img_dec_t *dec, const sgl_unzip_img_mark_t *mark)
+{
+    dec->n = mark->n;
+    dec->rep_cnt = mark->rep_cnt;
+    dec->out = mark->out;
+    dec->unzip = mark->unzip;
+}
+
 /**
  * @brief Incrementally decompress compressed image data
  * @param dec Decoder pointer
@@ -95,6 +118,89 @@ static void sgl_unzip_img_incremental(sgl_unzip_img_dec_t *dec)
     }
 }
 
+/**
+ * @brief Skip pixels of compressed image, a repeat run is skipped at once
+ * @param dec Decoder pointer
+ * @param count Number of pixels
+ */
+static void sgl_unzip_img_skip(sgl_unzip_img_dec_t *dec, uint32_t count)
+{
+    uint32_t take;
+
+    while (count > 0) {
+        while (dec->rep_cnt == 0) {
+            sgl_unzip_img_incremental(dec);
+        }
+        take = sgl_min(dec->rep_cnt, count);
+        dec->rep_cnt -= take;
+        count -= take;
+    }
+}
+
+/**
+ * @brief Build the row marks of an image that has no marks, it decodes the whole image once
+ * @param index Row marks
+ * @param unzip_img Compressed image data
+ * @note it is called in DRAW_INIT, so the slices that may be drawn in parallel only read the marks
+ */
+static void sgl_unzip_img_index_build(sgl_unzip_img_index_t *index, const sgl_unzip_img_pixmap_t *unzip_img)
+{
+    sgl_unzip_img_dec_t dec;
+    int16_t row;
+
+    if (unzip_img->mark != NULL || index->img == unzip_img) {
+        return;
+    }
+
+    index->shift = 0;
+    while (((unzip_img->height - 1) >> index->shift) >= SGL_UNZIP_IMG_MARK_NUM) {
+        index->shift++;
+    }
+
+    sgl_unzip_img_dec_init(&dec, unzip_img);
+    for (row = 0; row < unzip_img->height; row++) {
+        if ((row & ((1 << index->shift) - 1)) == 0) {
+            sgl_unzip_img_dec_save(&index->mark[row >> index->shift], &dec);
+        }
+        sgl_unzip_img_skip(&dec, unzip_img->width);
+    }
+
+    index->count = ((unzip_img->height - 1) >> index->shift) + 1;
+    index->img = unzip_img;
+}
+
+/**
+ * @brief Move decoder to the start of a row, from the nearest row mark before it
+ * @param dec Decoder pointer
+ * @param unzip_img Compressed image data
+ * @param index Row marks that are built in DRAW_INIT, NULL if none
+ * @param row Row of image
+ */
+static void sgl_unzip_img_seek(sgl_unzip_img_dec_t *dec, const sgl_unzip_img_pixmap_t *unzip_img,
+                               const sgl_unzip_img_index_t *index, int16_t row)
+{
+    int16_t k;
+
+    sgl_unzip_img_dec_init(dec, unzip_img);
+
+    if (unzip_img->mark != NULL) {
+        k = row >> unzip_img->mark_shift;
+        sgl_unzip_img_dec_restore(dec, &unzip_img->mark[k]);
+        sgl_unzip_img_skip(dec, (uint32_t)(row - (k << unzip_img->mark_shift)) * unzip_img->width);
+        return;
+    }
+
+    /* the marks of other image are not used, they are rebuilt in next DRAW_INIT */
+    if (index == NULL || index->img != unzip_img) {
+        sgl_unzip_img_skip(dec, (uint32_t)row * unzip_img->width);
+        return;
+    }
+
+    k = row >> index->shift;
+    sgl_unzip_img_dec_restore(dec, &index->mark[k]);
+    sgl_unzip_img_skip(dec, (uint32_t)(row - (k << index->shift)) * unzip_img->width);
+}
+
 
 /**
  * @brief Draw compressed image with transparency
@@ -102,11 +208,12 @@ static void sgl_unzip_img_incremental(sgl_unzip_img_dec_t *dec)
  * @param xs Starting X coordinate
  * @param ys Starting Y coordinate
  * @param unzip_img Compressed image data
+ * @param index Row marks of image, NULL if none
  * @param color Color (for color replacement)
  * @param alpha Transparency
  */
-static void sgl_draw_unzip_img_with_alpha(sgl_surf_t *surf, int16_t xs, int16_t ys, 
-                                       const sgl_unzip_img_pixmap_t *unzip_img, sgl_color_t color, uint8_t alpha)
+static void sgl_draw_unzip_img_with_alpha(sgl_surf_t *surf, int16_t xs, int16_t ys, const sgl_unzip_img_pixmap_t *unzip_img,
+                                          const sgl_unzip_img_index_t *index, sgl_color_t color, uint8_t alpha)
 {
     SGL_ASSERT(surf != NULL);
     SGL_ASSERT(unzip_img != NULL);
@@ -123,40 +230,33 @@ static void sgl_draw_unzip_img_with_alpha(sgl_surf_t *surf, int16_t xs, int16_t
     if (!sgl_surf_clip(surf, &img_rect, &intersection)) {
         return;
     }
-    
+
     sgl_unzip_img_dec_t dec;
-    sgl_unzip_img_dec_init(&dec, unzip_img);
-    
-    // int16_t xe = xs + unzip_img->width - 1;
-    int16_t ye = ys + unzip_img->height - 1;
-    
-    while (dec.y <= ye && dec.y <= intersection.y2) {
-        sgl_unzip_img_incremental(&dec);
-        while (dec.rep_cnt > 0) {
-            dec.rep_cnt--;
-            int16_t x = xs + dec.x;
-            int16_t y = ys + dec.y;
-            
-            if (x >= intersection.x1 && x <= intersection.x2 && 
-                y >= intersection.y1 && y <= intersection.y2) {
-                sgl_color_t *buf = sgl_surf_get_buf(surf, x - surf->x, y - surf->y);
-                *buf = sgl_color_mixer(dec.out, *buf, alpha);
-                // For monochrome images, can be used to change image color
-                // if (buf != NULL) {
-                //     if (sgl_color2int(color) != 0) {
-                //         *buf = sgl_color_mixer(color, *buf, alpha);
-                //     } else {
-                //         *buf = sgl_color_mixer(dec.out, *buf, alpha);
-                //     }
-                // }
+    sgl_unzip_img_seek(&dec, unzip_img, index, intersection.y1 - ys);
+
+    int16_t cx1 = intersection.x1 - xs;
+    int16_t cx2 = intersection.x2 - xs;
+
+    for (int16_t y = intersection.y1; y <= intersection.y2; y++) {
+        int16_t x = 0;
+
+        /* a repeat run is drawn as a span, the part out of clip is skipped */
+        while (x < unzip_img->width) {
+            while (dec.rep_cnt == 0) {
+                sgl_unzip_img_incremental(&dec);
             }
-            
-            if (++dec.x >= unzip_img->width) {
-                dec.x = 0;
-                if (++dec.y > ye) {
-                    break;
-                }
+
+            int16_t take = sgl_min(dec.rep_cnt, unzip_img->width - x);
+            int16_t s = sgl_max(x, cx1);
+            int16_t e = sgl_min(x + take - 1, cx2);
+
+            if (s <= e) {
+                sgl_color_t *buf = sgl_surf_get_buf(surf, xs + s - surf->x, y - surf->y);
+                sgl_draw_blend_span(buf, e - s + 1, dec.out, alpha);
             }
+
+            dec.rep_cnt -= take;
+            x += take;
         }
     }
 }
@@ -182,7 +282,7 @@ void sgl_draw_unzip_img(sgl_surf_t *surf, sgl_rect_t *area, sgl_rect_t *coords,
     if (SGL_ALPHA_MIN == desc->alpha) {
         return;  
     } else {
-        sgl_draw_unzip_img_with_alpha(surf, xs, ys, desc->unzip_img, desc->color, desc->alpha);
+        sgl_draw_unzip_img_with_alpha(surf, xs, ys, desc->unzip_img, desc->index, desc->color, desc->alpha);
     }
 }
 
@@ -202,6 +302,12 @@ static void sgl_unzip_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
             sgl_draw_unzip_img(surf, &obj->area, &obj->coords, &unzip_img->desc);
         }
     }
+    else if (evt->type == SGL_EVENT_DRAW_INIT) {
+        /* build row marks before the slices are drawn, they may be drawn in parallel */
+        if (unzip_img->desc.unzip_img != NULL) {
+            sgl_unzip_img_index_build(&unzip_img->index, unzip_img->desc.unzip_img);
+        }
+    }
     else if (evt->type == SGL_EVENT_PRESSED || evt->type == SGL_EVENT_RELEASED) {
         if (obj->event_fn) {
             obj->event_fn(evt);
@@ -216,7 +322,7 @@ static void sgl_unzip_img_construct_cb(sgl_surf_t *surf, sgl_obj_t* obj, sgl_eve
  */
 sgl_obj_t* sgl_unzip_img_create(sgl_obj_t* parent)
 {
-    sgl_unzip_img_t *unzip_img = sgl_malloc(sizeof(sgl_unzip_img_t));
+    sgl_unzip_img_t *unzip_img = sgl_slab_alloc(sizeof(sgl_unzip_img_t), SGL_MM_TAG_OBJ);
     if (unzip_img == NULL) {
         SGL_LOG_ERROR("sgl_unzip_img_create: malloc failed");
         return NULL;
@@ -232,6 +338,7 @@ sgl_obj_t* sgl_unzip_img_create(sgl_obj_t* parent)
     unzip_img->desc.unzip_img = NULL;
     unzip_img->desc.color = sgl_int2color(0);
     unzip_img->desc.align = SGL_ALIGN_CENTER;
+    unzip_img->desc.index = &unzip_img->index;
 
     return obj;
 }
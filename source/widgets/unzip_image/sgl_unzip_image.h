@@ -32,6 +32,21 @@
 #include <sgl_core.h>
 #include <sgl_draw.h>
 
+/**
+ * @brief max number of row marks that are built for a compressed image without marks
+ */
+#define  SGL_UNZIP_IMG_MARK_NUM                   (16)
+
+/**
+ * @brief Decoder state at the start of a row, so that decoding can start from the row
+ */
+typedef struct {
+    uint32_t n;              // Decode position in compressed data
+    uint16_t rep_cnt;        // Pixels that are left in current repeat run
+    sgl_color_t out;         // Output color value
+    sgl_color_t unzip;       // Unzip buffer
+} sgl_unzip_img_mark_t;
+
 /**
  * @brief Compressed image data structure
  */
@@ -39,8 +54,20 @@ typedef struct {
     uint16_t width;          // Image width
     uint16_t height;         // Image height
     const uint8_t *map;      // Compressed image data
+    const sgl_unzip_img_mark_t *mark;  // Optional marks of row (i << mark_shift), made by tools/sgl_unzip_index.py
+    uint8_t mark_shift;      // Rows between marks are (1 << mark_shift)
 } sgl_unzip_img_pixmap_t;
 
+/**
+ * @brief Row marks of a compressed image that has no marks, they are built in DRAW_INIT
+ */
+typedef struct {
+    const sgl_unzip_img_pixmap_t *img;  // Image of marks, NULL if the marks are invalid
+    uint8_t shift;                      // mark[i] is the start of row (i << shift)
+    uint8_t count;                      // Number of marks
+    sgl_unzip_img_mark_t mark[SGL_UNZIP_IMG_MARK_NUM];
+} sgl_unzip_img_index_t;
+
 /**
  * @brief Compressed image drawing description
  */
@@ -49,6 +76,7 @@ typedef struct {
     sgl_color_t color;                    // Image color
     uint8_t alpha;                        // Transparency
     sgl_align_type_t align;               // Alignment type
+    sgl_unzip_img_index_t *index;         // Optional row marks, NULL to decode from first row
 } sgl_draw_unzip_img_t;
 
 /**
@@ -57,6 +85,7 @@ typedef struct {
 typedef struct {
     sgl_obj_t obj;                // Base object
     sgl_draw_unzip_img_t desc;    // Drawing description
+    sgl_unzip_img_index_t index;  // Row marks of image
 } sgl_unzip_img_t;
 
 /**
@@ -115,9 +144,11 @@ static inline void sgl_unzip_img_set_img(sgl_obj_t *obj, const sgl_unzip_img_pix
 {
     sgl_unzip_img_t *img = (sgl_unzip_img_t *)obj;
     img->desc.unzip_img = unzip_img;
+    img->index.img = NULL;
     if (img->desc.unzip_img != NULL) {
         sgl_obj_set_size(obj, img->desc.unzip_img->width, img->desc.unzip_img->height);
     }
+    sgl_obj_needinit(obj);
     sgl_obj_set_dirty(obj);
 }
 
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+# tools/sgl_asset_pack.py
+#
+# MIT License
+#
+# Copyright(c) 2023-present All contributors of SGL
+# Document reference link: docs directory
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Make a binary asset pack that is opened by sgl_asset_open_file(), sgl_asset_open()
+# or sgl_asset_open_read() when CONFIG_SGL_ASSET_PACK is enabled.
+#
+#   python3 tools/sgl_asset_pack.py -o assets.bin \
+#       font:consolas14,source/fonts/sgl_ascii_consolas14.c \
+#       icon:enter,30x20,4,source/widgets/numberkbd/sgl_numberkbd.c#btn_enter_bitmap \
+#       pixmap:wallpaper,480x320,0,wallpaper.raw
+#
+# A font is taken from a font source file of sgl, its bitmap, glyph table, unicode
+# list, font_height and bpp are packed. An icon or a pixmap is taken from a raw file,
+# or from a uint8_t array of a C file with `file.c#symbol`. The bytes of a pixmap
+# must be in the pixel format of the panel, as the pixmaps that are compiled in.
+#
+# The layout of pack is defined in source/include/sgl_asset.h, all fields are little
+# endian and every data is 4 bytes aligned, so the pack is used in place.
+
+import argparse
+import re
+import struct
+import sys
+
+MAGIC = 0x414C4753
+VERSION = 1
+NAME_MAX = 24
+
+TYPE_PIXMAP = 1
+TYPE_ICON = 2
+TYPE_FONT = 3
+
+HEADER = struct.Struct('<IHHII')
+ENTRY = struct.Struct('<%dsBBHHHIIII' % NAME_MAX)
+TABLE = struct.Struct('<IBBbb')
+
+
+def strip_comments(text):
+    text = re.sub(r'/\*.*?\*/', '', text, flags=re.S)
+    return re.sub(r'//[^\n]*', '', text)
+
+
+def parse_numbers(body):
+    return [int(v, 0) for v in re.findall(r'-?0x[0-9a-fA-F]+|-?\d+', body)]
+
+
+def parse_array(text, path, pattern, what):
+    m = re.search(pattern + r'\s*\[\s*\]\s*=\s*\{(.*?)\};', text, re.S)
+    if m is None:
+        sys.exit('%s: %s is not found' % (path, what))
+    return m.group(1)
+
+
+def parse_c_bytes(path, symbol):
+    with open(path, encoding='utf-8', errors='replace') as f:
+        text = strip_comments(f.read())
+    body = parse_array(text, path, r'uint8_t\s+' + re.escape(symbol), symbol)
+    return bytes(v & 0xFF for v in parse_numbers(body))
+
+
+def parse_font(path):
+    with open(path, encoding='utf-8', errors='replace') as f:
+        text = strip_comments(f.read())
+
+    bitmap = bytes(v & 0xFF for v in parse_numbers(parse_array(text, path, r'uint8_t\s+\w+', 'bitmap')))
+
+    body = parse_array(text, path, r'sgl_font_table_t\s+\w+', 'font table')
+    table = b''
+    count = 0
+    for glyph in re.findall(r'\{(.*?)\}', body, re.S):
+        fields = dict((k, int(v, 0)) for k, v in re.findall(r'\.(\w+)\s*=\s*(-?\w+)', glyph))
+        table += TABLE.pack(fields['bitmap_index'], fields['box_h'], fields['box_w'],
+                            fields.get('ofs_x', 0), fields.get('ofs_y', 0))
+        count += 1
+
+    # the unicode list is packed as it is, with the end indicator, as the compiled font
+    m = re.search(r'unicode_list_1\s*\[\s*\]\s*=\s*\{(.*?)\};', text, re.S)
+    unicode = parse_numbers(m.group(1)) if m else []
+
+    m = re.search(r'sgl_font_t\s+\w+\s*=\s*\{(.*?)\};', text, re.S)
+    if m is None:
+        sys.exit('%s: sgl_font_t is not found' % path)
+    height = int(re.search(r'\.font_height\s*=\s*(\d+)', m.group(1)).group(1))
+    bpp = int(re.search(r'\.bpp\s*=\s*(\d+)', m.group(1)).group(1))
+
+    data = table + struct.pack('<%dH' % len(unicode), *unicode)
+    data += bytes(-len(data) % 4)
+    offset = len(data)
+    return {
+        'type': TYPE_FONT, 'format': bpp, 'width': count, 'height': height,
+        'data': data + bitmap, 'bitmap': offset, 'unicode_len': len(unicode),
+    }
+
+
+def parse_image(kind, args):
+    if len(args) != 3:
+        sys.exit('%s needs WIDTHxHEIGHT,FORMAT,FILE' % kind)
+
+    width, height = (int(v) for v in args[0].lower().split('x'))
+    if width >= 4096 or height >= 4096:
+        sys.exit('%s is larger than 4095 pixels' % kind)
+
+    path, _, symbol = args[2].partition('#')
+    if symbol:
+        data = parse_c_bytes(path, symbol)
+    else:
+        with open(path, 'rb') as f:
+            data = f.read()
+
+    return {
+        'type': TYPE_PIXMAP if kind == 'pixmap' else TYPE_ICON, 'format': int(args[1], 0),
+        'width': width, 'height': height, 'data': data, 'bitmap': 0, 'unicode_len': 0,
+    }
+
+
+def parse_asset(spec):
+    kind, _, rest = spec.partition(':')
+    args = rest.split(',')
+    name = args.pop(0)
+
+    if len(name.encode()) >= NAME_MAX or not name:
+        sys.exit('%s: name must be 1 to %d bytes' % (spec, NAME_MAX - 1))
+
+    if kind == 'font':
+        if len(args) != 1:
+            sys.exit('font needs FILE')
+        asset = parse_font(args[0])
+    elif kind in ('pixmap', 'icon'):
+        asset = parse_image(kind, args)
+    else:
+        sys.exit('%s: unknown asset type %s' % (spec, kind))
+
+    asset['name'] = name
+    return asset
+
+
+def build(assets):
+    offset = HEADER.size + ENTRY.size * len(assets)
+    index = b''
+    data = b''
+
+    for a in assets:
+        pos = offset + len(data)
+        index += ENTRY.pack(a['name'].encode(), a['type'], a['format'], 0, a['width'], a['height'],
+                            pos, len(a['data']), a['bitmap'], a['unicode_len'])
+        data += a['data'] + bytes(-len(a['data']) % 4)
+
+    return HEADER.pack(MAGIC, VERSION, len(assets), offset + len(data), 0) + index + data
+
+
+def main():
+    parser = argparse.ArgumentParser(description='make sgl asset pack')
+    parser.add_argument('-o', '--output', required=True, help='output pack file')
+    parser.add_argument('assets', nargs='+', help='font:NAME,FILE | icon:NAME,WxH,BPP,FILE | pixmap:NAME,WxH,FORMAT,FILE')
+    args = parser.parse_args()
+
+    assets = [parse_asset(spec) for spec in args.assets]
+    names = [(a['type'], a['name']) for a in assets]
+    if len(set(names)) != len(names):
+        sys.exit('asset names are not unique')
+    if len(assets) > 0xFFFF:
+        sys.exit('too many assets')
+
+    pack = build(assets)
+    with open(args.output, 'wb') as f:
+        f.write(pack)
+
+    for a in assets:
+        print('%-8s %-24s %5d bytes' % (('pixmap', 'icon', 'font')[a['type'] - 1], a['name'], len(a['data'])))
+    print('%d assets, %d bytes' % (len(assets), len(pack)))
+
+
+if __name__ == '__main__':
+    main()
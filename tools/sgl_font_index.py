@@ -0,0 +1,137 @@
+#!/usr/bin/env python3
+# tools/sgl_font_index.py
+#
+# MIT License
+#
+# Copyright(c) 2023-present All contributors of SGL
+# Document reference link: docs directory
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Generate the unicode index of a sgl font from its unicode_list_1, so that
+# sgl_search_unicode_ch_index() finds a glyph in constant time.
+#
+#   python3 tools/sgl_font_index.py source/fonts/sgl_ascii_kai33.c
+#
+# The longest run of contiguous unicodes is looked up by subtraction, the other
+# unicodes are looked up by a page table of the high byte and a 256 bits map of
+# every page. Paste the output before the sgl_font_t of the font and add
+# `.unicode_index = &unicode_index_1,` into it.
+
+import re
+import sys
+
+
+def parse_unicode_list(path):
+    with open(path, encoding='utf-8', errors='replace') as f:
+        text = f.read()
+
+    m = re.search(r'unicode_list_1\s*\[\s*\]\s*=\s*\{(.*?)\};', text, re.S)
+    if m is None:
+        sys.exit('%s: unicode_list_1 is not found' % path)
+
+    body = re.sub(r'/\*.*?\*/', '', m.group(1), flags=re.S)
+    codes = [int(v, 0) for v in re.findall(r'0x[0-9a-fA-F]+|\d+', body)]
+
+    # the end indicator 0x0000 is not a glyph
+    while len(codes) > 1 and codes[-1] == 0:
+        codes.pop()
+
+    for i in range(1, len(codes)):
+        if codes[i] <= codes[i - 1]:
+            sys.exit('%s: unicode_list_1 is not sorted at index %d' % (path, i))
+    if codes and codes[-1] > 0xFFFF:
+        sys.exit('%s: unicode larger than 0xFFFF is not supported' % path)
+
+    return codes
+
+
+def longest_range(codes):
+    best_start, best_len = 0, 0
+    start = 0
+    for i in range(1, len(codes) + 1):
+        if i == len(codes) or codes[i] != codes[i - 1] + 1:
+            if i - start > best_len:
+                best_start, best_len = start, i - start
+            start = i
+    return best_start, best_len
+
+
+def generate(codes):
+    out = []
+    range_index, range_len = longest_range(codes)
+    range_start = codes[range_index] if range_len else 0
+    rest = [(i, c) for i, c in enumerate(codes) if not (range_index <= i < range_index + range_len)]
+
+    pages = {}
+    for index, code in rest:
+        pages.setdefault(code >> 8, []).append((index, code))
+
+    if len(pages) > 255:
+        sys.exit('too many pages: %d' % len(pages))
+
+    out.append('#if (CONFIG_SGL_TEXT_UTF8)')
+    if pages:
+        page_ids = sorted(pages)
+        page_map = [0xFF] * 256
+        for n, page in enumerate(page_ids):
+            page_map[page] = n
+
+        out.append('static const uint8_t unicode_page_map_1[256] = {')
+        for row in range(0, 256, 16):
+            out.append('    ' + ' '.join('0x%02x,' % v for v in page_map[row:row + 16]))
+        out.append('};')
+        out.append('')
+        out.append('static const sgl_font_unicode_page_t unicode_pages_1[] = {')
+        for page in page_ids:
+            bits = [0] * 8
+            base = [0] * 8
+            entries = pages[page]
+            for word in range(8):
+                # index of the first unicode at or after this word
+                following = [i for i, c in entries if (c & 0xFF) >> 5 >= word]
+                base[word] = following[0] if following else 0
+            for index, code in entries:
+                bits[(code & 0xFF) >> 5] |= 1 << (code & 31)
+            out.append('    {   /* 0x%02xxx */' % page)
+            out.append('        .bits = { ' + ', '.join('0x%08x' % v for v in bits) + ' },')
+            out.append('        .base = { ' + ', '.join('%d' % v for v in base) + ' },')
+            out.append('    },')
+        out.append('};')
+        out.append('')
+
+    out.append('static const sgl_font_unicode_index_t unicode_index_1 = {')
+    out.append('    .range_start = 0x%04x,' % range_start)
+    out.append('    .range_len = %d,' % range_len)
+    out.append('    .range_index = %d,' % range_index)
+    out.append('    .page_map = %s,' % ('unicode_page_map_1' if pages else 'NULL'))
+    out.append('    .pages = %s,' % ('unicode_pages_1' if pages else 'NULL'))
+    out.append('};')
+    out.append('#endif // !CONFIG_SGL_TEXT_UTF8')
+
+    return '\n'.join(out)
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit('usage: %s <font.c>' % sys.argv[0])
+
+    print(generate(parse_unicode_list(sys.argv[1])))
+
+
+if __name__ == '__main__':
+    main()
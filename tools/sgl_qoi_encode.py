@@ -0,0 +1,237 @@
+#!/usr/bin/env python3
+# tools/sgl_qoi_encode.py
+#
+# MIT License
+#
+# Copyright(c) 2023-present All contributors of SGL
+# Document reference link: docs directory
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Compress a picture into a pixmap of SGL_PIXMAP_FORMAT_QOI, it is drawn when
+# CONFIG_SGL_PIXMAP_QOI is enabled.
+#
+#   python3 tools/sgl_qoi_encode.py logo.png -o logo.c
+#   python3 tools/sgl_qoi_encode.py logo.rgba --size 120x80 -o logo.bin
+#
+# The input is a 8 bits PNG or raw RGBA pixels. A C file has the bytes and a
+# sgl_pixmap_t that is named as the file, a binary file can be put into an asset
+# pack with `pixmap:logo,120x80,1,logo.bin`.
+#
+# The ops are the ops of QOI (https://qoiformat.org), but the codec state is
+# reset at every (1 << shift) rows and the offsets of these chunks are kept in
+# the header, so that a draw slice decodes from the chunk of its first row. The
+# header is described in source/include/sgl_draw.h.
+
+import argparse
+import os
+import re
+import struct
+import sys
+import zlib
+
+MAGIC = 0x696F7173
+
+OP_INDEX = 0x00
+OP_DIFF = 0x40
+OP_LUMA = 0x80
+OP_RUN = 0xc0
+OP_RGB = 0xfe
+OP_RGBA = 0xff
+
+
+def read_png(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    if data[:8] != b'\x89PNG\r\n\x1a\n':
+        sys.exit('%s: not a PNG file' % path)
+
+    pos, idat, palette, trns = 8, b'', None, None
+    while pos < len(data):
+        length, kind = struct.unpack('>I4s', data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b'IHDR':
+            width, height, depth, ctype, _, _, interlace = struct.unpack('>IIBBBBB', body)
+        elif kind == b'PLTE':
+            palette = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b'tRNS':
+            trns = body
+        elif kind == b'IDAT':
+            idat += body
+        elif kind == b'IEND':
+            break
+
+    if depth != 8 or interlace != 0 or ctype not in (0, 2, 3, 4, 6):
+        sys.exit('%s: only 8 bits and not interlaced PNG is supported' % path)
+
+    channels = {0: 1, 2: 3, 3: 1, 4: 2, 6: 4}[ctype]
+    stride = width * channels
+    raw = zlib.decompress(idat)
+    rows, prev = [], bytearray(stride)
+
+    for y in range(height):
+        line = raw[y * (stride + 1):(y + 1) * (stride + 1)]
+        ftype, cur = line[0], bytearray(line[1:])
+        for i in range(stride):
+            a = cur[i - channels] if i >= channels else 0
+            b = prev[i]
+            c = prev[i - channels] if i >= channels else 0
+            if ftype == 1:
+                cur[i] = (cur[i] + a) & 0xff
+            elif ftype == 2:
+                cur[i] = (cur[i] + b) & 0xff
+            elif ftype == 3:
+                cur[i] = (cur[i] + ((a + b) >> 1)) & 0xff
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                cur[i] = (cur[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xff
+        rows.append(cur)
+        prev = cur
+
+    pixels = []
+    for cur in rows:
+        for x in range(width):
+            v = cur[x * channels:(x + 1) * channels]
+            if ctype == 0:
+                pixels.append((v[0], v[0], v[0], 255))
+            elif ctype == 2:
+                pixels.append((v[0], v[1], v[2], 255))
+            elif ctype == 3:
+                r, g, b = palette[v[0]]
+                pixels.append((r, g, b, trns[v[0]] if trns and v[0] < len(trns) else 255))
+            elif ctype == 4:
+                pixels.append((v[0], v[0], v[0], v[1]))
+            else:
+                pixels.append(tuple(v))
+
+    return width, height, pixels
+
+
+def read_raw(path, size):
+    width, height = (int(v) for v in size.lower().split('x'))
+    with open(path, 'rb') as f:
+        data = f.read()
+    if len(data) != width * height * 4:
+        sys.exit('%s: %d bytes is not %dx%d RGBA' % (path, len(data), width, height))
+    return width, height, [tuple(data[i:i + 4]) for i in range(0, len(data), 4)]
+
+
+def encode_chunk(pixels, out):
+    index = [(0, 0, 0, 0)] * 64
+    prev = (0, 0, 0, 255)
+    run = 0
+
+    for px in pixels:
+        if px == prev:
+            run += 1
+            if run == 62:
+                out.append(OP_RUN | (run - 1))
+                run = 0
+            continue
+
+        if run:
+            out.append(OP_RUN | (run - 1))
+            run = 0
+
+        r, g, b, a = px
+        h = (r * 3 + g * 5 + b * 7 + a * 11) & 63
+        if index[h] == px:
+            out.append(OP_INDEX | h)
+        else:
+            index[h] = px
+            if a == prev[3]:
+                vr = ((r - prev[0] + 128) & 0xff) - 128
+                vg = ((g - prev[1] + 128) & 0xff) - 128
+                vb = ((b - prev[2] + 128) & 0xff) - 128
+                vg_r, vg_b = vr - vg, vb - vg
+                if -2 <= vr <= 1 and -2 <= vg <= 1 and -2 <= vb <= 1:
+                    out.append(OP_DIFF | ((vr + 2) << 4) | ((vg + 2) << 2) | (vb + 2))
+                elif -32 <= vg <= 31 and -8 <= vg_r <= 7 and -8 <= vg_b <= 7:
+                    out.append(OP_LUMA | (vg + 32))
+                    out.append(((vg_r + 8) << 4) | (vg_b + 8))
+                else:
+                    out += bytes((OP_RGB, r, g, b))
+            else:
+                out += bytes((OP_RGBA, r, g, b, a))
+        prev = px
+
+    if run:
+        out.append(OP_RUN | (run - 1))
+
+
+def encode(width, height, pixels, shift):
+    rows = 1 << shift
+    chunks = (height + rows - 1) // rows
+    base = 12 + 4 * chunks
+    body = bytearray()
+    offsets = []
+
+    for c in range(chunks):
+        offsets.append(base + len(body))
+        encode_chunk(pixels[c * rows * width:(c + 1) * rows * width], body)
+
+    header = struct.pack('<IHHB3x', MAGIC, width, height, shift) + struct.pack('<%dI' % chunks, *offsets)
+    return header + bytes(body)
+
+
+def write_c(path, data, width, height):
+    name = re.sub(r'\W', '_', os.path.splitext(os.path.basename(path))[0])
+    out = ['#include <sgl.h>', '', '', 'static const uint8_t %s_qoi[] = {' % name]
+    for i in range(0, len(data), 16):
+        out.append('    ' + ' '.join('0x%02x,' % v for v in data[i:i + 16]))
+    out += ['};', '', '',
+            'const sgl_pixmap_t %s = {' % name,
+            '    .bitmap = %s_qoi,' % name,
+            '    .width = %d,' % width,
+            '    .height = %d,' % height,
+            '    .format = SGL_PIXMAP_FORMAT_QOI,',
+            '};', '']
+    with open(path, 'w') as f:
+        f.write('\n'.join(out))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='compress a picture into sgl QOI pixmap')
+    parser.add_argument('input', help='8 bits PNG, or raw RGBA with --size')
+    parser.add_argument('-o', '--output', required=True, help='output .c or binary file')
+    parser.add_argument('--size', help='WIDTHxHEIGHT of raw RGBA input')
+    parser.add_argument('--shift', type=int, default=4, help='rows of a chunk are (1 << shift), default 4')
+    args = parser.parse_args()
+
+    if args.size:
+        width, height, pixels = read_raw(args.input, args.size)
+    else:
+        width, height, pixels = read_png(args.input)
+
+    if width >= 4096 or height >= 4096 or not 0 <= args.shift <= 12:
+        sys.exit('pixmap is larger than 4095 pixels or shift is out of 0 to 12')
+
+    data = encode(width, height, pixels, args.shift)
+    if args.output.endswith('.c'):
+        write_c(args.output, data, width, height)
+    else:
+        with open(args.output, 'wb') as f:
+            f.write(data)
+
+    print('%dx%d, %d bytes, %.1f%% of RGBA' % (width, height, len(data), len(data) * 100.0 / (width * height * 4)))
+
+
+if __name__ == '__main__':
+    main()
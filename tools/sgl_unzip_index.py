@@ -0,0 +1,103 @@
+#!/usr/bin/env python3
+# tools/sgl_unzip_index.py
+#
+# MIT License
+#
+# Copyright(c) 2023-present All contributors of SGL
+# Document reference link: docs directory
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to deal
+# in the Software without restriction, including without limitation the rights
+# to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+# copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+# The above copyright notice and this permission notice shall be included in all
+# copies or substantial portions of the Software.
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+# OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+# SOFTWARE.
+#
+# Generate the row marks of a compressed image of unzip_image widget from its
+# uint8_t array, so that every draw slice starts decoding from the nearest mark
+# instead of the first row.
+#
+#   python3 tools/sgl_unzip_index.py image.c image_map 240 320 [shift]
+#
+# A mark is the decoder state at the start of row (i << shift), shift is 3 by
+# default. Paste the output after the array and add
+# `.mark = image_map_mark, .mark_shift = <shift>,` into its sgl_unzip_img_pixmap_t.
+# Without it, the widget builds SGL_UNZIP_IMG_MARK_NUM marks in DRAW_INIT.
+
+import re
+import sys
+
+
+def parse_map(path, symbol):
+    with open(path, encoding='utf-8', errors='replace') as f:
+        text = f.read()
+
+    m = re.search(r'uint8_t\s+' + re.escape(symbol) + r'\s*\[\s*\w*\s*\]\s*=\s*\{(.*?)\};', text, re.S)
+    if m is None:
+        sys.exit('%s: %s is not found' % (path, symbol))
+
+    body = re.sub(r'/\*.*?\*/', '', m.group(1), flags=re.S)
+    body = re.sub(r'//[^\n]*', '', body)
+    return [int(v, 0) & 0xFF for v in re.findall(r'0x[0-9a-fA-F]+|\d+', body)]
+
+
+def marks(data, width, height, shift):
+    # same as sgl_unzip_img_incremental() of sgl_unzip_image.c
+    n, rep_cnt, out, unzip = 0, 0, 0, 0
+    result = []
+
+    for row in range(height):
+        if row % (1 << shift) == 0:
+            result.append((n, rep_cnt, out, unzip))
+
+        left = width
+        while left > 0:
+            while rep_cnt == 0:
+                rep_cnt = 1
+                if data[n] & 0x20:
+                    dat16 = data[n] | (data[n + 1] << 8)
+                    if unzip == dat16:
+                        n += 2
+                        rep_cnt = (data[n] << 8) | data[n + 1]
+                    else:
+                        unzip = dat16
+                        out = dat16
+                    n += 2
+                else:
+                    b = data[n]
+                    out = unzip ^ (((b << 5) & 0x1800) + ((b << 3) & 0x00e3) + (b & 0x03))
+                    n += 1
+            take = min(rep_cnt, left)
+            rep_cnt -= take
+            left -= take
+
+    return result
+
+
+def main():
+    if len(sys.argv) not in (5, 6):
+        sys.exit('usage: %s <image.c> <symbol> <width> <height> [shift]' % sys.argv[0])
+
+    path, symbol = sys.argv[1], sys.argv[2]
+    width, height = int(sys.argv[3]), int(sys.argv[4])
+    shift = int(sys.argv[5]) if len(sys.argv) == 6 else 3
+
+    out = ['static const sgl_unzip_img_mark_t %s_mark[] = {' % symbol]
+    for n, rep_cnt, color, unzip in marks(parse_map(path, symbol), width, height, shift):
+        out.append('    { .n = %d, .rep_cnt = %d, .out = { .full = 0x%04x }, .unzip = { .full = 0x%04x } },'
+                   % (n, rep_cnt, color, unzip))
+    out.append('};')
+    print('\n'.join(out))
+
+
+if __name__ == '__main__':
+    main()